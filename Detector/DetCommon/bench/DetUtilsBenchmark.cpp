@@ -0,0 +1,209 @@
+// FCCSW
+#include "DetCommon/DetUtils.h"
+
+// DD4hep
+#include "DDSegmentation/BitFieldCoder.h"
+
+// std
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/** DetUtilsBenchmark Detector/DetCommon/bench/DetUtilsBenchmark.cpp
+ *
+ *  Standalone benchmark of the neighbour finding functions of det::utils used in the calorimeter clustering:
+ *  neighbours (for 2, 3 and 4 fields, with and without diagonal neighbours and cyclic phi), combinations,
+ *  permutations, cyclicNeighbour and bitfieldExtremes.
+ *  Only the bitfield decoder is used: there is no geometry, no Geant4 run and no Gaudi.
+ *  For each measurement the time per call, the number of found neighbours per second and the number of heap
+ *  allocations per call are reported (best of the repetitions). Allocations are counted by replacing the global
+ *  operator new in this executable.
+ *
+ *  Usage: DetUtilsBenchmark [-n <calls>] [-r <repetitions>] [-s <seed>]
+ *    -n, --calls        Number of calls per measurement (default: 200000)
+ *    -r, --repetitions  Number of repetitions of each measurement, the fastest one is taken (default: 5)
+ *    -s, --seed         Seed of the random number generator (default: 42)
+ */
+
+namespace {
+/// Number of heap allocations made since the start of the program
+std::size_t s_allocations = 0;
+}
+
+void* operator new(std::size_t aSize) {
+  ++s_allocations;
+  if (void* ptr = std::malloc(aSize == 0 ? 1 : aSize)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* aPtr) noexcept { std::free(aPtr); }
+void operator delete(void* aPtr, std::size_t) noexcept { std::free(aPtr); }
+
+namespace {
+/// Definition of one measurement
+struct Measurement {
+  /// Name of the measurement
+  std::string name;
+  /// Call of the measured function for the given index, returns the number of found neighbours (or other items)
+  std::function<std::size_t(std::size_t)> call;
+};
+
+/// Result of one measurement
+struct Result {
+  /// Time per call (in ns)
+  double timePerCall = std::numeric_limits<double>::max();
+  /// Number of returned items per call
+  double itemsPerCall = 0;
+  /// Number of heap allocations per call
+  double allocationsPerCall = 0;
+};
+
+/** Time the calls of the measured function, repeated aRepetitions times.
+ *  @param[in] aMeasurement Measured function.
+ *  @param[in] aCalls Number of calls.
+ *  @param[in] aRepetitions Number of repetitions.
+ *  return Result of the fastest repetition.
+ */
+Result timeLoop(const Measurement& aMeasurement, std::size_t aCalls, unsigned aRepetitions) {
+  Result result;
+  for (unsigned iRep = 0; iRep < aRepetitions; ++iRep) {
+    std::size_t items = 0;
+    std::size_t allocationsBefore = s_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < aCalls; ++i) {
+      items += aMeasurement.call(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double time = std::chrono::duration<double, std::nano>(stop - start).count() / aCalls;
+    if (time < result.timePerCall) {
+      result.timePerCall = time;
+      result.itemsPerCall = static_cast<double>(items) / aCalls;
+      result.allocationsPerCall = static_cast<double>(s_allocations - allocationsBefore) / aCalls;
+    }
+  }
+  return result;
+}
+
+/// Readout for which the neighbours are searched
+struct Readout {
+  /// Name used in the report
+  std::string name;
+  /// Encoding string of the readout
+  std::string encoding;
+  /// Fields in which the neighbours are searched (last one is phi)
+  std::vector<std::string> fields;
+};
+
+void printUsage(const char* aName) {
+  std::cout << "Usage: " << aName << " [-n <calls>] [-r <repetitions>] [-s <seed>]" << std::endl;
+}
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t numCalls = 200000;
+  unsigned numRepetitions = 5;
+  unsigned seed = 42;
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    std::string arg = argv[iArg];
+    bool hasValue = iArg + 1 < argc;
+    if ((arg == "-n" || arg == "--calls") && hasValue) {
+      numCalls = std::stoul(argv[++iArg]);
+    } else if ((arg == "-r" || arg == "--repetitions") && hasValue) {
+      numRepetitions = std::stoul(argv[++iArg]);
+    } else if ((arg == "-s" || arg == "--seed") && hasValue) {
+      seed = std::stoul(argv[++iArg]);
+    } else {
+      printUsage(argv[0]);
+      return arg == "-h" || arg == "--help" ? 0 : 2;
+    }
+  }
+  if (numCalls == 0 || numRepetitions == 0) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  const std::vector<Readout> readouts = {
+      {"2 fields", "system:4,layer:5,eta:-9,phi:10", {"eta", "phi"}},
+      {"3 fields", "system:4,layer:5,eta:-9,phi:10", {"layer", "eta", "phi"}},
+      {"4 fields", "system:4,module:6,layer:5,eta:-9,phi:10", {"module", "layer", "eta", "phi"}}};
+
+  // Decoders and cell IDs need to outlive the measurements
+  std::vector<std::unique_ptr<dd4hep::DDSegmentation::BitFieldCoder>> decoders;
+  std::vector<std::vector<std::pair<int, int>>> extremes;
+  std::vector<std::vector<dd4hep::DDSegmentation::CellID>> cellIDs;
+  std::mt19937_64 generator(seed);
+  for (const auto& readout : readouts) {
+    decoders.emplace_back(new dd4hep::DDSegmentation::BitFieldCoder(readout.encoding));
+    extremes.push_back(det::utils::bitfieldExtremes(*decoders.back(), readout.fields));
+    std::vector<dd4hep::DDSegmentation::CellID> ids(numCalls, 0);
+    for (auto& id : ids) {
+      decoders.back()->set(id, "system", 5);
+      for (unsigned iField = 0; iField < readout.fields.size(); ++iField) {
+        std::uniform_int_distribution<int> value(extremes.back()[iField].first, extremes.back()[iField].second);
+        decoders.back()->set(id, readout.fields[iField], value(generator));
+      }
+    }
+    cellIDs.push_back(std::move(ids));
+  }
+
+  std::vector<Measurement> measurements;
+  for (unsigned iReadout = 0; iReadout < readouts.size(); ++iReadout) {
+    for (bool cyclic : {false, true}) {
+      for (bool diagonal : {false, true}) {
+        std::vector<bool> fieldCyclic(readouts[iReadout].fields.size(), false);
+        fieldCyclic.back() = cyclic;
+        std::string name = "neighbours " + readouts[iReadout].name + (diagonal ? ", diagonal" : "") +
+            (cyclic ? ", cyclic phi" : "");
+        measurements.push_back({name, [&, iReadout, fieldCyclic, diagonal](std::size_t i) {
+                                  return det::utils::neighbours(*decoders[iReadout], readouts[iReadout].fields,
+                                                                extremes[iReadout], cellIDs[iReadout][i], fieldCyclic,
+                                                                diagonal)
+                                      .size();
+                                }});
+      }
+    }
+  }
+  for (int numFields : {2, 3, 4}) {
+    measurements.push_back({"combinations N=" + std::to_string(numFields) + " K=2", [numFields](std::size_t) {
+                              return det::utils::combinations(numFields, 2).size();
+                            }});
+    measurements.push_back({"permutations K=" + std::to_string(numFields),
+                            [numFields](std::size_t) { return det::utils::permutations(numFields).size(); }});
+  }
+  measurements.push_back({"cyclicNeighbour", [](std::size_t i) {
+                            return static_cast<std::size_t>(
+                                det::utils::cyclicNeighbour(static_cast<int>(i % 1026) - 1, {0, 1023}));
+                          }});
+  measurements.push_back({"bitfieldExtremes 4 fields", [&](std::size_t) {
+                            return det::utils::bitfieldExtremes(*decoders.back(), readouts.back().fields).size();
+                          }});
+
+  std::cout << "DetUtils benchmark: " << numCalls << " calls, best of " << numRepetitions << " repetitions"
+            << std::endl;
+  std::cout << std::left << std::setw(44) << "measurement" << std::right << std::setw(12) << "ns/call"
+            << std::setw(14) << "items/call" << std::setw(16) << "neighbours/s" << std::setw(14) << "allocs/call"
+            << std::endl;
+  for (const auto& measurement : measurements) {
+    auto result = timeLoop(measurement, numCalls, numRepetitions);
+    std::stringstream rate;
+    if (measurement.name.compare(0, 10, "neighbours") == 0) {
+      rate << std::scientific << std::setprecision(3) << result.itemsPerCall / result.timePerCall * 1e9;
+    } else {
+      rate << "-";
+    }
+    std::cout << std::left << std::setw(44) << measurement.name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << result.timePerCall << std::setw(14) << result.itemsPerCall << std::setw(16)
+              << rate.str() << std::setw(14) << result.allocationsPerCall << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef DETCOMMON_BITFIELDCOPY_H
+#define DETCOMMON_BITFIELDCOPY_H
+
+// DD4hep
+#include "DDSegmentation/BitFieldCoder.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/** BitFieldCopy Detector/DetCommon/include/DetCommon/BitFieldCopy.h BitFieldCopy.h
+ *
+ *  Copy of the values of a list of fields from a cell ID of one bitfield to a cell ID of another bitfield.
+ *  It does the same as BitFieldCoder::set(newID, name, oldDecoder.get(oldID, name)) for each field, with the
+ *  offsets, masks and ranges of the fields resolved once at construction instead of by name for each cell ID.
+ *  Fields with the same offset, width and sign in both bitfields are copied together with one mask.
+ */
+
+namespace det {
+namespace utils {
+class BitFieldCopy {
+public:
+  BitFieldCopy() = default;
+  /** Constructor.
+   *  Throws std::runtime_error if a field does not exist in one of the bitfields.
+   *  @param[in] aOldDecoder Bitfield of the copied cell IDs.
+   *  @param[in] aNewDecoder Bitfield of the new cell IDs.
+   *  @param[in] aFieldNames Names of the copied fields.
+   */
+  BitFieldCopy(const dd4hep::DDSegmentation::BitFieldCoder& aOldDecoder,
+               const dd4hep::DDSegmentation::BitFieldCoder& aNewDecoder, const std::vector<std::string>& aFieldNames);
+
+  /** Copy the fields.
+   *  Throws std::runtime_error if a value is out of the range of the new field (as BitFieldCoder::set).
+   *  @param[in] aOldID Cell ID in the old bitfield.
+   *  @param[in] aNewID Cell ID in the new bitfield, the copied fields are overwritten.
+   *  return Cell ID in the new bitfield.
+   */
+  inline uint64_t copy(uint64_t aOldID, uint64_t aNewID = 0) const {
+    aNewID = (aNewID & ~m_sameLayoutMask) | (aOldID & m_sameLayoutMask);
+    for (const auto& operation : m_operations) {
+      int64_t value = (aOldID >> operation.oldOffset) & operation.oldMask;
+      if (operation.oldSigned && (value & operation.oldSignBit) != 0) {
+        value -= 2 * operation.oldSignBit;
+      }
+      if (operation.checkRange && (value < operation.newMin || value > operation.newMax)) {
+        throwOutOfRange(operation, value);
+      }
+      uint64_t newBits = (static_cast<uint64_t>(value) << operation.newOffset) & operation.newMask;
+      aNewID = (aNewID & ~operation.newMask) | newBits;
+    }
+    return aNewID;
+  }
+  /// Number of the fields copied one by one (with different layouts in the two bitfields)
+  inline size_t numberOfOperations() const { return m_operations.size(); }
+  /// Mask of the fields copied together (same layout in the two bitfields)
+  inline uint64_t sameLayoutMask() const { return m_sameLayoutMask; }
+
+private:
+  /// Copy of one field
+  struct Operation {
+    /// name of the field
+    std::string name;
+    /// offset, mask (not shifted), highest bit (not shifted) and sign of the old field
+    unsigned oldOffset = 0;
+    uint64_t oldMask = 0;
+    int64_t oldSignBit = 0;
+    bool oldSigned = false;
+    /// offset, mask (shifted) and range of the new field
+    unsigned newOffset = 0;
+    uint64_t newMask = 0;
+    int64_t newMin = 0;
+    int64_t newMax = 0;
+    /// whether the range of the old field exceeds the range of the new field
+    bool checkRange = false;
+  };
+  /// Throw the error for a value out of the range of the new field
+  [[noreturn]] static void throwOutOfRange(const Operation& aOperation, int64_t aValue);
+
+  /// mask of the fields with the same layout in both bitfields
+  uint64_t m_sameLayoutMask = 0;
+  /// copies of the other fields
+  std::vector<Operation> m_operations;
+};
+}
+}
+#endif /* DETCOMMON_BITFIELDCOPY_H */
@@ -0,0 +1,41 @@
+#ifndef DETCOMMON_CELLIDCODEC_H
+#define DETCOMMON_CELLIDCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** Compact encoding of the cell IDs of a hit collection.
+ *
+ *  The cell IDs, sorted in ascending order, are stored as the differences to the previous cell ID, each written as
+ *  a variable-length integer (7 bits per byte, the highest bit set if more bytes follow). Fields that are constant
+ *  within a collection (system, cryostat, type, ...) cancel out in the differences, so neighbouring cells in a
+ *  sorted collection take 1-3 bytes instead of 8.
+ *  Format: number of cell IDs, first cell ID, then the differences, all as variable-length integers.
+ */
+
+namespace det {
+namespace utils {
+/** Encode the cell IDs.
+ *  Throws std::runtime_error if the cell IDs are not sorted in ascending order.
+ *  @param[in] aCellIDs Cell IDs, sorted in ascending order.
+ *  @param[in] aSize Number of cell IDs.
+ *  @param[out] aEncoded Vector to which the encoded cell IDs are appended.
+ */
+void encodeCellIDs(const uint64_t* aCellIDs, size_t aSize, std::vector<uint8_t>& aEncoded);
+/// Same as above, for a vector of cell IDs
+void encodeCellIDs(const std::vector<uint64_t>& aCellIDs, std::vector<uint8_t>& aEncoded);
+
+/** Decode the cell IDs encoded with encodeCellIDs.
+ *  Throws std::runtime_error if the data is truncated or corrupted.
+ *  @param[in] aEncoded Encoded cell IDs.
+ *  @param[in] aSize Size of the encoded data (in bytes).
+ *  @param[out] aCellIDs Vector to which the cell IDs are appended.
+ *  return Number of the bytes read.
+ */
+size_t decodeCellIDs(const uint8_t* aEncoded, size_t aSize, std::vector<uint64_t>& aCellIDs);
+/// Same as above, for a vector of encoded data
+size_t decodeCellIDs(const std::vector<uint8_t>& aEncoded, std::vector<uint64_t>& aCellIDs);
+}
+}
+#endif /* DETCOMMON_CELLIDCODEC_H */
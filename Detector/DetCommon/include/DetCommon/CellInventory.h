@@ -0,0 +1,102 @@
+#ifndef DETCOMMON_CELLINVENTORY_H
+#define DETCOMMON_CELLINVENTORY_H
+
+// DD4hep
+#include "DD4hep/Detector.h"
+#include "DDSegmentation/BitFieldCoder.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** CellInventory Detector/DetCommon/include/DetCommon/CellInventory.h CellInventory.h
+ *
+ *  Inventory of all the cells of a readout: for each sensitive volume the volume ID, the number of cells and the
+ *  range of the values of each segmentation field. The cell IDs of a volume are all the combinations of the field
+ *  values in the ranges.
+ *
+ *  The inventory is built from one traversal of the geometry of the readout (VolumeGeometryCache::sensitiveVolumes),
+ *  the geometry and cell ranges of the volumes are calculated in parallel threads. The ranges are those of
+ *  det::utils::numberOfCells, with the same assumptions (no offset of the segmentation, cylindrical volumes for
+ *  the phi-eta and r-phi segmentations). Supported segmentations: CartesianGridXY, CartesianGridXYZ,
+ *  FCCSWGridPhiEta (also with variable eta bins, FCCSWGridPhiEtaVarEta, or the granularity of each layer) and
+ *  PolarGridRPhi.
+ *
+ *  The inventory can be written to and read from a compact binary file (native byte order):
+ *    "FCCCELLS", uint32 version, uint32 length + readout name, uint32 number of fields, for each field
+ *    uint32 length + name, uint64 number of volumes, then for each volume uint64 volume ID, uint64 number of cells
+ *    and int32 (min, max) for each field.
+ */
+
+namespace det {
+namespace utils {
+class CellInventory {
+public:
+  CellInventory() = default;
+  ~CellInventory() = default;
+
+  /** Build the inventory of a readout.
+   *  @param[in] aDetector The detector description.
+   *  @param[in] aReadoutName Name of the readout.
+   *  @param[in] aNumThreads Number of threads, 0 for the number of hardware threads.
+   *  return Inventory, ordered by the volume ID.
+   */
+  static CellInventory build(const dd4hep::Detector& aDetector, const std::string& aReadoutName,
+                             unsigned aNumThreads = 0);
+  /** Write the inventory to a binary file.
+   *  @param[in] aFileName Name of the file.
+   *  return True if the file was written.
+   */
+  bool write(const std::string& aFileName) const;
+  /** Read the inventory from a binary file written by write().
+   *  @param[in] aFileName Name of the file.
+   *  return True if the file was read, the inventory is empty otherwise.
+   */
+  bool read(const std::string& aFileName);
+
+  /// Name of the readout
+  inline const std::string& readoutName() const { return m_readoutName; }
+  /// Names of the segmentation fields for which the ranges are stored
+  inline const std::vector<std::string>& fieldNames() const { return m_fieldNames; }
+  /// Number of volumes
+  inline size_t numberOfVolumes() const { return m_volumeIds.size(); }
+  /// Volume ID of the volume of given index
+  inline uint64_t volumeId(size_t aIndex) const { return m_volumeIds[aIndex]; }
+  /// Number of cells of the volume of given index
+  inline uint64_t numberOfCells(size_t aIndex) const { return m_numCells[aIndex]; }
+  /// Range (min, max) of the field of given index in the volume of given index
+  inline std::pair<int, int> range(size_t aIndex, size_t aField) const {
+    size_t offset = 2 * (aIndex * m_fieldNames.size() + aField);
+    return {m_ranges[offset], m_ranges[offset + 1]};
+  }
+  /// Total number of cells of the readout
+  uint64_t totalNumberOfCells() const;
+  /** Find a volume.
+   *  @param[in] aVolumeId The volume ID.
+   *  return Index of the volume, or numberOfVolumes() if not found.
+   */
+  size_t find(uint64_t aVolumeId) const;
+  /** Get all the cell IDs of a volume.
+   *  @param[in] aIndex Index of the volume.
+   *  @param[in] aDecoder Decoder of the readout.
+   *  @param[out] aCellIDs Vector to which the cell IDs are appended.
+   */
+  void cellIDs(size_t aIndex, const dd4hep::DDSegmentation::BitFieldCoder& aDecoder,
+               std::vector<uint64_t>& aCellIDs) const;
+
+private:
+  /// name of the readout
+  std::string m_readoutName;
+  /// names of the segmentation fields
+  std::vector<std::string> m_fieldNames;
+  /// volume IDs (ordered)
+  std::vector<uint64_t> m_volumeIds;
+  /// number of cells of each volume
+  std::vector<uint64_t> m_numCells;
+  /// min and max of each field for each volume
+  std::vector<int32_t> m_ranges;
+};
+}
+}
+#endif /* DETCOMMON_CELLINVENTORY_H */
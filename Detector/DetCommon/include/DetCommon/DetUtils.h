@@ -2,6 +2,8 @@
 #define DETCOMMON_DETUTILS_H
 
 // FCCSW
+#include "DetCommon/Geant4PreDigiTrackHit.h"
+#include "DetSegmentation/DriftChamberSegments.h"
 #include "DetSegmentation/FCCSWGridPhiEta.h"
 
 // DD4hep
@@ -22,6 +24,14 @@
 
 #include "TGeoManager.h"
 
+namespace det {
+namespace utils {
+struct VolumeGeometry;
+class VolumeGeometryCache;
+class PlacedVolumeIndex;
+}
+}
+
 /** Given a XML element with several daughters with the same name, e.g.
  <detector> <layer name="1" /> <layer name="2"> </detector>
  this method returns the first daughter of type nodeName whose attribute has a given value
@@ -44,6 +54,14 @@ double getAttrValueWithFallback(const dd4hep::xml::Component& node, const std::s
 
 uint64_t cellID(const dd4hep::Segmentation& aSeg, const G4Step& aStep, bool aPreStepPoint = true);
 
+/** Fill the track segments of the drift chamber from the Geant4 hits, as input of the batched DCA calculation
+ *  (GridDriftChamber::distancesTrackWire). Positions are converted from the Geant4 units (mm) to the DD4hep ones.
+ *  @param[in] aHits Collection of the hits (cell ID, pre- and post-step positions).
+ *  @param[out] aSegments Track segments, cleared before filling.
+ */
+void driftChamberSegments(const k4::Geant4PreDigiTrackHitsCollection& aHits,
+                          dd4hep::DDSegmentation::DriftChamberSegments& aSegments);
+
 /** Get number of possible combinations of bit fields for determination of neighbours.
  *   @param[in] aN number of field names.
  *   @param[in] aK length of bit fields included for index search.
@@ -114,12 +132,26 @@ CLHEP::Hep3Vector coneDimensions(uint64_t aVolumeId);
  */
 std::array<double, 2> tubeEtaExtremes(uint64_t aVolumeId);
 
+/** Get the extrema in pseudorapidity of a tube or cone volume of given dimensions.
+ *   @param[in] aDimensions Dimensions of the tube or cone (rmin, rmax, z(half-length)).
+ *   @param[in] aTransformation World transformation of the volume (its detector element).
+ *   return Pseudorapidity extrema (eta_min, eta_max), (0, 0) for null dimensions.
+ */
+std::array<double, 2> tubeEtaExtremes(const CLHEP::Hep3Vector& aDimensions, const TGeoHMatrix& aTransformation);
+
 /** Get the extrema in pseudorapidity of an envelope.
  *   @param[in] aVolumeId The volume ID.
  *   return Pseudorapidity extrema (eta_min, eta_max).
  */
 std::array<double, 2> envelopeEtaExtremes(uint64_t aVolumeId);
 
+/** Get the extrema in pseudorapidity of an envelope of given dimensions.
+ *   @param[in] aHalfSizes Half-widths of the envelope (x,y,z).
+ *   @param[in] aTransformation World transformation of the volume (its detector element).
+ *   return Pseudorapidity extrema (eta_min, eta_max).
+ */
+std::array<double, 2> envelopeEtaExtremes(const CLHEP::Hep3Vector& aHalfSizes, const TGeoHMatrix& aTransformation);
+
 /** Get the extrema in pseudorapidity of a volume. First try to match tube or cone, if it fails use an envelope shape.
  *   @param[in] aVolumeId The volume ID.
  *   return Pseudorapidity extrema (eta_min, eta_max).
@@ -134,6 +166,11 @@ std::array<double, 2> volumeEtaExtremes(uint64_t aVolumeId);
  *   return Array of the number of cells in (X, Y).
  */
 std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXY& aSeg);
+/// Same as above, with the dimensions of the volume taken from (and stored in) the cache
+std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXY& aSeg,
+                                  VolumeGeometryCache& aCache);
+/// Same as above, for a volume of known geometry
+std::array<uint, 2> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::CartesianGridXY& aSeg);
 
 /** Get the number of cells for the volume and a given Cartesian XYZ segmentation.
  *   For an example see: Test/TestReconstruction/tests/options/testcellcountingXYZ.py.
@@ -143,17 +180,32 @@ std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentati
  *   return Array of the number of cells in (X, Y, Z).
  */
 std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg);
+/// Same as above, with the dimensions of the volume taken from (and stored in) the cache
+std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg,
+                                  VolumeGeometryCache& aCache);
+/// Same as above, for a volume of known geometry
+std::array<uint, 3> numberOfCells(const VolumeGeometry& aGeometry,
+                                  const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg);
 
 /** Get the number of cells for the volume and a given Phi-Eta segmentation.
  *   It is assumed that the volume has a cylindrical shape (and full azimuthal coverage)
  *   and that it is centred at (0,0,0).
  *   For an example see: Test/TestReconstruction/tests/options/testcellcountingPhiEta.py.
+ *   If the granularity depends on the layer, that of the layer of the volume is used.
  *   @warning No offset in segmentation is currently taken into account.
  *   @param[in] aVolumeId The volume for which the cells are counted.
  *   @param[in] aSeg Handle to the segmentation of the volume.
  *   return Array of the number of cells in (phi, eta) and the minimum eta ID.
  */
 std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg);
+/// Same as above, with the dimensions of the volume taken from (and stored in) the cache
+std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg,
+                                  VolumeGeometryCache& aCache);
+/// Same as above, for a volume of known geometry (with the granularity independent of the layer)
+std::array<uint, 3> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg);
+/// Same as above, for a volume of known geometry and ID (with the granularity of the layer of the volume)
+std::array<uint, 3> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg,
+                                  uint64_t aVolumeId);
 
 /** Get the number of cells for the volume and a given R-phi segmentation.
  *   It is assumed that the volume has a cylindrical shape - TGeoTube (and full azimuthal coverage)
@@ -165,6 +217,11 @@ std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentati
  *   return Array of the number of cells in (r, phi).
  */
 std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::PolarGridRPhi& aSeg);
+/// Same as above, with the dimensions of the volume taken from (and stored in) the cache
+std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::PolarGridRPhi& aSeg,
+                                  VolumeGeometryCache& aCache);
+/// Same as above, for a volume of known geometry
+std::array<uint, 2> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::PolarGridRPhi& aSeg);
 
 /** Get the number of the volumes containing a given name.
  *   For an example see: Test/TestReconstruction/tests/options/testcellcountingXYZ.py.
@@ -173,6 +230,8 @@ std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentati
  *   return Number of the volumes.
  */
 unsigned int countPlacedVolumes(TGeoVolume* aHighestVolume, const std::string& aMatchName);
+/// Same as above, with the index of the placed volumes built once for repeated queries
+unsigned int countPlacedVolumes(const PlacedVolumeIndex& aIndex, const std::string& aMatchName);
 }
 }
 #endif /* DETCOMMON_DETUTILS_H */
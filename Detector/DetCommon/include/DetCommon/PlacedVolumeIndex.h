@@ -0,0 +1,91 @@
+#ifndef DETCOMMON_PLACEDVOLUMEINDEX_H
+#define DETCOMMON_PLACEDVOLUMEINDEX_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class TGeoNode;
+class TGeoVolume;
+
+/** PlacedVolumeIndex Detector/DetCommon/include/DetCommon/PlacedVolumeIndex.h PlacedVolumeIndex.h
+ *
+ *  Index of the placed volumes (nodes) below a top volume, by the name of the node: for each name the number of
+ *  placed volumes in the geometry tree (as counted by TGeoIterator) and the nodes with that name.
+ *  The index is built in one traversal of the logical geometry (each volume is visited once, not once per placement):
+ *  the number of placements of a node is the number of placements of its mother volume.
+ *  Queries for an exact name are O(1), for a prefix O(log(number of names)), for a part of the name
+ *  O(number of names) at the first query of a given string and O(1) for the repeated ones.
+ *  The index is not thread-safe (the counts of the parts of names are memoised), each user owns its own index.
+ */
+
+namespace det {
+namespace utils {
+class PlacedVolumeIndex {
+public:
+  /** Build the index.
+   *  @param[in] aHighestVolume The top volume, not counted itself.
+   */
+  explicit PlacedVolumeIndex(TGeoVolume* aHighestVolume);
+  ~PlacedVolumeIndex() = default;
+
+  /** Get the number of the placed volumes of a given name.
+   *  @param[in] aName Name of the node.
+   *  return Number of the volumes.
+   */
+  uint64_t count(const std::string& aName) const;
+  /** Get the number of the placed volumes with names starting with a given string.
+   *  @param[in] aPrefix Beginning of the name of the node.
+   *  return Number of the volumes.
+   */
+  uint64_t countWithPrefix(const std::string& aPrefix) const;
+  /** Get the number of the placed volumes containing a given name, as det::utils::countPlacedVolumes.
+   *  @param[in] aMatchName Name (or its part) of the node.
+   *  return Number of the volumes.
+   */
+  uint64_t countContaining(const std::string& aMatchName) const;
+  /** Get the nodes of a given name (each node may be placed several times in the geometry tree).
+   *  @param[in] aName Name of the node.
+   *  return Nodes, empty if there is no node of that name.
+   */
+  const std::vector<const TGeoNode*>& placements(const std::string& aName) const;
+  /** Get the names of the nodes starting with a given string.
+   *  @param[in] aPrefix Beginning of the name of the node.
+   *  return Names, ordered.
+   */
+  std::vector<std::string> namesWithPrefix(const std::string& aPrefix) const;
+  /// Top volume of the index
+  inline TGeoVolume* topVolume() const { return m_topVolume; }
+  /// Number of the different names of the nodes
+  inline size_t numberOfNames() const { return m_entries.size(); }
+  /// Number of all the placed volumes below the top volume
+  inline uint64_t numberOfPlacedVolumes() const { return m_cumulativeCounts.back(); }
+
+private:
+  /// Placed volumes of one name
+  struct Entry {
+    std::string name;
+    /// number of the placed volumes in the geometry tree
+    uint64_t count = 0;
+    /// nodes of that name
+    std::vector<const TGeoNode*> nodes;
+  };
+  /// Range [first, last) of the entries with names starting with the prefix
+  std::pair<size_t, size_t> prefixRange(const std::string& aPrefix) const;
+
+  /// top volume
+  TGeoVolume* m_topVolume;
+  /// entries, ordered by the name
+  std::vector<Entry> m_entries;
+  /// sum of the counts of the entries before the given index (size: number of entries + 1)
+  std::vector<uint64_t> m_cumulativeCounts;
+  /// index of the entry of each name
+  std::unordered_map<std::string, size_t> m_entryIndex;
+  /// memoised counts of countContaining
+  mutable std::unordered_map<std::string, uint64_t> m_containingCounts;
+};
+}
+}
+#endif /* DETCOMMON_PLACEDVOLUMEINDEX_H */
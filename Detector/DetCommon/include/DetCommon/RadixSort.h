@@ -0,0 +1,18 @@
+#ifndef DETCOMMON_RADIXSORT_H
+#define DETCOMMON_RADIXSORT_H
+
+#include <cstdint>
+#include <vector>
+
+namespace det {
+namespace utils {
+/** Get the order of the keys (e.g. cell IDs) sorted in ascending order, with a stable least-significant-digit
+ *  radix sort on 8-bit digits. Digits that are the same in all the keys (fields constant within a collection, such
+ *  as system or cryostat) are skipped, so the cost is one pass over the keys per varying byte.
+ *  @param[in] aKeys Keys to sort (at most 2^32 - 1).
+ *  @param[out] aOrder Indices of the keys, in the order of the sorted keys (equal keys keep their order).
+ */
+void radixSortOrder(const std::vector<uint64_t>& aKeys, std::vector<uint32_t>& aOrder);
+}
+}
+#endif /* DETCOMMON_RADIXSORT_H */
@@ -0,0 +1,160 @@
+#ifndef DETCOMMON_SHOWERLIBRARY_H
+#define DETCOMMON_SHOWERLIBRARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** ShowerLibrary Detector/DetCommon/include/DetCommon/ShowerLibrary.h ShowerLibrary.h
+ *
+ *  Library of frozen showers: energy deposits of pre-simulated showers, binned in the energy and the
+ *  pseudorapidity of the incoming particle, replayed by the fast simulation (det::ShowerLibraryModel).
+ *  Each deposit (spot) is stored in the frame of the shower: the origin is the entry point of the particle into the
+ *  calorimeter envelope, the longitudinal axis is the direction of the particle, the first transverse axis is
+ *  perpendicular to the direction and to the z axis (along phi for a particle from the beam axis), the second one
+ *  completes the right-handed frame. The energy of a spot is a fraction of the energy of the particle.
+ *
+ *  The library is written by ShowerLibraryBuilder to a binary file (native byte order):
+ *    "FCCSHLIB", uint32 version, uint32 number of energy bins, uint32 number of eta bins, uint32 (unused),
+ *    double energies (GeV), double eta edges (number of eta bins + 1),
+ *    uint64 index of the first shower of each (energy, eta) bin (energy-major, + 1 for the end),
+ *    uint64 index of the first spot of each shower (+ 1 for the end), then the spots (4 floats each).
+ *  The file is memory-mapped read-only by ShowerLibrary (shared by all the threads, the pages are loaded on demand
+ *  and shared between the processes).
+ */
+
+namespace det {
+namespace utils {
+/// Energy deposit of a shower, in the frame of the shower (mm)
+struct ShowerSpot {
+  float longitudinal;
+  float transverseU;
+  float transverseV;
+  float energyFraction;
+};
+
+/// Axes of the frame of a shower for the direction of the incoming particle
+struct ShowerFrame {
+  /** Constructor.
+   *  @param[in] aDirX, aDirY, aDirZ Direction of the particle (not necessarily normalised).
+   */
+  ShowerFrame(double aDirX, double aDirY, double aDirZ);
+  /// first transverse axis (perpendicular to the direction and to the z axis, x axis for a particle along z)
+  double u[3];
+  /// second transverse axis (direction x u)
+  double v[3];
+  /// longitudinal axis (direction)
+  double w[3];
+};
+
+class ShowerLibrary {
+public:
+  ShowerLibrary() = default;
+  ~ShowerLibrary();
+  ShowerLibrary(const ShowerLibrary&) = delete;
+  ShowerLibrary& operator=(const ShowerLibrary&) = delete;
+
+  /** Map a library file.
+   *  @param[in] aFileName Name of the file written by ShowerLibraryBuilder.
+   *  return True if the file was mapped and is valid, the library is empty otherwise.
+   */
+  bool open(const std::string& aFileName);
+  /// Unmap the file
+  void close();
+
+  /// Number of energy bins
+  inline size_t numberOfEnergyBins() const { return m_numEnergyBins; }
+  /// Energy of the bin (GeV)
+  inline double energy(size_t aBin) const { return m_energies[aBin]; }
+  /// Number of eta bins
+  inline size_t numberOfEtaBins() const { return m_numEtaBins; }
+  /// Lower edge of the eta bin (or upper edge of the last bin for numberOfEtaBins())
+  inline double etaEdge(size_t aBin) const { return m_etaEdges[aBin]; }
+  /** Find the energy bin closest to the energy (in the logarithm of the energy).
+   *  @param[in] aEnergy Energy (GeV).
+   *  return Index of the energy bin.
+   */
+  size_t energyBin(double aEnergy) const;
+  /** Find the eta bin.
+   *  @param[in] aEta Pseudorapidity.
+   *  return Index of the eta bin, or numberOfEtaBins() if outside of the library.
+   */
+  size_t etaBin(double aEta) const;
+  /// Number of the showers in the (energy, eta) bin
+  inline size_t numberOfShowers(size_t aEnergyBin, size_t aEtaBin) const {
+    size_t bin = aEnergyBin * m_numEtaBins + aEtaBin;
+    return m_binOffsets[bin + 1] - m_binOffsets[bin];
+  }
+  /** Get a shower.
+   *  @param[in] aEnergyBin Index of the energy bin.
+   *  @param[in] aEtaBin Index of the eta bin.
+   *  @param[in] aIndex Index of the shower in the bin (smaller than numberOfShowers).
+   *  return Pointer to the first spot and the number of the spots.
+   */
+  std::pair<const ShowerSpot*, size_t> shower(size_t aEnergyBin, size_t aEtaBin, size_t aIndex) const;
+  /// Total number of the showers
+  inline size_t totalNumberOfShowers() const { return m_numShowers; }
+
+private:
+  /// mapped file
+  void* m_data = nullptr;
+  /// size of the mapped file
+  size_t m_size = 0;
+  /// number of the energy bins
+  size_t m_numEnergyBins = 0;
+  /// number of the eta bins
+  size_t m_numEtaBins = 0;
+  /// number of the showers
+  size_t m_numShowers = 0;
+  /// pointers into the mapped file
+  const double* m_energies = nullptr;
+  const double* m_etaEdges = nullptr;
+  const uint64_t* m_binOffsets = nullptr;
+  const uint64_t* m_showerOffsets = nullptr;
+  const ShowerSpot* m_spots = nullptr;
+};
+
+/// Builder of the shower library, collecting the showers in memory
+class ShowerLibraryBuilder {
+public:
+  /** Constructor.
+   *  @param[in] aEnergies Energies of the bins (GeV, increasing).
+   *  @param[in] aEtaEdges Edges of the eta bins (increasing, at least two).
+   */
+  ShowerLibraryBuilder(const std::vector<double>& aEnergies, const std::vector<double>& aEtaEdges);
+  ~ShowerLibraryBuilder() = default;
+  /** Add a shower to a bin.
+   *  @param[in] aEnergyBin Index of the energy bin.
+   *  @param[in] aEtaBin Index of the eta bin.
+   *  @param[in] aSpots Deposits of the shower.
+   */
+  void addShower(size_t aEnergyBin, size_t aEtaBin, std::vector<ShowerSpot>&& aSpots);
+  /// Energy bin closest to the energy (GeV), as ShowerLibrary::energyBin
+  size_t energyBin(double aEnergy) const;
+  /// Eta bin, or the number of eta bins if outside of the library, as ShowerLibrary::etaBin
+  size_t etaBin(double aEta) const;
+  /// Number of the eta bins
+  inline size_t numberOfEtaBins() const { return m_etaEdges.size() - 1; }
+  /// Number of the showers in the (energy, eta) bin
+  inline size_t numberOfShowers(size_t aEnergyBin, size_t aEtaBin) const {
+    return m_showers[aEnergyBin * (m_etaEdges.size() - 1) + aEtaBin].size();
+  }
+  /** Write the library.
+   *  @param[in] aFileName Name of the file.
+   *  return True if the file was written.
+   */
+  bool write(const std::string& aFileName) const;
+
+private:
+  /// energies of the bins
+  std::vector<double> m_energies;
+  /// edges of the eta bins
+  std::vector<double> m_etaEdges;
+  /// showers of each (energy, eta) bin, energy-major
+  std::vector<std::vector<std::vector<ShowerSpot>>> m_showers;
+};
+}
+}
+#endif /* DETCOMMON_SHOWERLIBRARY_H */
@@ -0,0 +1,74 @@
+#ifndef DETCOMMON_STATICBITFIELD_H
+#define DETCOMMON_STATICBITFIELD_H
+
+// DD4hep
+#include "DDSegmentation/BitFieldCoder.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/** StaticBitField Detector/DetCommon/include/DetCommon/StaticBitField.h StaticBitField.h
+ *
+ *  Field of a cell ID with the offset, width and sign known at compile time: the value is read and written with
+ *  constant shifts and masks, without the lookup of the field by name in BitFieldCoder.
+ *  The fields of the readouts of the compact files are generated at build time (DetCommon/ReadoutEncodings.h,
+ *  scripts/generateReadoutEncodings.py), each readout with the static matches() checking that the bitfield loaded
+ *  from the geometry has the generated encoding. The static fields can only be used if it does.
+ */
+
+namespace det {
+namespace utils {
+template <unsigned Offset, unsigned Width, bool Signed>
+struct StaticBitField {
+  static_assert(Width > 0 && Width < 64 && Offset + Width <= 64, "Field does not fit in a 64-bit cell ID");
+  static constexpr unsigned offset = Offset;
+  static constexpr unsigned width = Width;
+  static constexpr bool isSigned = Signed;
+  /// mask of the field in the cell ID
+  static constexpr uint64_t mask = ((uint64_t(1) << Width) - 1) << Offset;
+  /// range of the values
+  static constexpr int64_t minValue = Signed ? -(int64_t(1) << (Width - 1)) : 0;
+  static constexpr int64_t maxValue = Signed ? (int64_t(1) << (Width - 1)) - 1 : (int64_t(1) << Width) - 1;
+
+  /** Get the value of the field, as BitFieldElement::value.
+   *  @param[in] aCellID Cell ID.
+   *  return Value of the field.
+   */
+  static constexpr int64_t value(uint64_t aCellID) {
+    int64_t value = (aCellID & mask) >> Offset;
+    return (Signed && value > maxValue) ? value - (int64_t(1) << Width) : value;
+  }
+  /** Set the value of the field, as BitFieldElement::set without the check of the range (see inRange).
+   *  @param[in] aCellID Cell ID.
+   *  @param[in] aValue Value of the field.
+   *  return Cell ID with the new value of the field.
+   */
+  static constexpr uint64_t set(uint64_t aCellID, int64_t aValue) {
+    return (aCellID & ~mask) | ((static_cast<uint64_t>(aValue) << Offset) & mask);
+  }
+  /** Check if the value fits in the field.
+   *  @param[in] aValue Value of the field.
+   *  return True if the value is within the range of the field.
+   */
+  static constexpr bool inRange(int64_t aValue) { return aValue >= minValue && aValue <= maxValue; }
+};
+
+/// Field of a generated encoding, compared with the fields of BitFieldCoder
+struct StaticFieldDescription {
+  const char* name;
+  unsigned offset;
+  unsigned width;
+  bool isSigned;
+};
+
+/** Check if a bitfield has the fields of a generated encoding (same names, offsets, widths and signs, same order).
+ *  @param[in] aDecoder Bitfield, e.g. of the readout loaded from the geometry.
+ *  @param[in] aFields Fields of the encoding.
+ *  @param[in] aNumFields Number of the fields.
+ *  return True if the fields are the same.
+ */
+bool matchesEncoding(const dd4hep::DDSegmentation::BitFieldCoder& aDecoder, const StaticFieldDescription* aFields,
+                     size_t aNumFields);
+}
+}
+#endif /* DETCOMMON_STATICBITFIELD_H */
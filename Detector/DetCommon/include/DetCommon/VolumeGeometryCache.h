@@ -0,0 +1,123 @@
+#ifndef DETCOMMON_VOLUMEGEOMETRYCACHE_H
+#define DETCOMMON_VOLUMEGEOMETRYCACHE_H
+
+// DD4hep
+#include "DD4hep/Detector.h"
+
+// CLHEP
+#include "CLHEP/Vector/ThreeVector.h"
+
+// ROOT
+#include "TGeoMatrix.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/** VolumeGeometryCache Detector/DetCommon/include/DetCommon/VolumeGeometryCache.h VolumeGeometryCache.h
+ *
+ *  Cache of the geometry of the placed volumes, keyed by the volume ID.
+ *  It stores the results of det::utils::envelopeDimensions, tubeDimensions, coneDimensions, tubeEtaExtremes,
+ *  envelopeEtaExtremes and volumeEtaExtremes, so that the volume manager lookup and the casts of the solid are done
+ *  once per volume instead of once per call (numberOfCells chains several of them).
+ *  Volumes are added on the first access (get) or for all the sensitive volumes of a readout at once (prefill),
+ *  in one traversal of the geometry tree of the detector, without any volume manager lookup.
+ *  The cache is not thread-safe, each user (tool) owns its own cache.
+ */
+
+namespace det {
+namespace utils {
+/// Geometry of a placed volume
+struct VolumeGeometry {
+  /// Type of the solid
+  enum class Shape { Tube, Cone, Other };
+  Shape shape = Shape::Other;
+  /// half-widths of the box envelope, as in envelopeDimensions
+  CLHEP::Hep3Vector envelope;
+  /// (rmin, rmax, dz) if the solid is a tube or a cone, as in tubeDimensions and coneDimensions, (0,0,0) otherwise
+  CLHEP::Hep3Vector tube;
+  CLHEP::Hep3Vector cone;
+  /// world transformation of the detector element containing the volume (nominal)
+  TGeoHMatrix worldTransformation;
+  /// pseudorapidity extremes, as in tubeEtaExtremes, envelopeEtaExtremes and volumeEtaExtremes
+  std::array<double, 2> tubeEtaExtremes = {0, 0};
+  std::array<double, 2> envelopeEtaExtremes = {0, 0};
+  std::array<double, 2> volumeEtaExtremes = {0, 0};
+};
+
+class VolumeGeometryCache {
+public:
+  /// Sensitive volume found in the geometry tree
+  struct SensitiveVolume {
+    /// volume ID
+    uint64_t volumeId;
+    /// solid of the volume
+    dd4hep::Solid solid;
+    /// world transformation of the detector element containing the volume (owned by the detector element)
+    const TGeoHMatrix* elementTransformation;
+  };
+
+  VolumeGeometryCache() = default;
+  ~VolumeGeometryCache() = default;
+
+  /** Get the geometry of a volume, calculated at the first access.
+   *  @param[in] aVolumeId The volume ID.
+   *  return Geometry of the volume (reference valid until clear() is called).
+   */
+  const VolumeGeometry& get(uint64_t aVolumeId);
+  /** Add all the sensitive volumes of a readout, in one traversal of the geometry of the detectors using it.
+   *  @param[in] aDetector The detector description.
+   *  @param[in] aReadoutName Name of the readout.
+   *  return Number of added volumes.
+   */
+  size_t prefill(const dd4hep::Detector& aDetector, const std::string& aReadoutName);
+  /** Add the geometry of a volume calculated elsewhere (e.g. in parallel), if it is not cached yet.
+   *  @param[in] aVolumeId The volume ID.
+   *  @param[in] aGeometry Geometry of the volume.
+   */
+  inline void insert(uint64_t aVolumeId, const VolumeGeometry& aGeometry) { m_volumes.emplace(aVolumeId, aGeometry); }
+  /** Find all the sensitive volumes of a readout, in one traversal of the geometry of the detectors using it.
+   *  The volume IDs are built from the volume IDs of the placements, without any volume manager lookup.
+   *  @param[in] aDetector The detector description.
+   *  @param[in] aReadoutName Name of the readout.
+   *  return Sensitive volumes (in the order of the traversal).
+   */
+  static std::vector<SensitiveVolume> sensitiveVolumes(const dd4hep::Detector& aDetector,
+                                                       const std::string& aReadoutName);
+  /** Calculate the geometry of a volume, looked up in the volume manager (not cached).
+   *  @param[in] aVolumeId The volume ID.
+   *  return Geometry of the volume.
+   */
+  static VolumeGeometry compute(uint64_t aVolumeId);
+  /** Calculate the geometry of a volume from its solid.
+   *  @param[in] aSolid Solid of the volume.
+   *  @param[in] aWorldTransformation World transformation of the detector element containing the volume.
+   *  return Geometry of the volume.
+   */
+  static VolumeGeometry compute(const dd4hep::Solid& aSolid, const TGeoHMatrix& aWorldTransformation);
+  /// Number of cached volumes
+  inline size_t size() const { return m_volumes.size(); }
+  /// Remove all the cached volumes (needed if the geometry changes)
+  inline void clear() { m_volumes.clear(); }
+
+private:
+  /// Find the sensitive volumes of the readout placed in the detector element and its children
+  static void findInElement(const dd4hep::DetElement& aElement, const dd4hep::Readout& aReadout,
+                            std::vector<SensitiveVolume>& aVolumes);
+  /// Find the sensitive volumes of the readout among the placement and its daughters, skipping the placements of
+  /// the child detector elements (found with their own transformation). aElementTransform is the world
+  /// transformation of the detector element.
+  static void findInPlacement(const dd4hep::PlacedVolume& aPlacement, uint64_t aVolumeId,
+                              const TGeoHMatrix& aElementTransform, const dd4hep::Readout& aReadout,
+                              const std::unordered_set<const TGeoNode*>& aChildPlacements,
+                              std::vector<SensitiveVolume>& aVolumes);
+
+  /// geometry of the volumes, indexed by the volume ID
+  std::unordered_map<uint64_t, VolumeGeometry> m_volumes;
+};
+}
+}
+#endif /* DETCOMMON_VOLUMEGEOMETRYCACHE_H */
@@ -0,0 +1,136 @@
+"""Generate the compile-time field accessors (det::utils::StaticBitField) of readouts of the compact files.
+
+For each readout given as (compact file, readout name, struct name) the encoding of its <id> element is parsed as in
+dd4hep::DDSegmentation::BitFieldCoder ("name:width" or "name:offset:width", negative width for signed fields) and a
+struct det::readouts::<struct name> is written with one StaticBitField type per field and the static matches(), to be
+checked at runtime against the bitfield of the readout loaded from the geometry.
+
+Usage: generateReadoutEncodings.py --output ReadoutEncodings.h [--source-dir DIR] --readout FILE READOUT NAME [...]
+"""
+
+import argparse
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+CXX_KEYWORDS = {
+    "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const",
+    "constexpr", "continue", "default", "delete", "do", "double", "else", "enum", "explicit", "export", "extern",
+    "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "not",
+    "nullptr", "operator", "or", "private", "protected", "public", "register", "return", "short", "signed", "sizeof",
+    "static", "struct", "switch", "template", "this", "throw", "true", "try", "typedef", "typename", "union",
+    "unsigned", "using", "virtual", "void", "volatile", "while", "xor"
+}
+
+
+def parse_encoding(encoding):
+    """Fields (name, offset, width, signed) of an encoding string, as BitFieldCoder::init."""
+    fields = []
+    offset = 0
+    for description in encoding.split(","):
+        parts = [part.strip() for part in description.split(":")]
+        if len(parts) == 2:
+            name, width = parts[0], int(parts[1])
+        elif len(parts) == 3:
+            name, offset, width = parts[0], int(parts[1]), int(parts[2])
+        else:
+            raise ValueError("Invalid field description '%s' in '%s'" % (description, encoding))
+        if width == 0 or offset + abs(width) > 64:
+            raise ValueError("Field '%s' does not fit in a 64-bit cell ID in '%s'" % (name, encoding))
+        for other in fields:
+            if offset < other[1] + other[2] and other[1] < offset + abs(width):
+                raise ValueError("Fields '%s' and '%s' overlap in '%s'" % (other[0], name, encoding))
+        fields.append((name, offset, abs(width), width < 0))
+        offset += abs(width)
+    return fields
+
+
+def find_encoding(file_name, readout_name):
+    """Encoding string of the readout of a compact file."""
+    root = ET.parse(file_name).getroot()
+    for readout in root.iter("readouts"):
+        for element in readout.findall("readout"):
+            if element.get("name") == readout_name:
+                return " ".join(element.findtext("id").split())
+    raise ValueError("Readout '%s' not found in %s" % (readout_name, file_name))
+
+
+def identifier(name):
+    """C++ identifier of a field name."""
+    result = re.sub(r"\W", "_", name)
+    if result[0].isdigit() or result in CXX_KEYWORDS:
+        result = "_" + result
+    return result
+
+
+def generate(readouts, source_dir):
+    lines = [
+        "// Generated by Detector/DetCommon/scripts/generateReadoutEncodings.py, do not edit.",
+        "// Needs C++17: the static constexpr members (e.g. fields) are defined here, implicitly inline.",
+        "#ifndef DETCOMMON_READOUTENCODINGS_H",
+        "#define DETCOMMON_READOUTENCODINGS_H",
+        "",
+        "#include \"DetCommon/StaticBitField.h\"",
+        "",
+        "namespace det {",
+        "namespace readouts {",
+    ]
+    names = set()
+    for file_name, readout_name, struct_name in readouts:
+        if struct_name in names:
+            raise ValueError("Struct name '%s' is used twice" % struct_name)
+        names.add(struct_name)
+        encoding = find_encoding(file_name, readout_name)
+        fields = parse_encoding(encoding)
+        relative_name = os.path.relpath(file_name, source_dir) if source_dir else file_name
+        lines += [
+            "/// Readout %s of %s" % (readout_name, relative_name),
+            "struct %s {" % struct_name,
+            "  static constexpr const char* readoutName = \"%s\";" % readout_name,
+            "  static constexpr const char* encoding = \"%s\";" % encoding,
+        ]
+        for name, offset, width, signed in fields:
+            lines.append("  using %s = det::utils::StaticBitField<%d, %d, %s>;" %
+                         (identifier(name), offset, width, "true" if signed else "false"))
+        lines.append("  static constexpr det::utils::StaticFieldDescription fields[] = {")
+        for name, offset, width, signed in fields:
+            lines.append("      {\"%s\", %d, %d, %s}," % (name, offset, width, "true" if signed else "false"))
+        lines += [
+            "  };",
+            "  /// check if the bitfield (e.g. of the readout loaded from the geometry) has this encoding",
+            "  static bool matches(const dd4hep::DDSegmentation::BitFieldCoder& aDecoder) {",
+            "    return det::utils::matchesEncoding(aDecoder, fields, sizeof(fields) / sizeof(fields[0]));",
+            "  }",
+            "};",
+        ]
+    lines += [
+        "}",
+        "}",
+        "#endif /* DETCOMMON_READOUTENCODINGS_H */",
+    ]
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate compile-time field accessors of readout encodings")
+    parser.add_argument("--output", required=True, help="Generated header")
+    parser.add_argument("--source-dir", default="", help="Directory to which the file names in comments are relative")
+    parser.add_argument("--readout", nargs=3, action="append", default=[], metavar=("FILE", "READOUT", "NAME"),
+                        help="Compact file, name of the readout and name of the generated struct")
+    args = parser.parse_args()
+    try:
+        content = generate(args.readout, args.source_dir)
+    except (ValueError, ET.ParseError, IOError) as error:
+        sys.stderr.write("generateReadoutEncodings.py: %s\n" % error)
+        return 1
+    output_dir = os.path.dirname(args.output)
+    if output_dir and not os.path.isdir(output_dir):
+        os.makedirs(output_dir)
+    with open(args.output, "w") as output:
+        output.write(content)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,40 @@
+#include "DetCommon/BitFieldCopy.h"
+
+#include <stdexcept>
+
+namespace det {
+namespace utils {
+BitFieldCopy::BitFieldCopy(const dd4hep::DDSegmentation::BitFieldCoder& aOldDecoder,
+                           const dd4hep::DDSegmentation::BitFieldCoder& aNewDecoder,
+                           const std::vector<std::string>& aFieldNames) {
+  for (const auto& name : aFieldNames) {
+    // operator[] throws for unknown names
+    const auto& oldField = aOldDecoder[name];
+    const auto& newField = aNewDecoder[name];
+    if (oldField.offset() == newField.offset() && oldField.width() == newField.width() &&
+        oldField.isSigned() == newField.isSigned()) {
+      m_sameLayoutMask |= newField.mask();
+      continue;
+    }
+    Operation operation;
+    operation.name = name;
+    operation.oldOffset = oldField.offset();
+    operation.oldMask = oldField.mask() >> oldField.offset();
+    operation.oldSignBit = int64_t(1) << (oldField.width() - 1);
+    operation.oldSigned = oldField.isSigned();
+    operation.newOffset = newField.offset();
+    operation.newMask = newField.mask();
+    operation.newMin = newField.minValue();
+    operation.newMax = newField.maxValue();
+    operation.checkRange = oldField.minValue() < newField.minValue() || oldField.maxValue() > newField.maxValue();
+    m_operations.push_back(operation);
+  }
+}
+
+void BitFieldCopy::throwOutOfRange(const Operation& aOperation, int64_t aValue) {
+  throw std::runtime_error("BitFieldCopy: value " + std::to_string(aValue) + " of field " + aOperation.name +
+                           " is out of the range [" + std::to_string(aOperation.newMin) + ", " +
+                           std::to_string(aOperation.newMax) + "] of the new bitfield.");
+}
+}
+}
@@ -0,0 +1,74 @@
+#include "DetCommon/CellIDCodec.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace det {
+namespace utils {
+namespace {
+/// Append the variable-length encoding of the value (at most 10 bytes)
+inline void writeVarint(uint64_t aValue, std::vector<uint8_t>& aEncoded) {
+  while (aValue >= 0x80) {
+    aEncoded.push_back(static_cast<uint8_t>(aValue) | 0x80);
+    aValue >>= 7;
+  }
+  aEncoded.push_back(static_cast<uint8_t>(aValue));
+}
+
+/// Read a variable-length integer at aPosition, moving aPosition after it
+inline uint64_t readVarint(const uint8_t* aEncoded, size_t aSize, size_t& aPosition) {
+  uint64_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (aPosition >= aSize) {
+      throw std::runtime_error("Encoded cell IDs are truncated.");
+    }
+    uint8_t byte = aEncoded[aPosition++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Encoded cell IDs are corrupted (variable-length integer longer than 64 bits).");
+}
+}
+
+void encodeCellIDs(const uint64_t* aCellIDs, size_t aSize, std::vector<uint8_t>& aEncoded) {
+  // most differences fit in 1-3 bytes
+  aEncoded.reserve(aEncoded.size() + 10 + 2 * aSize);
+  writeVarint(aSize, aEncoded);
+  uint64_t previous = 0;
+  for (size_t iCell = 0; iCell < aSize; ++iCell) {
+    if (aCellIDs[iCell] < previous) {
+      throw std::runtime_error("Cell IDs must be sorted to be encoded, cell ID at index " + std::to_string(iCell) +
+                               " is smaller than the previous one.");
+    }
+    writeVarint(aCellIDs[iCell] - previous, aEncoded);
+    previous = aCellIDs[iCell];
+  }
+}
+
+void encodeCellIDs(const std::vector<uint64_t>& aCellIDs, std::vector<uint8_t>& aEncoded) {
+  encodeCellIDs(aCellIDs.data(), aCellIDs.size(), aEncoded);
+}
+
+size_t decodeCellIDs(const uint8_t* aEncoded, size_t aSize, std::vector<uint64_t>& aCellIDs) {
+  size_t position = 0;
+  uint64_t numCells = readVarint(aEncoded, aSize, position);
+  // each cell takes at least one byte
+  if (numCells > aSize - position) {
+    throw std::runtime_error("Encoded cell IDs are truncated.");
+  }
+  aCellIDs.reserve(aCellIDs.size() + numCells);
+  uint64_t cellID = 0;
+  for (uint64_t iCell = 0; iCell < numCells; ++iCell) {
+    cellID += readVarint(aEncoded, aSize, position);
+    aCellIDs.push_back(cellID);
+  }
+  return position;
+}
+
+size_t decodeCellIDs(const std::vector<uint8_t>& aEncoded, std::vector<uint64_t>& aCellIDs) {
+  return decodeCellIDs(aEncoded.data(), aEncoded.size(), aCellIDs);
+}
+}
+}
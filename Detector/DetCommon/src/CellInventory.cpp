@@ -0,0 +1,263 @@
+#include "DetCommon/CellInventory.h"
+#include "DetCommon/DetUtils.h"
+#include "DetCommon/VolumeGeometryCache.h"
+
+// DD4hep
+#include "DD4hep/Readout.h"
+#include "DD4hep/Segmentations.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+namespace det {
+namespace utils {
+
+namespace {
+const char kMagic[8] = {'F', 'C', 'C', 'C', 'E', 'L', 'L', 'S'};
+const uint32_t kVersion = 1;
+
+/// Names of the fields of a supported segmentation (empty if the segmentation is not supported)
+std::vector<std::string> segmentationFields(const dd4hep::DDSegmentation::Segmentation* aSeg) {
+  // CartesianGridXYZ derives from CartesianGridXY
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::CartesianGridXYZ*>(aSeg)) {
+    return {seg->fieldNameX(), seg->fieldNameY(), seg->fieldNameZ()};
+  }
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::CartesianGridXY*>(aSeg)) {
+    return {seg->fieldNameX(), seg->fieldNameY()};
+  }
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::FCCSWGridPhiEta*>(aSeg)) {
+    return {seg->fieldNameEta(), seg->fieldNamePhi()};
+  }
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::PolarGridRPhi*>(aSeg)) {
+    return {seg->fieldNameR(), seg->fieldNamePhi()};
+  }
+  return {};
+}
+
+/// Fill the ranges (min, max) of the fields of the segmentation for a volume, same order as segmentationFields
+void segmentationRanges(const VolumeGeometry& aGeometry, uint64_t aVolumeId,
+                        const dd4hep::DDSegmentation::Segmentation* aSeg, int32_t* aRanges) {
+  // the cells of Cartesian grids are centred at 0: n = 2 * half + 1
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::CartesianGridXYZ*>(aSeg)) {
+    auto cells = numberOfCells(aGeometry, *seg);
+    for (unsigned iAxis = 0; iAxis < 3; ++iAxis) {
+      aRanges[2 * iAxis] = -static_cast<int32_t>(cells[iAxis] / 2);
+      aRanges[2 * iAxis + 1] = static_cast<int32_t>(cells[iAxis] / 2);
+    }
+  } else if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::CartesianGridXY*>(aSeg)) {
+    auto cells = numberOfCells(aGeometry, *seg);
+    for (unsigned iAxis = 0; iAxis < 2; ++iAxis) {
+      aRanges[2 * iAxis] = -static_cast<int32_t>(cells[iAxis] / 2);
+      aRanges[2 * iAxis + 1] = static_cast<int32_t>(cells[iAxis] / 2);
+    }
+  } else if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::FCCSWGridPhiEta*>(aSeg)) {
+    // (phi bins, eta cells, minimal eta ID), with the granularity of the layer of the volume
+    auto cells = numberOfCells(aGeometry, *seg, aVolumeId);
+    aRanges[0] = static_cast<int32_t>(cells[2]);
+    aRanges[1] = static_cast<int32_t>(cells[2] + cells[1]) - 1;
+    aRanges[2] = 0;
+    aRanges[3] = static_cast<int32_t>(cells[0]) - 1;
+  } else if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::PolarGridRPhi*>(aSeg)) {
+    // r bins from the inner radius (as in numberOfCells), phi bins over [-pi, pi)
+    auto cells = numberOfCells(aGeometry, *seg);
+    int32_t minR = std::floor(aGeometry.tube.x() / seg->gridSizeR());
+    int32_t minPhi = std::floor(-M_PI / seg->gridSizePhi() + 0.5);
+    aRanges[0] = minR;
+    aRanges[1] = minR + static_cast<int32_t>(cells[0]) - 1;
+    aRanges[2] = minPhi;
+    aRanges[3] = minPhi + static_cast<int32_t>(cells[1]) - 1;
+  }
+}
+}
+
+CellInventory CellInventory::build(const dd4hep::Detector& aDetector, const std::string& aReadoutName,
+                                   unsigned aNumThreads) {
+  const dd4hep::DDSegmentation::Segmentation* segmentation =
+      aDetector.readout(aReadoutName).segmentation().segmentation();
+  CellInventory inventory;
+  inventory.m_readoutName = aReadoutName;
+  inventory.m_fieldNames = segmentationFields(segmentation);
+  if (inventory.m_fieldNames.empty()) {
+    throw std::runtime_error("CellInventory: segmentation " + (segmentation ? segmentation->type() : "(none)") +
+                             " of readout " + aReadoutName + " is not supported");
+  }
+  const size_t numFields = inventory.m_fieldNames.size();
+
+  // one traversal of the geometry, volumes ordered by the ID (a volume placed twice with the same ID counts once)
+  auto volumes = VolumeGeometryCache::sensitiveVolumes(aDetector, aReadoutName);
+  std::stable_sort(volumes.begin(), volumes.end(),
+                   [](const auto& aLhs, const auto& aRhs) { return aLhs.volumeId < aRhs.volumeId; });
+  volumes.erase(std::unique(volumes.begin(), volumes.end(),
+                            [](const auto& aLhs, const auto& aRhs) { return aLhs.volumeId == aRhs.volumeId; }),
+                volumes.end());
+  const size_t numVolumes = volumes.size();
+  inventory.m_volumeIds.resize(numVolumes);
+  inventory.m_numCells.resize(numVolumes);
+  inventory.m_ranges.resize(2 * numFields * numVolumes);
+
+  // each thread fills its own block of volumes
+  auto fill = [&](size_t aBegin, size_t aEnd) {
+    for (size_t iVolume = aBegin; iVolume < aEnd; ++iVolume) {
+      const auto& volume = volumes[iVolume];
+      auto geometry = VolumeGeometryCache::compute(volume.solid, *volume.elementTransformation);
+      int32_t* ranges = &inventory.m_ranges[2 * numFields * iVolume];
+      segmentationRanges(geometry, volume.volumeId, segmentation, ranges);
+      uint64_t numCells = 1;
+      for (size_t iField = 0; iField < numFields; ++iField) {
+        int64_t width = static_cast<int64_t>(ranges[2 * iField + 1]) - ranges[2 * iField] + 1;
+        numCells *= std::max<int64_t>(width, 0);
+      }
+      inventory.m_volumeIds[iVolume] = volume.volumeId;
+      inventory.m_numCells[iVolume] = numCells;
+    }
+  };
+  unsigned numThreads = aNumThreads > 0 ? aNumThreads : std::max(1u, std::thread::hardware_concurrency());
+  numThreads = std::max<size_t>(1, std::min<size_t>(numThreads, numVolumes));
+  size_t blockSize = (numVolumes + numThreads - 1) / numThreads;
+  std::vector<std::thread> threads;
+  for (unsigned iThread = 1; iThread < numThreads; ++iThread) {
+    threads.emplace_back(fill, std::min(numVolumes, iThread * blockSize),
+                         std::min(numVolumes, (iThread + 1) * blockSize));
+  }
+  fill(0, std::min(numVolumes, blockSize));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return inventory;
+}
+
+bool CellInventory::write(const std::string& aFileName) const {
+  std::ofstream file(aFileName, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  auto writeValue = [&file](const auto& aValue) { file.write(reinterpret_cast<const char*>(&aValue), sizeof(aValue)); };
+  auto writeString = [&](const std::string& aString) {
+    writeValue(static_cast<uint32_t>(aString.size()));
+    file.write(aString.data(), aString.size());
+  };
+  file.write(kMagic, sizeof(kMagic));
+  writeValue(kVersion);
+  writeString(m_readoutName);
+  writeValue(static_cast<uint32_t>(m_fieldNames.size()));
+  for (const auto& name : m_fieldNames) {
+    writeString(name);
+  }
+  writeValue(static_cast<uint64_t>(m_volumeIds.size()));
+  const size_t rangesPerVolume = 2 * m_fieldNames.size();
+  for (size_t iVolume = 0; iVolume < m_volumeIds.size(); ++iVolume) {
+    writeValue(m_volumeIds[iVolume]);
+    writeValue(m_numCells[iVolume]);
+    file.write(reinterpret_cast<const char*>(&m_ranges[rangesPerVolume * iVolume]), rangesPerVolume * sizeof(int32_t));
+  }
+  return static_cast<bool>(file);
+}
+
+bool CellInventory::read(const std::string& aFileName) {
+  *this = CellInventory();
+  std::ifstream file(aFileName, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  // read the whole file at once and decode it from memory
+  const std::vector<char> buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  size_t position = 0;
+  auto readBytes = [&](void* aDestination, size_t aSize) {
+    if (position + aSize > buffer.size()) {
+      return false;
+    }
+    std::memcpy(aDestination, buffer.data() + position, aSize);
+    position += aSize;
+    return true;
+  };
+  auto readString = [&](std::string& aString) {
+    uint32_t size = 0;
+    if (!readBytes(&size, sizeof(size)) || position + size > buffer.size()) {
+      return false;
+    }
+    aString.assign(buffer.data() + position, size);
+    position += size;
+    return true;
+  };
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  uint32_t numFields = 0;
+  uint64_t numVolumes = 0;
+  bool ok = readBytes(magic, sizeof(magic)) && std::memcmp(magic, kMagic, sizeof(kMagic)) == 0 &&
+            readBytes(&version, sizeof(version)) && version == kVersion && readString(m_readoutName) &&
+            readBytes(&numFields, sizeof(numFields));
+  for (uint32_t iField = 0; ok && iField < numFields; ++iField) {
+    m_fieldNames.emplace_back();
+    ok = readString(m_fieldNames.back());
+  }
+  const size_t volumeSize = 2 * sizeof(uint64_t) + 2 * numFields * sizeof(int32_t);
+  ok = ok && readBytes(&numVolumes, sizeof(numVolumes)) && buffer.size() - position == numVolumes * volumeSize;
+  if (!ok) {
+    *this = CellInventory();
+    return false;
+  }
+  m_volumeIds.resize(numVolumes);
+  m_numCells.resize(numVolumes);
+  m_ranges.resize(2 * numFields * numVolumes);
+  for (size_t iVolume = 0; iVolume < numVolumes; ++iVolume) {
+    readBytes(&m_volumeIds[iVolume], sizeof(uint64_t));
+    readBytes(&m_numCells[iVolume], sizeof(uint64_t));
+    readBytes(&m_ranges[2 * numFields * iVolume], 2 * numFields * sizeof(int32_t));
+  }
+  return true;
+}
+
+uint64_t CellInventory::totalNumberOfCells() const {
+  uint64_t total = 0;
+  for (auto numCells : m_numCells) {
+    total += numCells;
+  }
+  return total;
+}
+
+size_t CellInventory::find(uint64_t aVolumeId) const {
+  auto volume = std::lower_bound(m_volumeIds.begin(), m_volumeIds.end(), aVolumeId);
+  if (volume == m_volumeIds.end() || *volume != aVolumeId) {
+    return m_volumeIds.size();
+  }
+  return volume - m_volumeIds.begin();
+}
+
+void CellInventory::cellIDs(size_t aIndex, const dd4hep::DDSegmentation::BitFieldCoder& aDecoder,
+                            std::vector<uint64_t>& aCellIDs) const {
+  if (m_numCells[aIndex] == 0) {
+    return;
+  }
+  const size_t numFields = m_fieldNames.size();
+  std::vector<size_t> fieldIndices;
+  std::vector<int> values;
+  for (size_t iField = 0; iField < numFields; ++iField) {
+    fieldIndices.push_back(aDecoder.index(m_fieldNames[iField]));
+    values.push_back(range(aIndex, iField).first);
+  }
+  aCellIDs.reserve(aCellIDs.size() + m_numCells[aIndex]);
+  // loop over all the combinations, the last field changes the fastest
+  for (;;) {
+    dd4hep::DDSegmentation::CellID cellID = m_volumeIds[aIndex];
+    for (size_t iField = 0; iField < numFields; ++iField) {
+      aDecoder.set(cellID, fieldIndices[iField], values[iField]);
+    }
+    aCellIDs.push_back(cellID);
+    size_t iField = numFields;
+    while (iField > 0 && values[iField - 1] == range(aIndex, iField - 1).second) {
+      values[iField - 1] = range(aIndex, iField - 1).first;
+      --iField;
+    }
+    if (iField == 0) {
+      return;
+    }
+    ++values[iField - 1];
+  }
+}
+}
+}
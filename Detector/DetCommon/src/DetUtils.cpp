@@ -1,4 +1,9 @@
 #include "DetCommon/DetUtils.h"
+#include "DetCommon/PlacedVolumeIndex.h"
+#include "DetCommon/VolumeGeometryCache.h"
+
+// FCCSW
+#include "DetSegmentation/FCCSWGridPhiEtaVarEta.h"
 
 // DD4hep
 #include "DDG4/Geant4Mapping.h"
@@ -10,6 +15,8 @@
 // ROOT
 #include "TGeoBBox.h"
 
+#include <algorithm>
+
 #ifdef HAVE_GEANT4_UNITS
 #define MM_2_CM 1.0
 #else
@@ -59,6 +66,18 @@ uint64_t cellID(const dd4hep::Segmentation& aSeg, const G4Step& aStep, bool aPre
   return volID;
 }
 
+void driftChamberSegments(const k4::Geant4PreDigiTrackHitsCollection& aHits,
+                          dd4hep::DDSegmentation::DriftChamberSegments& aSegments) {
+  aSegments.clear();
+  aSegments.reserve(aHits.entries());
+  for (size_t iHit = 0; iHit < aHits.entries(); ++iHit) {
+    const k4::Geant4PreDigiTrackHit* hit = aHits[iHit];
+    aSegments.push_back(hit->cellID, hit->prePos.x() * MM_2_CM, hit->prePos.y() * MM_2_CM,
+                        hit->prePos.z() * MM_2_CM, hit->postPos.x() * MM_2_CM, hit->postPos.y() * MM_2_CM,
+                        hit->postPos.z() * MM_2_CM);
+  }
+}
+
 std::vector<std::vector<uint>> combinations(int N, int K) {
   std::vector<std::vector<uint>> indexes;
   std::string bitmask(K, 1);  // K leading 1's
@@ -200,9 +219,10 @@ CLHEP::Hep3Vector envelopeDimensions(uint64_t aVolumeId) {
   return CLHEP::Hep3Vector(box->GetDX(), box->GetDY(), box->GetDZ());
 }
 
-std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXY& aSeg) {
-  // // get half-widths
-  auto halfSizes = envelopeDimensions(aVolumeId);
+namespace {
+/// number of cells in an envelope of given half-widths
+std::array<uint, 2> numberOfCellsInEnvelope(const CLHEP::Hep3Vector& halfSizes,
+                                            const dd4hep::DDSegmentation::CartesianGridXY& aSeg) {
   // get segmentation cell widths
   double xCellSize = aSeg.gridSizeX();
   double yCellSize = aSeg.gridSizeY();
@@ -212,9 +232,8 @@ std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentati
   return {cellsX, cellsY};
 }
 
-std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg) {
-  // // get half-widths
-  auto halfSizes = envelopeDimensions(aVolumeId);
+std::array<uint, 3> numberOfCellsInEnvelope(const CLHEP::Hep3Vector& halfSizes,
+                                            const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg) {
   // get segmentation cell widths
   double xCellSize = aSeg.gridSizeX();
   double yCellSize = aSeg.gridSizeY();
@@ -226,6 +245,73 @@ std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentati
   return {cellsX, cellsY, cellsZ};
 }
 
+/// number of cells in a given range of pseudorapidity, with the granularity of the layer (negative if independent)
+std::array<uint, 3> numberOfCellsInEtaRange(const std::array<double, 2>& etaExtremes,
+                                            const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg, int aLayer) {
+  // get segmentation number of bins in phi
+  uint phiCellNumber = aSeg.phiBins(aLayer);
+  // variable bins in eta: the bins overlapping the range
+  if (auto varEtaSeg = dynamic_cast<const dd4hep::DDSegmentation::FCCSWGridPhiEtaVarEta*>(&aSeg)) {
+    const auto& edges = varEtaSeg->etaEdges();
+    int numBins = varEtaSeg->etaBins();
+    auto binOf = [&edges, numBins](double aEta) {
+      int bin = std::upper_bound(edges.begin(), edges.end(), aEta) - edges.begin() - 1;
+      return std::min(std::max(bin, 0), numBins - 1);
+    };
+    uint minEtaID = binOf(etaExtremes[0]);
+    return {phiCellNumber, binOf(etaExtremes[1]) - minEtaID + 1, minEtaID};
+  }
+  // get segmentation cell width in eta
+  double etaCellSize = aSeg.gridSizeEta(aLayer);
+  // calculate the number of eta volumes
+  // max - min = full eta range, - size = not counting the middle cell centred at 0, + 1 to account for that cell
+  uint cellsEta = ceil(( etaExtremes[1] - etaExtremes[0] - etaCellSize ) / 2 / etaCellSize) * 2 + 1;
+  uint minEtaID = int(floor((etaExtremes[0] + 0.5 * etaCellSize - aSeg.offsetEta(aLayer)) / etaCellSize));
+  return {phiCellNumber, cellsEta, minEtaID};
+}
+
+/// number of cells in a tube of given dimensions
+std::array<uint, 2> numberOfCellsInTube(const CLHEP::Hep3Vector& tubeSizes,
+                                        const dd4hep::DDSegmentation::PolarGridRPhi& aSeg) {
+  // get segmentation cell width
+  double rCellSize = aSeg.gridSizeR();
+  double phiCellSize = aSeg.gridSizePhi();
+  uint cellsRout = ceil(tubeSizes.y() / rCellSize);
+  uint cellsRin = floor(tubeSizes.x() / rCellSize);
+  uint cellsR = cellsRout - cellsRin;
+  uint cellsPhi = ceil(2 * M_PI / phiCellSize);
+  return {cellsR, cellsPhi};
+}
+}
+
+std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXY& aSeg) {
+  // get half-widths
+  return numberOfCellsInEnvelope(envelopeDimensions(aVolumeId), aSeg);
+}
+
+std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXY& aSeg,
+                                  VolumeGeometryCache& aCache) {
+  return numberOfCells(aCache.get(aVolumeId), aSeg);
+}
+
+std::array<uint, 2> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::CartesianGridXY& aSeg) {
+  return numberOfCellsInEnvelope(aGeometry.envelope, aSeg);
+}
+
+std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg) {
+  // get half-widths
+  return numberOfCellsInEnvelope(envelopeDimensions(aVolumeId), aSeg);
+}
+
+std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg,
+                                  VolumeGeometryCache& aCache) {
+  return numberOfCells(aCache.get(aVolumeId), aSeg);
+}
+
+std::array<uint, 3> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::CartesianGridXYZ& aSeg) {
+  return numberOfCellsInEnvelope(aGeometry.envelope, aSeg);
+}
+
 CLHEP::Hep3Vector tubeDimensions(uint64_t aVolumeId) {
   dd4hep::VolumeManager volMgr = dd4hep::Detector::getInstance().volumeManager();
   auto pvol = volMgr.lookupVolumePlacement(aVolumeId);
@@ -262,13 +348,19 @@ std::array<double, 2> tubeEtaExtremes(uint64_t aVolumeId) {
       return {0, 0};
     }
   }
+  dd4hep::VolumeManager volMgr = dd4hep::Detector::getInstance().volumeManager();
+  auto detelement = volMgr.lookupDetElement(aVolumeId);
+  return tubeEtaExtremes(sizes, detelement.nominal().worldTransformation());
+}
+
+std::array<double, 2> tubeEtaExtremes(const CLHEP::Hep3Vector& sizes, const TGeoHMatrix& transformMatrix) {
+  if (sizes.mag() == 0) {
+    return {0, 0};
+  }
   // eta segmentation calculate maximum eta from the inner radius (no offset is taken into account)
   double maxEta = 0;
   double minEta = 0;
   // check if it is a cylinder centred at z=0
-  dd4hep::VolumeManager volMgr = dd4hep::Detector::getInstance().volumeManager();
-  auto detelement = volMgr.lookupDetElement(aVolumeId);
-  const auto& transformMatrix = detelement.nominal().worldTransformation();
   double outGlobal[3];
   double inLocal[] = {0, 0, 0};  // to get middle of the volume
   transformMatrix.LocalToMaster(inLocal, outGlobal);
@@ -286,9 +378,11 @@ std::array<double, 2> tubeEtaExtremes(uint64_t aVolumeId) {
 std::array<double, 2> envelopeEtaExtremes (uint64_t aVolumeId) {
   dd4hep::VolumeManager volMgr = dd4hep::Detector::getInstance().volumeManager();
   auto detelement = volMgr.lookupDetElement(aVolumeId);
-  const auto& transformMatrix = detelement.nominal().worldTransformation();
+  return envelopeEtaExtremes(envelopeDimensions(aVolumeId), detelement.nominal().worldTransformation());
+}
+
+std::array<double, 2> envelopeEtaExtremes(const CLHEP::Hep3Vector& dim, const TGeoHMatrix& transformMatrix) {
   // calculate values of eta in all possible corners of the envelope
-  auto dim = envelopeDimensions(aVolumeId);
   double minEta = 0;
   double maxEta = 0;
   for (uint i = 0; i < 8; i++) {
@@ -325,43 +419,44 @@ std::array<double, 2> volumeEtaExtremes(uint64_t aVolumeId) {
 }
 
 std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg) {
-  // get segmentation number of bins in phi
-  uint phiCellNumber = aSeg.phiBins();
-  // get segmentation cell width in eta
-  double etaCellSize = aSeg.gridSizeEta();
   // get min and max eta of the volume
-  auto etaExtremes = volumeEtaExtremes(aVolumeId);
-  // calculate the number of eta volumes
-  // max - min = full eta range, - size = not counting the middle cell centred at 0, + 1 to account for that cell
-  uint cellsEta = ceil(( etaExtremes[1] - etaExtremes[0] - etaCellSize ) / 2 / etaCellSize) * 2 + 1;
-  uint minEtaID = int(floor((etaExtremes[0] + 0.5 * etaCellSize - aSeg.offsetEta()) / etaCellSize));
-  return {phiCellNumber, cellsEta, minEtaID};
+  return numberOfCellsInEtaRange(volumeEtaExtremes(aVolumeId), aSeg, aSeg.layer(aVolumeId));
+}
+
+std::array<uint, 3> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg,
+                                  VolumeGeometryCache& aCache) {
+  return numberOfCells(aCache.get(aVolumeId), aSeg, aVolumeId);
+}
+
+std::array<uint, 3> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg) {
+  return numberOfCellsInEtaRange(aGeometry.volumeEtaExtremes, aSeg, -1);
+}
+
+std::array<uint, 3> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::FCCSWGridPhiEta& aSeg,
+                                  uint64_t aVolumeId) {
+  return numberOfCellsInEtaRange(aGeometry.volumeEtaExtremes, aSeg, aSeg.layer(aVolumeId));
 }
 
 std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::PolarGridRPhi& aSeg) {
   // get half-widths,
-  auto tubeSizes = tubeDimensions(aVolumeId);
-  // get segmentation cell width
-  double rCellSize = aSeg.gridSizeR();
-  double phiCellSize = aSeg.gridSizePhi();
-  uint cellsRout = ceil(tubeSizes.y() / rCellSize);
-  uint cellsRin = floor(tubeSizes.x() / rCellSize);
-  uint cellsR = cellsRout - cellsRin;
-  uint cellsPhi = ceil(2 * M_PI / phiCellSize);
-  return {cellsR, cellsPhi};
+  return numberOfCellsInTube(tubeDimensions(aVolumeId), aSeg);
+}
+
+std::array<uint, 2> numberOfCells(uint64_t aVolumeId, const dd4hep::DDSegmentation::PolarGridRPhi& aSeg,
+                                  VolumeGeometryCache& aCache) {
+  return numberOfCells(aCache.get(aVolumeId), aSeg);
+}
+
+std::array<uint, 2> numberOfCells(const VolumeGeometry& aGeometry, const dd4hep::DDSegmentation::PolarGridRPhi& aSeg) {
+  return numberOfCellsInTube(aGeometry.tube, aSeg);
 }
 
 unsigned int countPlacedVolumes(TGeoVolume* aHighestVolume, const std::string& aMatchName) {
-  int numberOfPlacedVolumes = 0;
-  TGeoNode* node;
-  TGeoIterator next(aHighestVolume);
-  while ((node = next())) {
-    std::string currentNodeName = node->GetName();
-    if (currentNodeName.find(aMatchName) != std::string::npos) {
-      ++numberOfPlacedVolumes;
-    }
-  }
-  return numberOfPlacedVolumes;
+  return countPlacedVolumes(PlacedVolumeIndex(aHighestVolume), aMatchName);
+}
+
+unsigned int countPlacedVolumes(const PlacedVolumeIndex& aIndex, const std::string& aMatchName) {
+  return aIndex.countContaining(aMatchName);
 }
 }
 }
@@ -0,0 +1,110 @@
+#include "DetCommon/PlacedVolumeIndex.h"
+
+// ROOT
+#include "TGeoNode.h"
+#include "TGeoVolume.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace det {
+namespace utils {
+namespace {
+/// Add the volume and all the volumes placed in it to the list, each volume after all the volumes it is placed in
+void orderVolumes(TGeoVolume* aVolume, std::unordered_set<const TGeoVolume*>& aVisited,
+                  std::vector<TGeoVolume*>& aPostOrder) {
+  if (!aVisited.insert(aVolume).second) {
+    return;
+  }
+  for (int iDaughter = 0; iDaughter < aVolume->GetNdaughters(); ++iDaughter) {
+    orderVolumes(aVolume->GetNode(iDaughter)->GetVolume(), aVisited, aPostOrder);
+  }
+  aPostOrder.push_back(aVolume);
+}
+}
+
+PlacedVolumeIndex::PlacedVolumeIndex(TGeoVolume* aHighestVolume) : m_topVolume(aHighestVolume) {
+  // volumes in reversed post-order: a volume comes after all its mothers
+  std::unordered_set<const TGeoVolume*> visited;
+  std::vector<TGeoVolume*> volumes;
+  orderVolumes(aHighestVolume, visited, volumes);
+  std::reverse(volumes.begin(), volumes.end());
+  // number of placements of each volume in the geometry tree
+  std::unordered_map<const TGeoVolume*, uint64_t> multiplicity;
+  multiplicity[aHighestVolume] = 1;
+  for (const auto* volume : volumes) {
+    uint64_t numPlacements = multiplicity[volume];
+    for (int iDaughter = 0; iDaughter < volume->GetNdaughters(); ++iDaughter) {
+      const TGeoNode* node = volume->GetNode(iDaughter);
+      auto entry = m_entryIndex.emplace(node->GetName(), m_entries.size());
+      if (entry.second) {
+        m_entries.emplace_back();
+        m_entries.back().name = node->GetName();
+      }
+      m_entries[entry.first->second].count += numPlacements;
+      m_entries[entry.first->second].nodes.push_back(node);
+      multiplicity[node->GetVolume()] += numPlacements;
+    }
+  }
+  std::sort(m_entries.begin(), m_entries.end(),
+            [](const Entry& aLeft, const Entry& aRight) { return aLeft.name < aRight.name; });
+  m_cumulativeCounts.assign(1, 0);
+  m_cumulativeCounts.reserve(m_entries.size() + 1);
+  for (size_t iEntry = 0; iEntry < m_entries.size(); ++iEntry) {
+    m_entryIndex[m_entries[iEntry].name] = iEntry;
+    m_cumulativeCounts.push_back(m_cumulativeCounts.back() + m_entries[iEntry].count);
+  }
+}
+
+uint64_t PlacedVolumeIndex::count(const std::string& aName) const {
+  auto entry = m_entryIndex.find(aName);
+  return entry == m_entryIndex.end() ? 0 : m_entries[entry->second].count;
+}
+
+uint64_t PlacedVolumeIndex::countWithPrefix(const std::string& aPrefix) const {
+  auto range = prefixRange(aPrefix);
+  return m_cumulativeCounts[range.second] - m_cumulativeCounts[range.first];
+}
+
+uint64_t PlacedVolumeIndex::countContaining(const std::string& aMatchName) const {
+  auto memoised = m_containingCounts.find(aMatchName);
+  if (memoised != m_containingCounts.end()) {
+    return memoised->second;
+  }
+  uint64_t numberOfPlacedVolumes = 0;
+  for (const auto& entry : m_entries) {
+    if (entry.name.find(aMatchName) != std::string::npos) {
+      numberOfPlacedVolumes += entry.count;
+    }
+  }
+  m_containingCounts.emplace(aMatchName, numberOfPlacedVolumes);
+  return numberOfPlacedVolumes;
+}
+
+const std::vector<const TGeoNode*>& PlacedVolumeIndex::placements(const std::string& aName) const {
+  static const std::vector<const TGeoNode*> noPlacements;
+  auto entry = m_entryIndex.find(aName);
+  return entry == m_entryIndex.end() ? noPlacements : m_entries[entry->second].nodes;
+}
+
+std::vector<std::string> PlacedVolumeIndex::namesWithPrefix(const std::string& aPrefix) const {
+  auto range = prefixRange(aPrefix);
+  std::vector<std::string> names;
+  names.reserve(range.second - range.first);
+  for (size_t iEntry = range.first; iEntry < range.second; ++iEntry) {
+    names.push_back(m_entries[iEntry].name);
+  }
+  return names;
+}
+
+std::pair<size_t, size_t> PlacedVolumeIndex::prefixRange(const std::string& aPrefix) const {
+  // names starting with the prefix are contiguous in the ordered entries
+  auto first = std::lower_bound(m_entries.begin(), m_entries.end(), aPrefix,
+                                [](const Entry& aEntry, const std::string& aName) { return aEntry.name < aName; });
+  auto last = std::partition_point(first, m_entries.end(), [&aPrefix](const Entry& aEntry) {
+    return aEntry.name.compare(0, aPrefix.size(), aPrefix) == 0;
+  });
+  return {static_cast<size_t>(first - m_entries.begin()), static_cast<size_t>(last - m_entries.begin())};
+}
+}
+}
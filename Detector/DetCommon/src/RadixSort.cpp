@@ -0,0 +1,51 @@
+#include "DetCommon/RadixSort.h"
+
+#include <array>
+#include <cstddef>
+#include <numeric>
+
+namespace det {
+namespace utils {
+void radixSortOrder(const std::vector<uint64_t>& aKeys, std::vector<uint32_t>& aOrder) {
+  const size_t numKeys = aKeys.size();
+  aOrder.resize(numKeys);
+  std::iota(aOrder.begin(), aOrder.end(), 0);
+  // bits that are not the same in all the keys
+  uint64_t anyBits = 0;
+  uint64_t allBits = ~uint64_t(0);
+  for (const auto key : aKeys) {
+    anyBits |= key;
+    allBits &= key;
+  }
+  const uint64_t varyingBits = anyBits ^ allBits;
+  if (varyingBits == 0) {
+    return;
+  }
+  // keys are permuted together with the indices, so that each pass reads them sequentially
+  std::vector<uint64_t> keys(aKeys), sortedKeys(numKeys);
+  std::vector<uint32_t> sortedOrder(numKeys);
+  for (unsigned shift = 0; shift < 64; shift += 8) {
+    if (((varyingBits >> shift) & 0xff) == 0) {
+      continue;
+    }
+    std::array<size_t, 256> offsets{};
+    for (const auto key : keys) {
+      ++offsets[(key >> shift) & 0xff];
+    }
+    size_t offset = 0;
+    for (auto& count : offsets) {
+      size_t digitCount = count;
+      count = offset;
+      offset += digitCount;
+    }
+    for (size_t iKey = 0; iKey < numKeys; ++iKey) {
+      size_t position = offsets[(keys[iKey] >> shift) & 0xff]++;
+      sortedKeys[position] = keys[iKey];
+      sortedOrder[position] = aOrder[iKey];
+    }
+    keys.swap(sortedKeys);
+    aOrder.swap(sortedOrder);
+  }
+}
+}
+}
@@ -0,0 +1,207 @@
+#include "DetCommon/ShowerLibrary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace det {
+namespace utils {
+
+namespace {
+const char kMagic[8] = {'F', 'C', 'C', 'S', 'H', 'L', 'I', 'B'};
+const uint32_t kVersion = 1;
+/// magic, version, numbers of the energy and eta bins, unused
+const size_t kHeaderSize = sizeof(kMagic) + 4 * sizeof(uint32_t);
+
+/// Bin of the closest energy (in the logarithm of the energy)
+size_t nearestEnergyBin(const double* aEnergies, size_t aNumBins, double aEnergy) {
+  // first bin with the energy not lower than the given one, then the closer of it and the previous bin
+  size_t bin = std::lower_bound(aEnergies, aEnergies + aNumBins, aEnergy) - aEnergies;
+  if (bin == aNumBins) {
+    return aNumBins - 1;
+  }
+  if (bin > 0 && aEnergy > 0 && std::log(aEnergy / aEnergies[bin - 1]) < std::log(aEnergies[bin] / aEnergy)) {
+    return bin - 1;
+  }
+  return bin;
+}
+
+/// Bin of the value, aNumBins if outside of the edges
+size_t findBin(const double* aEdges, size_t aNumBins, double aValue) {
+  if (aNumBins == 0 || aValue < aEdges[0] || aValue >= aEdges[aNumBins]) {
+    return aNumBins;
+  }
+  return std::upper_bound(aEdges, aEdges + aNumBins + 1, aValue) - aEdges - 1;
+}
+}
+
+ShowerFrame::ShowerFrame(double aDirX, double aDirY, double aDirZ) {
+  double norm = std::sqrt(aDirX * aDirX + aDirY * aDirY + aDirZ * aDirZ);
+  w[0] = aDirX / norm;
+  w[1] = aDirY / norm;
+  w[2] = aDirZ / norm;
+  // u = z x w
+  double transverse = std::sqrt(w[0] * w[0] + w[1] * w[1]);
+  if (transverse > 1e-9) {
+    u[0] = -w[1] / transverse;
+    u[1] = w[0] / transverse;
+  } else {
+    u[0] = 1;
+    u[1] = 0;
+  }
+  u[2] = 0;
+  // v = w x u
+  v[0] = w[1] * u[2] - w[2] * u[1];
+  v[1] = w[2] * u[0] - w[0] * u[2];
+  v[2] = w[0] * u[1] - w[1] * u[0];
+}
+
+ShowerLibrary::~ShowerLibrary() { close(); }
+
+bool ShowerLibrary::open(const std::string& aFileName) {
+  close();
+  int descriptor = ::open(aFileName.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  struct stat status;
+  if (::fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < kHeaderSize) {
+    ::close(descriptor);
+    return false;
+  }
+  m_size = status.st_size;
+  m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, descriptor, 0);
+  // the mapping is kept after the file is closed
+  ::close(descriptor);
+  if (m_data == MAP_FAILED) {
+    m_data = nullptr;
+    m_size = 0;
+    return false;
+  }
+  const char* bytes = static_cast<const char*>(m_data);
+  uint32_t header[4];
+  std::memcpy(header, bytes + sizeof(kMagic), sizeof(header));
+  m_numEnergyBins = header[1];
+  m_numEtaBins = header[2];
+  size_t numBins = m_numEnergyBins * m_numEtaBins;
+  size_t position = kHeaderSize;
+  // sizes checked before each pointer is set (all the sections are 8-byte aligned except the spots)
+  bool ok = std::memcmp(bytes, kMagic, sizeof(kMagic)) == 0 && header[0] == kVersion && numBins > 0 &&
+            m_size >= position + (m_numEnergyBins + m_numEtaBins + 1) * sizeof(double) +
+                           (numBins + 1) * sizeof(uint64_t);
+  if (ok) {
+    m_energies = reinterpret_cast<const double*>(bytes + position);
+    position += m_numEnergyBins * sizeof(double);
+    m_etaEdges = reinterpret_cast<const double*>(bytes + position);
+    position += (m_numEtaBins + 1) * sizeof(double);
+    m_binOffsets = reinterpret_cast<const uint64_t*>(bytes + position);
+    position += (numBins + 1) * sizeof(uint64_t);
+    m_numShowers = m_binOffsets[numBins];
+    ok = m_binOffsets[0] == 0 && std::is_sorted(m_binOffsets, m_binOffsets + numBins + 1) &&
+         m_size >= position + (m_numShowers + 1) * sizeof(uint64_t);
+  }
+  if (ok) {
+    m_showerOffsets = reinterpret_cast<const uint64_t*>(bytes + position);
+    position += (m_numShowers + 1) * sizeof(uint64_t);
+    m_spots = reinterpret_cast<const ShowerSpot*>(bytes + position);
+    ok = m_showerOffsets[0] == 0 && std::is_sorted(m_showerOffsets, m_showerOffsets + m_numShowers + 1) &&
+         m_size == position + m_showerOffsets[m_numShowers] * sizeof(ShowerSpot);
+  }
+  if (!ok) {
+    close();
+  }
+  return ok;
+}
+
+void ShowerLibrary::close() {
+  if (m_data != nullptr) {
+    ::munmap(m_data, m_size);
+  }
+  m_data = nullptr;
+  m_size = 0;
+  m_numEnergyBins = 0;
+  m_numEtaBins = 0;
+  m_numShowers = 0;
+  m_energies = nullptr;
+  m_etaEdges = nullptr;
+  m_binOffsets = nullptr;
+  m_showerOffsets = nullptr;
+  m_spots = nullptr;
+}
+
+size_t ShowerLibrary::energyBin(double aEnergy) const {
+  return nearestEnergyBin(m_energies, m_numEnergyBins, aEnergy);
+}
+
+size_t ShowerLibrary::etaBin(double aEta) const { return findBin(m_etaEdges, m_numEtaBins, aEta); }
+
+std::pair<const ShowerSpot*, size_t> ShowerLibrary::shower(size_t aEnergyBin, size_t aEtaBin, size_t aIndex) const {
+  size_t showerIndex = m_binOffsets[aEnergyBin * m_numEtaBins + aEtaBin] + aIndex;
+  return {m_spots + m_showerOffsets[showerIndex], m_showerOffsets[showerIndex + 1] - m_showerOffsets[showerIndex]};
+}
+
+ShowerLibraryBuilder::ShowerLibraryBuilder(const std::vector<double>& aEnergies, const std::vector<double>& aEtaEdges)
+    : m_energies(aEnergies), m_etaEdges(aEtaEdges) {
+  if (m_energies.empty() || m_etaEdges.size() < 2 || !std::is_sorted(m_energies.begin(), m_energies.end()) ||
+      !std::is_sorted(m_etaEdges.begin(), m_etaEdges.end())) {
+    throw std::invalid_argument("ShowerLibraryBuilder: the energies and eta edges need to be increasing");
+  }
+  m_showers.resize(m_energies.size() * (m_etaEdges.size() - 1));
+}
+
+void ShowerLibraryBuilder::addShower(size_t aEnergyBin, size_t aEtaBin, std::vector<ShowerSpot>&& aSpots) {
+  m_showers[aEnergyBin * (m_etaEdges.size() - 1) + aEtaBin].push_back(std::move(aSpots));
+}
+
+size_t ShowerLibraryBuilder::energyBin(double aEnergy) const {
+  return nearestEnergyBin(m_energies.data(), m_energies.size(), aEnergy);
+}
+
+size_t ShowerLibraryBuilder::etaBin(double aEta) const {
+  return findBin(m_etaEdges.data(), m_etaEdges.size() - 1, aEta);
+}
+
+bool ShowerLibraryBuilder::write(const std::string& aFileName) const {
+  std::ofstream file(aFileName, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  auto writeValue = [&file](const auto& aValue) { file.write(reinterpret_cast<const char*>(&aValue), sizeof(aValue)); };
+  file.write(kMagic, sizeof(kMagic));
+  writeValue(kVersion);
+  writeValue(static_cast<uint32_t>(m_energies.size()));
+  writeValue(static_cast<uint32_t>(m_etaEdges.size() - 1));
+  writeValue(uint32_t(0));
+  file.write(reinterpret_cast<const char*>(m_energies.data()), m_energies.size() * sizeof(double));
+  file.write(reinterpret_cast<const char*>(m_etaEdges.data()), m_etaEdges.size() * sizeof(double));
+  uint64_t offset = 0;
+  writeValue(offset);
+  for (const auto& bin : m_showers) {
+    offset += bin.size();
+    writeValue(offset);
+  }
+  offset = 0;
+  writeValue(offset);
+  for (const auto& bin : m_showers) {
+    for (const auto& shower : bin) {
+      offset += shower.size();
+      writeValue(offset);
+    }
+  }
+  for (const auto& bin : m_showers) {
+    for (const auto& shower : bin) {
+      file.write(reinterpret_cast<const char*>(shower.data()), shower.size() * sizeof(ShowerSpot));
+    }
+  }
+  return static_cast<bool>(file);
+}
+}
+}
@@ -0,0 +1,20 @@
+#include "DetCommon/StaticBitField.h"
+
+namespace det {
+namespace utils {
+bool matchesEncoding(const dd4hep::DDSegmentation::BitFieldCoder& aDecoder, const StaticFieldDescription* aFields,
+                     size_t aNumFields) {
+  if (aDecoder.size() != aNumFields) {
+    return false;
+  }
+  for (size_t iField = 0; iField < aNumFields; ++iField) {
+    const auto& field = aDecoder[iField];
+    if (field.name() != aFields[iField].name || field.offset() != aFields[iField].offset ||
+        field.width() != aFields[iField].width || field.isSigned() != aFields[iField].isSigned) {
+      return false;
+    }
+  }
+  return true;
+}
+}
+}
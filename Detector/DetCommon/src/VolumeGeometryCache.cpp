@@ -0,0 +1,119 @@
+#include "DetCommon/VolumeGeometryCache.h"
+#include "DetCommon/DetUtils.h"
+
+// DD4hep
+#include "DD4hep/DetElement.h"
+#include "DD4hep/IDDescriptor.h"
+#include "DD4hep/Readout.h"
+#include "DD4hep/VolumeManager.h"
+#include "DD4hep/Volumes.h"
+
+// ROOT
+#include "TGeoBBox.h"
+#include "TGeoCone.h"
+#include "TGeoTube.h"
+
+namespace det {
+namespace utils {
+
+const VolumeGeometry& VolumeGeometryCache::get(uint64_t aVolumeId) {
+  auto volume = m_volumes.find(aVolumeId);
+  if (volume == m_volumes.end()) {
+    volume = m_volumes.emplace(aVolumeId, compute(aVolumeId)).first;
+  }
+  return volume->second;
+}
+
+VolumeGeometry VolumeGeometryCache::compute(uint64_t aVolumeId) {
+  dd4hep::VolumeManager volMgr = dd4hep::Detector::getInstance().volumeManager();
+  auto pvol = volMgr.lookupVolumePlacement(aVolumeId);
+  auto detelement = volMgr.lookupDetElement(aVolumeId);
+  return compute(pvol.volume().solid(), detelement.nominal().worldTransformation());
+}
+
+VolumeGeometry VolumeGeometryCache::compute(const dd4hep::Solid& aSolid, const TGeoHMatrix& aWorldTransformation) {
+  VolumeGeometry geometry;
+  TGeoShape* shape = aSolid.ptr();
+  // casts as in envelopeDimensions, tubeDimensions and coneDimensions
+  TGeoBBox* box = dynamic_cast<TGeoBBox*>(shape);
+  geometry.envelope = CLHEP::Hep3Vector(box->GetDX(), box->GetDY(), box->GetDZ());
+  if (TGeoTubeSeg* tube = dynamic_cast<TGeoTubeSeg*>(shape)) {
+    geometry.shape = VolumeGeometry::Shape::Tube;
+    geometry.tube = CLHEP::Hep3Vector(tube->GetRmin(), tube->GetRmax(), tube->GetDZ());
+  } else if (TGeoCone* cone = dynamic_cast<TGeoCone*>(shape)) {
+    geometry.shape = VolumeGeometry::Shape::Cone;
+    geometry.cone = CLHEP::Hep3Vector(cone->GetRmin1(), cone->GetRmax1(), cone->GetDZ());
+  }
+  geometry.worldTransformation = aWorldTransformation;
+  // if it is not a cylinder maybe it is a cone (same calculation for extremes), as in tubeEtaExtremes
+  geometry.tubeEtaExtremes =
+      utils::tubeEtaExtremes(geometry.tube.mag() == 0 ? geometry.cone : geometry.tube, aWorldTransformation);
+  geometry.envelopeEtaExtremes = utils::envelopeEtaExtremes(geometry.envelope, aWorldTransformation);
+  // as in volumeEtaExtremes: envelope only if the volume is not a cylinder/disc
+  if (geometry.tubeEtaExtremes[0] != 0 or geometry.tubeEtaExtremes[1] != 0) {
+    geometry.volumeEtaExtremes = geometry.tubeEtaExtremes;
+  } else {
+    geometry.volumeEtaExtremes = geometry.envelopeEtaExtremes;
+  }
+  return geometry;
+}
+
+size_t VolumeGeometryCache::prefill(const dd4hep::Detector& aDetector, const std::string& aReadoutName) {
+  size_t numVolumes = m_volumes.size();
+  for (const auto& volume : sensitiveVolumes(aDetector, aReadoutName)) {
+    if (m_volumes.find(volume.volumeId) == m_volumes.end()) {
+      m_volumes.emplace(volume.volumeId, compute(volume.solid, *volume.elementTransformation));
+    }
+  }
+  return m_volumes.size() - numVolumes;
+}
+
+std::vector<VolumeGeometryCache::SensitiveVolume> VolumeGeometryCache::sensitiveVolumes(
+    const dd4hep::Detector& aDetector, const std::string& aReadoutName) {
+  dd4hep::Readout readout = aDetector.readout(aReadoutName);
+  std::vector<SensitiveVolume> volumes;
+  // detectors (top detector elements) with a sensitive detector using the readout
+  for (const auto& entry : aDetector.sensitiveDetectors()) {
+    dd4hep::SensitiveDetector sensDet(entry.second);
+    if (sensDet.readout().ptr() == readout.ptr()) {
+      findInElement(aDetector.detector(entry.first), readout, volumes);
+    }
+  }
+  return volumes;
+}
+
+void VolumeGeometryCache::findInElement(const dd4hep::DetElement& aElement, const dd4hep::Readout& aReadout,
+                                        std::vector<SensitiveVolume>& aVolumes) {
+  std::unordered_set<const TGeoNode*> childPlacements;
+  for (const auto& child : aElement.children()) {
+    childPlacements.insert(child.second.placement().ptr());
+    findInElement(child.second, aReadout, aVolumes);
+  }
+  findInPlacement(aElement.placement(), aElement.volumeID(), aElement.nominal().worldTransformation(), aReadout,
+                  childPlacements, aVolumes);
+}
+
+void VolumeGeometryCache::findInPlacement(const dd4hep::PlacedVolume& aPlacement, uint64_t aVolumeId,
+                                          const TGeoHMatrix& aElementTransform, const dd4hep::Readout& aReadout,
+                                          const std::unordered_set<const TGeoNode*>& aChildPlacements,
+                                          std::vector<SensitiveVolume>& aVolumes) {
+  dd4hep::Volume volume = aPlacement.volume();
+  if (volume.isSensitive() && volume.sensitiveDetector().readout().ptr() == aReadout.ptr()) {
+    aVolumes.push_back({aVolumeId, volume.solid(), &aElementTransform});
+  }
+  const auto* decoder = aReadout.idSpec().decoder();
+  for (int iDaughter = 0; iDaughter < volume->GetNdaughters(); ++iDaughter) {
+    const TGeoNode* node = volume->GetNode(iDaughter);
+    if (aChildPlacements.count(node) > 0) {
+      continue;
+    }
+    dd4hep::PlacedVolume daughter(node);
+    uint64_t volumeId = aVolumeId;
+    for (const auto& id : daughter.volIDs()) {
+      decoder->set(volumeId, id.first, id.second);
+    }
+    findInPlacement(daughter, volumeId, aElementTransform, aReadout, aChildPlacements, aVolumes);
+  }
+}
+}
+}
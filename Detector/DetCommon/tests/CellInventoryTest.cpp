@@ -0,0 +1,184 @@
+// FCCSW
+#include "DetCommon/CellInventory.h"
+#include "DetCommon/DetUtils.h"
+#include "DetCommon/VolumeGeometryCache.h"
+
+// DD4hep
+#include "DD4hep/Detector.h"
+
+// std
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/** CellInventoryTest Detector/DetCommon/tests/CellInventoryTest.cpp
+ *
+ *  Test of the inventory of the cells of a readout (DetCommon/CellInventory.h) and of its binary format ("FCCCELLS").
+ *  The inventories of the readouts of the compact file of VolumeGeometryCacheTest (phi-eta, r-phi and x-y-z
+ *  segmentations) are built and compared with det::utils::numberOfCells and with the cell IDs of each volume.
+ *  Each inventory is written and read back: the readout name, the fields, the volume IDs, the numbers of cells and
+ *  the ranges are compared with the ones that were written.
+ *  The file truncated at each section (and by one byte), a file with a wrong magic or version, and a file with an
+ *  extra byte must be rejected, leaving the inventory empty.
+ *  Returns 1 if any check fails.
+ *
+ *  Usage: CellInventoryTest <compact file>
+ */
+
+using det::utils::CellInventory;
+
+namespace {
+int numFailed = 0;
+
+void check(bool aCondition, const std::string& aMessage) {
+  if (!aCondition) {
+    std::cerr << "FAILED: " << aMessage << std::endl;
+    numFailed++;
+  }
+}
+
+/** Write a copy of the file with the content changed.
+ *  @param[in] aBytes Content of the original file.
+ *  @param[in] aSize Number of the bytes to be written.
+ *  @param[in] aFileName Name of the file.
+ */
+void writeBytes(const std::vector<char>& aBytes, size_t aSize, const std::string& aFileName) {
+  std::ofstream file(aFileName, std::ios::binary);
+  file.write(aBytes.data(), aSize);
+}
+
+/// Check that the inventory is empty (after a rejected file)
+bool isEmpty(const CellInventory& aInventory) {
+  return aInventory.readoutName().empty() && aInventory.fieldNames().empty() && aInventory.numberOfVolumes() == 0;
+}
+
+/// Number of cells of the volume from det::utils::numberOfCells, 0 for the Cartesian grids (ranges centred at 0)
+uint64_t expectedNumberOfCells(const dd4hep::DDSegmentation::Segmentation* aSeg, uint64_t aVolumeId) {
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::FCCSWGridPhiEta*>(aSeg)) {
+    auto cells = det::utils::numberOfCells(aVolumeId, *seg);
+    return static_cast<uint64_t>(cells[0]) * cells[1];
+  }
+  if (auto seg = dynamic_cast<const dd4hep::DDSegmentation::PolarGridRPhi*>(aSeg)) {
+    auto cells = det::utils::numberOfCells(aVolumeId, *seg);
+    return static_cast<uint64_t>(cells[0]) * cells[1];
+  }
+  return 0;
+}
+}
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <compact file>" << std::endl;
+    return 1;
+  }
+  dd4hep::Detector& detector = dd4hep::Detector::getInstance();
+  detector.fromCompact(argv[1]);
+  detector.volumeManager();
+  detector.apply("DD4hepVolumeManager", 0, 0);
+
+  const std::string fileName = "CellInventoryTest.cells";
+  const std::string brokenFileName = "CellInventoryTest_broken.cells";
+  uint64_t totalNumCells = 0;
+  for (const std::string readoutName : {"BarrelPhiEta", "EndcapPhiEta", "ForwardPhiEta", "DiscRPhi", "BoxXYZ"}) {
+    dd4hep::Readout readout = detector.readout(readoutName);
+    const auto* segmentation = readout.segmentation().segmentation();
+    const auto& decoder = *readout.idSpec().decoder();
+    CellInventory inventory = CellInventory::build(detector, readoutName, 2);
+    check(inventory.readoutName() == readoutName, readoutName + ": readout name");
+    check(inventory.numberOfVolumes() ==
+              det::utils::VolumeGeometryCache::sensitiveVolumes(detector, readoutName).size(),
+          readoutName + ": number of volumes");
+    for (size_t iVolume = 0; iVolume < inventory.numberOfVolumes(); ++iVolume) {
+      uint64_t volumeId = inventory.volumeId(iVolume);
+      std::string name = readoutName + " volume " + std::to_string(volumeId);
+      check(inventory.find(volumeId) == iVolume, name + ": found");
+      uint64_t numCells = 1;
+      for (size_t iField = 0; iField < inventory.fieldNames().size(); ++iField) {
+        auto range = inventory.range(iVolume, iField);
+        numCells *= std::max(range.second - range.first + 1, 0);
+      }
+      check(numCells > 0 && numCells == inventory.numberOfCells(iVolume), name + ": number of cells of the ranges");
+      uint64_t expected = expectedNumberOfCells(segmentation, volumeId);
+      check(expected == 0 || expected == numCells, name + ": number of cells as det::utils::numberOfCells");
+      // all the cell IDs, distinct and in the volume
+      std::vector<uint64_t> cellIDs;
+      inventory.cellIDs(iVolume, decoder, cellIDs);
+      check(cellIDs.size() == numCells, name + ": number of cell IDs");
+      std::sort(cellIDs.begin(), cellIDs.end());
+      check(std::adjacent_find(cellIDs.begin(), cellIDs.end()) == cellIDs.end(), name + ": distinct cell IDs");
+      check(std::all_of(cellIDs.begin(), cellIDs.end(),
+                        [&](uint64_t aCellID) { return segmentation->volumeID(aCellID) == volumeId; }),
+            name + ": cell IDs in the volume");
+    }
+    check(inventory.find(~uint64_t(0)) == inventory.numberOfVolumes(), readoutName + ": unknown volume not found");
+    totalNumCells += inventory.totalNumberOfCells();
+
+    // round trip
+    check(inventory.write(fileName), readoutName + ": inventory written");
+    CellInventory readInventory;
+    check(readInventory.read(fileName), readoutName + ": inventory read");
+    check(readInventory.readoutName() == inventory.readoutName() &&
+              readInventory.fieldNames() == inventory.fieldNames() &&
+              readInventory.numberOfVolumes() == inventory.numberOfVolumes(),
+          readoutName + ": header read back");
+    for (size_t iVolume = 0; iVolume < readInventory.numberOfVolumes(); ++iVolume) {
+      bool sameVolume = readInventory.volumeId(iVolume) == inventory.volumeId(iVolume) &&
+                        readInventory.numberOfCells(iVolume) == inventory.numberOfCells(iVolume);
+      for (size_t iField = 0; iField < inventory.fieldNames().size(); ++iField) {
+        sameVolume = sameVolume && readInventory.range(iVolume, iField) == inventory.range(iVolume, iField);
+      }
+      check(sameVolume, readoutName + ": volume " + std::to_string(iVolume) + " read back");
+    }
+    check(readInventory.totalNumberOfCells() == inventory.totalNumberOfCells(), readoutName + ": total read back");
+
+    // truncated files: the magic, the version, the readout name, the fields, the number of volumes, the last volume
+    std::ifstream file(fileName, std::ios::binary);
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    size_t fieldsSize = sizeof(uint32_t);
+    for (const auto& field : inventory.fieldNames()) {
+      fieldsSize += sizeof(uint32_t) + field.size();
+    }
+    const size_t versionEnd = 8 + sizeof(uint32_t);
+    const size_t nameEnd = versionEnd + sizeof(uint32_t) + readoutName.size();
+    const size_t headerSize = nameEnd + fieldsSize + sizeof(uint64_t);
+    const size_t volumeSize = 2 * sizeof(uint64_t) + 2 * inventory.fieldNames().size() * sizeof(int32_t);
+    check(bytes.size() == headerSize + inventory.numberOfVolumes() * volumeSize, readoutName + ": size of the file");
+    for (size_t size : {size_t(0), size_t(7), versionEnd - 1, versionEnd, nameEnd - 1, nameEnd, nameEnd + fieldsSize,
+                        headerSize - 1, bytes.size() - volumeSize, bytes.size() - sizeof(int32_t),
+                        bytes.size() - 1}) {
+      writeBytes(bytes, size, brokenFileName);
+      check(!readInventory.read(brokenFileName),
+            readoutName + ": file truncated to " + std::to_string(size) + " bytes rejected");
+      check(isEmpty(readInventory), readoutName + ": rejected inventory is empty");
+    }
+    // wrong magic, wrong version, extra byte
+    std::vector<char> wrongBytes(bytes);
+    wrongBytes[0] = 'X';
+    writeBytes(wrongBytes, wrongBytes.size(), brokenFileName);
+    check(!readInventory.read(brokenFileName), readoutName + ": file with a wrong magic rejected");
+    wrongBytes = bytes;
+    wrongBytes[8]++;
+    writeBytes(wrongBytes, wrongBytes.size(), brokenFileName);
+    check(!readInventory.read(brokenFileName), readoutName + ": file with a wrong version rejected");
+    wrongBytes = bytes;
+    wrongBytes.push_back(0);
+    writeBytes(wrongBytes, wrongBytes.size(), brokenFileName);
+    check(!readInventory.read(brokenFileName), readoutName + ": file with an extra byte rejected");
+    check(isEmpty(readInventory), readoutName + ": rejected inventory is empty");
+  }
+  CellInventory missingInventory;
+  check(!missingInventory.read("CellInventoryTest_missing.cells"), "missing file rejected");
+
+  std::remove(fileName.c_str());
+  std::remove(brokenFileName.c_str());
+  if (numFailed > 0) {
+    std::cerr << numFailed << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "CellInventory round trip: " << totalNumCells << " cells" << std::endl;
+  return 0;
+}
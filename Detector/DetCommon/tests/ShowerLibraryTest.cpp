@@ -0,0 +1,156 @@
+// FCCSW
+#include "DetCommon/ShowerLibrary.h"
+
+// std
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/** ShowerLibraryTest Detector/DetCommon/tests/ShowerLibraryTest.cpp
+ *
+ *  Round trip of the binary format of the shower library (see DetCommon/ShowerLibrary.h).
+ *  A small library is written by ShowerLibraryBuilder and mapped by ShowerLibrary: the bins, the numbers of the
+ *  showers in the bins and the spots of each shower are compared with the ones that were added. The bins found for
+ *  the energies and pseudorapidities are compared with the ones of the builder.
+ *  The file truncated at each section (and by one byte), and a file with a wrong magic, must be rejected.
+ *  Returns 1 if any check fails.
+ */
+
+using det::utils::ShowerLibrary;
+using det::utils::ShowerLibraryBuilder;
+using det::utils::ShowerSpot;
+
+namespace {
+int numFailed = 0;
+
+void check(bool aCondition, const std::string& aMessage) {
+  if (!aCondition) {
+    std::cerr << "FAILED: " << aMessage << std::endl;
+    numFailed++;
+  }
+}
+
+/** Write a copy of the file with the content changed.
+ *  @param[in] aBytes Content of the original file.
+ *  @param[in] aSize Number of the bytes to be written.
+ *  @param[in] aFileName Name of the file.
+ */
+void writeBytes(const std::vector<char>& aBytes, size_t aSize, const std::string& aFileName) {
+  std::ofstream file(aFileName, std::ios::binary);
+  file.write(aBytes.data(), aSize);
+}
+}
+
+int main() {
+  const std::string fileName = "ShowerLibraryTest.shlib";
+  const std::string brokenFileName = "ShowerLibraryTest_broken.shlib";
+  const std::vector<double> energies = {1., 10., 100.};
+  const std::vector<double> etaEdges = {-0.5, 0., 0.5};
+
+  // showers of each (energy, eta) bin, energy-major; the bin (1, 0) is left empty
+  std::vector<std::vector<std::vector<ShowerSpot>>> showers(energies.size() * (etaEdges.size() - 1));
+  ShowerLibraryBuilder builder(energies, etaEdges);
+  for (size_t iEnergy = 0; iEnergy < energies.size(); ++iEnergy) {
+    for (size_t iEta = 0; iEta + 1 < etaEdges.size(); ++iEta) {
+      size_t bin = iEnergy * (etaEdges.size() - 1) + iEta;
+      size_t numShowers = (iEnergy == 1 && iEta == 0) ? 0 : bin % 3 + 1;
+      for (size_t iShower = 0; iShower < numShowers; ++iShower) {
+        std::vector<ShowerSpot> spots;
+        for (size_t iSpot = 0; iSpot < iShower + bin + 1; ++iSpot) {
+          float value = 100.f * bin + 10.f * iShower + iSpot;
+          spots.push_back({value, -value, 0.5f * value, 1.f / (iSpot + 1)});
+        }
+        showers[bin].push_back(spots);
+        builder.addShower(iEnergy, iEta, std::move(spots));
+      }
+      check(builder.numberOfShowers(iEnergy, iEta) == numShowers, "number of showers in the builder");
+    }
+  }
+  check(builder.write(fileName), "library written");
+
+  // round trip
+  ShowerLibrary library;
+  check(library.open(fileName), "library mapped");
+  check(library.numberOfEnergyBins() == energies.size(), "number of energy bins");
+  check(library.numberOfEtaBins() + 1 == etaEdges.size(), "number of eta bins");
+  for (size_t iEnergy = 0; iEnergy < library.numberOfEnergyBins(); ++iEnergy) {
+    check(library.energy(iEnergy) == energies[iEnergy], "energy of the bin");
+  }
+  for (size_t iEdge = 0; iEdge <= library.numberOfEtaBins(); ++iEdge) {
+    check(library.etaEdge(iEdge) == etaEdges[iEdge], "eta edge");
+  }
+  size_t totalNumShowers = 0;
+  for (size_t iEnergy = 0; iEnergy < library.numberOfEnergyBins(); ++iEnergy) {
+    for (size_t iEta = 0; iEta < library.numberOfEtaBins(); ++iEta) {
+      const auto& binShowers = showers[iEnergy * library.numberOfEtaBins() + iEta];
+      check(library.numberOfShowers(iEnergy, iEta) == binShowers.size(), "number of showers in the bin");
+      totalNumShowers += binShowers.size();
+      for (size_t iShower = 0; iShower < library.numberOfShowers(iEnergy, iEta); ++iShower) {
+        auto shower = library.shower(iEnergy, iEta, iShower);
+        const auto& spots = binShowers[iShower];
+        check(shower.second == spots.size(), "number of spots of the shower");
+        for (size_t iSpot = 0; iSpot < shower.second && iSpot < spots.size(); ++iSpot) {
+          const auto& spot = shower.first[iSpot];
+          check(spot.longitudinal == spots[iSpot].longitudinal && spot.transverseU == spots[iSpot].transverseU &&
+                    spot.transverseV == spots[iSpot].transverseV &&
+                    spot.energyFraction == spots[iSpot].energyFraction,
+                "spot of the shower");
+        }
+      }
+    }
+  }
+  check(library.totalNumberOfShowers() == totalNumShowers, "total number of showers");
+  for (double energy : {0.1, 1., 2., 3.5, 10., 31., 32., 100., 1000.}) {
+    check(library.energyBin(energy) == builder.energyBin(energy), "energy bin of " + std::to_string(energy));
+  }
+  for (double eta : {-1., -0.5, -0.1, 0., 0.3, 0.5, 1.}) {
+    check(library.etaBin(eta) == builder.etaBin(eta), "eta bin of " + std::to_string(eta));
+  }
+  check(library.etaBin(-1.) == library.numberOfEtaBins() && library.etaBin(0.5) == library.numberOfEtaBins(),
+        "eta outside of the library");
+  library.close();
+  check(library.numberOfEnergyBins() == 0 && library.totalNumberOfShowers() == 0, "library closed");
+
+  // truncated files: the header, the bins, the offsets of the bins and of the showers, and the last spot
+  std::ifstream file(fileName, std::ios::binary);
+  const std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  const size_t numBins = showers.size();
+  const size_t headerSize = 8 + 4 * sizeof(uint32_t);
+  const size_t binsSize = (energies.size() + etaEdges.size()) * sizeof(double);
+  const size_t binOffsetsSize = (numBins + 1) * sizeof(uint64_t);
+  const size_t showerOffsetsSize = (totalNumShowers + 1) * sizeof(uint64_t);
+  for (size_t size : {size_t(0), headerSize - 1, headerSize, headerSize + binsSize,
+                      headerSize + binsSize + binOffsetsSize,
+                      headerSize + binsSize + binOffsetsSize + showerOffsetsSize - 1,
+                      headerSize + binsSize + binOffsetsSize + showerOffsetsSize, bytes.size() - sizeof(ShowerSpot),
+                      bytes.size() - 1}) {
+    writeBytes(bytes, size, brokenFileName);
+    check(!library.open(brokenFileName), "file truncated to " + std::to_string(size) + " bytes rejected");
+    check(library.numberOfEnergyBins() == 0 && library.totalNumberOfShowers() == 0, "rejected library is empty");
+  }
+  // wrong magic, extra byte
+  std::vector<char> wrongBytes(bytes);
+  wrongBytes[0] = 'X';
+  writeBytes(wrongBytes, wrongBytes.size(), brokenFileName);
+  check(!library.open(brokenFileName), "file with a wrong magic rejected");
+  wrongBytes = bytes;
+  wrongBytes.push_back(0);
+  writeBytes(wrongBytes, wrongBytes.size(), brokenFileName);
+  check(!library.open(brokenFileName), "file with an extra byte rejected");
+  check(!library.open("ShowerLibraryTest_missing.shlib"), "missing file rejected");
+  // the original file is still valid
+  check(library.open(fileName), "library mapped again");
+  library.close();
+
+  std::remove(fileName.c_str());
+  std::remove(brokenFileName.c_str());
+  if (numFailed > 0) {
+    std::cerr << numFailed << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "ShowerLibrary round trip: " << totalNumShowers << " showers in " << numBins << " bins" << std::endl;
+  return 0;
+}
@@ -0,0 +1,122 @@
+// FCCSW
+#include "DetCommon/DetUtils.h"
+#include "DetCommon/VolumeGeometryCache.h"
+
+// DD4hep
+#include "DD4hep/Detector.h"
+#include "DD4hep/VolumeManager.h"
+
+// std
+#include <iostream>
+#include <string>
+#include <vector>
+
+/** VolumeGeometryCacheTest Detector/DetCommon/tests/VolumeGeometryCacheTest.cpp
+ *
+ *  Test of the cached geometry of the volumes (DetCommon/VolumeGeometryCache.h) against the functions of det::utils
+ *  looking up the volume manager at each call.
+ *  The compact file (tests/compact/VolumeGeometryCache.xml) has a sensitive tube centred at z = 0, a tube and a cone
+ *  shifted in z, a disc and a rotated box, each with its own readout. For all the sensitive volumes of each readout
+ *  (found without the volume manager), the cache filled at once (prefill) and the cache filled on the first access
+ *  (get) must give the same dimensions, pseudorapidity extremes and numbers of cells as the uncached functions.
+ *  Returns 1 if any check fails.
+ *
+ *  Usage: VolumeGeometryCacheTest <compact file>
+ */
+
+using det::utils::VolumeGeometry;
+using det::utils::VolumeGeometryCache;
+
+namespace {
+int numFailed = 0;
+
+void check(bool aCondition, const std::string& aMessage) {
+  if (!aCondition) {
+    std::cerr << "FAILED: " << aMessage << std::endl;
+    numFailed++;
+  }
+}
+
+/// Compare the dimensions and the pseudorapidity extremes of the cached volume with the uncached ones
+void checkGeometry(const VolumeGeometry& aGeometry, uint64_t aVolumeId, const std::string& aName) {
+  check(aGeometry.envelope == det::utils::envelopeDimensions(aVolumeId), aName + ": envelope dimensions");
+  check(aGeometry.tube == det::utils::tubeDimensions(aVolumeId), aName + ": tube dimensions");
+  check(aGeometry.cone == det::utils::coneDimensions(aVolumeId), aName + ": cone dimensions");
+  check(aGeometry.tubeEtaExtremes == det::utils::tubeEtaExtremes(aVolumeId), aName + ": tube eta extremes");
+  check(aGeometry.envelopeEtaExtremes == det::utils::envelopeEtaExtremes(aVolumeId),
+        aName + ": envelope eta extremes");
+  check(aGeometry.volumeEtaExtremes == det::utils::volumeEtaExtremes(aVolumeId), aName + ": volume eta extremes");
+}
+
+/// Compare the numbers of cells of the cached volume with the uncached ones, for the segmentation of the readout
+void checkNumberOfCells(dd4hep::Segmentation aSegmentation, uint64_t aVolumeId, VolumeGeometryCache& aCache,
+                        const std::string& aName) {
+  auto segmentation = aSegmentation.segmentation();
+  if (auto phiEta = dynamic_cast<dd4hep::DDSegmentation::FCCSWGridPhiEta*>(segmentation)) {
+    auto cells = det::utils::numberOfCells(aVolumeId, *phiEta);
+    check(cells == det::utils::numberOfCells(aVolumeId, *phiEta, aCache), aName + ": number of cells in phi-eta");
+    check(cells[0] > 0 && cells[1] > 0, aName + ": cells in phi-eta found");
+  } else if (auto rPhi = dynamic_cast<dd4hep::DDSegmentation::PolarGridRPhi*>(segmentation)) {
+    auto cells = det::utils::numberOfCells(aVolumeId, *rPhi);
+    check(cells == det::utils::numberOfCells(aVolumeId, *rPhi, aCache), aName + ": number of cells in r-phi");
+    check(cells[0] > 0 && cells[1] > 0, aName + ": cells in r-phi found");
+  } else if (auto xyz = dynamic_cast<dd4hep::DDSegmentation::CartesianGridXYZ*>(segmentation)) {
+    auto cells = det::utils::numberOfCells(aVolumeId, *xyz);
+    check(cells == det::utils::numberOfCells(aVolumeId, *xyz, aCache), aName + ": number of cells in x-y-z");
+    check(cells[0] > 0 && cells[1] > 0 && cells[2] > 0, aName + ": cells in x-y-z found");
+  } else {
+    check(false, aName + ": segmentation " + aSegmentation.type() + " not tested");
+  }
+}
+}
+
+int main(int argc, char* argv[]) {
+  if (argc != 2) {
+    std::cerr << "Usage: " << argv[0] << " <compact file>" << std::endl;
+    return 1;
+  }
+  dd4hep::Detector& detector = dd4hep::Detector::getInstance();
+  detector.fromCompact(argv[1]);
+  detector.volumeManager();
+  detector.apply("DD4hepVolumeManager", 0, 0);
+  dd4hep::VolumeManager volumeManager = detector.volumeManager();
+
+  const std::vector<std::string> readouts = {"BarrelPhiEta", "EndcapPhiEta", "ForwardPhiEta", "DiscRPhi", "BoxXYZ"};
+  const std::vector<VolumeGeometry::Shape> shapes = {VolumeGeometry::Shape::Tube, VolumeGeometry::Shape::Tube,
+                                                      VolumeGeometry::Shape::Cone, VolumeGeometry::Shape::Tube,
+                                                      VolumeGeometry::Shape::Other};
+  size_t numVolumes = 0;
+  for (size_t iReadout = 0; iReadout < readouts.size(); ++iReadout) {
+    const std::string& readoutName = readouts[iReadout];
+    auto volumes = VolumeGeometryCache::sensitiveVolumes(detector, readoutName);
+    check(volumes.size() == 1, readoutName + ": one sensitive volume found");
+    VolumeGeometryCache prefilledCache;
+    check(prefilledCache.prefill(detector, readoutName) == volumes.size(), readoutName + ": volumes prefilled");
+    check(prefilledCache.prefill(detector, readoutName) == 0, readoutName + ": volumes prefilled once");
+    VolumeGeometryCache lazyCache;
+    for (const auto& volume : volumes) {
+      std::string name = readoutName + " volume " + std::to_string(volume.volumeId);
+      // the volume ID built in the traversal is the one of the volume manager
+      check(volumeManager.lookupVolumePlacement(volume.volumeId).volume().solid().ptr() == volume.solid.ptr(),
+            name + ": placement of the volume ID");
+      const VolumeGeometry& geometry = prefilledCache.get(volume.volumeId);
+      check(geometry.shape == shapes[iReadout], name + ": shape");
+      checkGeometry(geometry, volume.volumeId, name + " (prefill)");
+      checkGeometry(lazyCache.get(volume.volumeId), volume.volumeId, name + " (get)");
+      checkNumberOfCells(detector.readout(readoutName).segmentation(), volume.volumeId, prefilledCache,
+                         name + " (prefill)");
+      checkNumberOfCells(detector.readout(readoutName).segmentation(), volume.volumeId, lazyCache, name + " (get)");
+    }
+    check(prefilledCache.size() == volumes.size() && lazyCache.size() == volumes.size(),
+          readoutName + ": no volume added by the access");
+    numVolumes += volumes.size();
+  }
+
+  if (numFailed > 0) {
+    std::cerr << numFailed << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "VolumeGeometryCache vs volume manager: " << numVolumes << " volumes of " << readouts.size()
+            << " readouts" << std::endl;
+  return 0;
+}
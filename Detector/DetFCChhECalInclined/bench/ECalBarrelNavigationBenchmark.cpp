@@ -0,0 +1,173 @@
+// DD4hep
+#include "DD4hep/Detector.h"
+#include "DDG4/Geant4Converter.h"
+#include "DDG4/Geant4Mapping.h"
+
+// Geant4
+#include "G4GeometryManager.hh"
+#include "G4Navigator.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+
+// CLHEP
+#include "CLHEP/Units/SystemOfUnits.h"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+/** ECalBarrelNavigationBenchmark Detector/DetFCChhECalInclined/bench/ECalBarrelNavigationBenchmark.cpp
+ *
+ *  Standalone benchmark of the Geant4 navigation in the geometry of the compact files (e.g. the inclined ECal barrel
+ *  with the boolean solids, FCChh_ECalBarrel_withCryostat.xml, or with the native shapes,
+ *  FCChh_ECalBarrel_withCryostat_nativeShapes.xml). The geometry is converted to Geant4 as in GeoConstruction,
+ *  without a run manager and without physics.
+ *  Straight tracks (geantinos) from the origin, with random directions (fixed seed) in the given eta range, are
+ *  transported from boundary to boundary with a G4Navigator (ComputeStep and LocateGlobalPointAndSetup) until they
+ *  leave the given radius or the world. The time per step and the number of steps per track are reported (best of
+ *  the repetitions). The numbers of steps are the same for geometries with the same boundaries.
+ *
+ *  Usage: ECalBarrelNavigationBenchmark [-n <tracks>] [-r <repetitions>] [-s <seed>] [--eta <max eta>]
+ *                                       [--radius <max radius in mm>] <compact files>
+ *    -n, --tracks       Number of tracks per measurement (default: 1000)
+ *    -r, --repetitions  Number of repetitions of the measurement, the fastest one is taken (default: 3)
+ *    -s, --seed         Seed of the random number generator (default: 42)
+ *    --eta              Maximal |eta| of the tracks (default: 1)
+ *    --radius           Radius at which the tracks are stopped (default: 2750 mm, outer radius of the ECal barrel)
+ */
+
+namespace {
+/// Result of one measurement
+struct Result {
+  /// Time per step (in ns)
+  double timePerStep = std::numeric_limits<double>::max();
+  /// Number of steps per track
+  double stepsPerTrack = 0;
+};
+
+/** Transport the tracks through the geometry.
+ *  @param[in] aNavigator Navigator of the geometry.
+ *  @param[in] aDirections Directions of the tracks.
+ *  @param[in] aMaxRadius Radius at which the tracks are stopped.
+ *  return Number of the steps.
+ */
+uint64_t transport(G4Navigator& aNavigator, const std::vector<G4ThreeVector>& aDirections, double aMaxRadius) {
+  uint64_t steps = 0;
+  for (const auto& direction : aDirections) {
+    G4ThreeVector position(0, 0, 0);
+    aNavigator.LocateGlobalPointAndSetup(position, &direction, false, false);
+    while (true) {
+      double safety = 0;
+      double step = aNavigator.ComputeStep(position, direction, kInfinity, safety);
+      if (step == kInfinity) {
+        break;
+      }
+      position += step * direction;
+      aNavigator.SetGeometricallyLimitedStep();
+      G4VPhysicalVolume* volume = aNavigator.LocateGlobalPointAndSetup(position, &direction, true);
+      ++steps;
+      if (volume == nullptr || position.perp() > aMaxRadius) {
+        break;
+      }
+    }
+  }
+  return steps;
+}
+
+void printUsage(const char* aName) {
+  std::cout << "Usage: " << aName
+            << " [-n <tracks>] [-r <repetitions>] [-s <seed>] [--eta <max eta>] [--radius <max radius in mm>]"
+            << " <compact files>" << std::endl;
+}
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t numTracks = 1000;
+  unsigned numRepetitions = 3;
+  unsigned seed = 42;
+  double maxEta = 1;
+  double maxRadius = 2750 * CLHEP::mm;
+  std::vector<std::string> compactFiles;
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    std::string arg = argv[iArg];
+    bool hasValue = iArg + 1 < argc;
+    if ((arg == "-n" || arg == "--tracks") && hasValue) {
+      numTracks = std::stoul(argv[++iArg]);
+    } else if ((arg == "-r" || arg == "--repetitions") && hasValue) {
+      numRepetitions = std::stoul(argv[++iArg]);
+    } else if ((arg == "-s" || arg == "--seed") && hasValue) {
+      seed = std::stoul(argv[++iArg]);
+    } else if (arg == "--eta" && hasValue) {
+      maxEta = std::stod(argv[++iArg]);
+    } else if (arg == "--radius" && hasValue) {
+      maxRadius = std::stod(argv[++iArg]) * CLHEP::mm;
+    } else if (arg.empty() || arg[0] == '-') {
+      printUsage(argv[0]);
+      return arg == "-h" || arg == "--help" ? 0 : 2;
+    } else {
+      compactFiles.push_back(arg);
+    }
+  }
+  if (numTracks == 0 || numRepetitions == 0 || compactFiles.empty()) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  // geometry converted to Geant4 as in GeoConstruction::Construct
+  dd4hep::Detector& description = dd4hep::Detector::getInstance();
+  for (const auto& compactFile : compactFiles) {
+    description.fromCompact(compactFile);
+  }
+  dd4hep::sim::Geant4Converter converter(description, dd4hep::WARNING);
+  dd4hep::sim::Geant4GeometryInfo* geometryInfo = converter.create(description.world()).detach();
+  dd4hep::sim::Geant4Mapping::instance().attach(geometryInfo);
+  G4VPhysicalVolume* world = geometryInfo->world();
+  // optimise the geometry (smart voxels), as done by the run manager
+  G4GeometryManager::GetInstance()->CloseGeometry(true);
+  G4Navigator navigator;
+  navigator.SetWorldVolume(world);
+
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<double> eta(-maxEta, maxEta);
+  std::uniform_real_distribution<double> phi(-M_PI, M_PI);
+  std::vector<G4ThreeVector> directions;
+  directions.reserve(numTracks);
+  for (std::size_t iTrack = 0; iTrack < numTracks; ++iTrack) {
+    G4ThreeVector direction;
+    direction.setRThetaPhi(1, 2. * std::atan(std::exp(-eta(generator))), phi(generator));
+    directions.push_back(direction);
+  }
+
+  Result result;
+  for (unsigned iRep = 0; iRep < numRepetitions; ++iRep) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t steps = transport(navigator, directions, maxRadius);
+    auto stop = std::chrono::steady_clock::now();
+    double time = std::chrono::duration<double, std::nano>(stop - start).count() / std::max<uint64_t>(steps, 1);
+    if (time < result.timePerStep) {
+      result.timePerStep = time;
+      result.stepsPerTrack = static_cast<double>(steps) / numTracks;
+    }
+  }
+  G4GeometryManager::GetInstance()->OpenGeometry();
+
+  std::cout << "ECal barrel navigation benchmark: " << numTracks << " tracks in |eta| < " << maxEta << " up to r = "
+            << maxRadius / CLHEP::mm << " mm, best of " << numRepetitions << " repetitions" << std::endl;
+  for (const auto& compactFile : compactFiles) {
+    std::cout << "  " << compactFile << std::endl;
+  }
+  std::cout << std::right << std::setw(14) << "ns/step" << std::setw(14) << "steps/track" << std::setw(14)
+            << "us/track" << std::endl;
+  std::cout << std::fixed << std::setprecision(2) << std::setw(14) << result.timePerStep << std::setw(14)
+            << result.stepsPerTrack << std::setw(14) << result.timePerStep * result.stepsPerTrack / 1000.
+            << std::endl;
+  return 0;
+}
@@ -1,6 +1,11 @@
 #include "DD4hep/DetFactoryHelper.h"
 #include "DD4hep/Handle.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 // todo: remove gaudi logging and properly capture output
 #define endmsg std::endl
 #define lLog std::cout
@@ -11,6 +16,260 @@ const std::string INFO  = " Info: ";
 }
 
 namespace det {
+/// Point of a cross-section of the active volume: (x, z) in the frame of the active volume (extruded along y)
+typedef std::array<double, 2> Point2D;
+/// Polygon in the plane of the cross-section
+typedef std::vector<Point2D> Polygon2D;
+
+static double cross(const Point2D& aA, const Point2D& aB) { return aA[0] * aB[1] - aA[1] * aB[0]; }
+
+/** Signed area of a polygon.
+ *  return Area, positive if the vertices are counter-clockwise.
+ */
+static double polygonArea(const Polygon2D& aPolygon) {
+  double area = 0;
+  for (size_t i = 0; i < aPolygon.size(); i++) {
+    area += cross(aPolygon[i], aPolygon[(i + 1) % aPolygon.size()]);
+  }
+  return area / 2.;
+}
+
+/** Clip a polygon by a line (Sutherland-Hodgman), keeping the points with aNormal * point <= aOffset.
+ *  The clipped polygon may have degenerate edges if the polygon is not convex, its area is correct.
+ *  return Clipped polygon.
+ */
+static Polygon2D clipPolygon(const Polygon2D& aPolygon, const Point2D& aNormal, double aOffset) {
+  Polygon2D clipped;
+  for (size_t i = 0; i < aPolygon.size(); i++) {
+    const Point2D& a = aPolygon[i];
+    const Point2D& b = aPolygon[(i + 1) % aPolygon.size()];
+    double distA = aNormal[0] * a[0] + aNormal[1] * a[1] - aOffset;
+    double distB = aNormal[0] * b[0] + aNormal[1] * b[1] - aOffset;
+    if (distA <= 0) {
+      clipped.push_back(a);
+    }
+    if ((distA < 0 && distB > 0) || (distA > 0 && distB < 0)) {
+      double t = distA / (distA - distB);
+      clipped.push_back({a[0] + t * (b[0] - a[0]), a[1] + t * (b[1] - a[1])});
+    }
+  }
+  return clipped;
+}
+
+/** Area of the intersection of a polygon with a convex polygon (counter-clockwise).
+ *  return Area of the intersection.
+ */
+static double intersectionArea(const Polygon2D& aPolygon, const Polygon2D& aConvex) {
+  Polygon2D clipped = aPolygon;
+  for (size_t j = 0; j < aConvex.size() && !clipped.empty(); j++) {
+    const Point2D& c = aConvex[j];
+    const Point2D& e = aConvex[(j + 1) % aConvex.size()];
+    // inside on the left of the edge
+    clipped = clipPolygon(clipped, {e[1] - c[1], c[0] - e[0]}, (e[1] - c[1]) * c[0] - (e[0] - c[0]) * c[1]);
+  }
+  return clipped.size() < 3 ? 0 : polygonArea(clipped);
+}
+
+/** Check if a point is inside a polygon (crossing number).
+ *  return True if the point is inside.
+ */
+static bool insidePolygon(const Polygon2D& aPolygon, const Point2D& aPoint) {
+  bool inside = false;
+  for (size_t i = 0, j = aPolygon.size() - 1; i < aPolygon.size(); j = i++) {
+    const Point2D& a = aPolygon[i];
+    const Point2D& b = aPolygon[j];
+    if ((a[1] > aPoint[1]) != (b[1] > aPoint[1]) &&
+        aPoint[0] < (b[0] - a[0]) * (aPoint[1] - a[1]) / (b[1] - a[1]) + a[0]) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+/** Subtract a convex polygon from a polygon (Weiler-Atherton), both with counter-clockwise vertices.
+ *  The boundary of the polygon is followed outside of the convex polygon, and the boundary of the convex polygon
+ *  backwards inside of the polygon.
+ *  @param[in] aPolygon Polygon from which the convex polygon is subtracted.
+ *  @param[in] aConvex Convex polygon.
+ *  @param[out] aResult Polygons of the difference (counter-clockwise), empty if nothing is left.
+ *  return False if the difference is not a set of simple polygons (hole) or the boundaries touch.
+ */
+static bool subtractConvexPolygon(const Polygon2D& aPolygon, const Polygon2D& aConvex,
+                                  std::vector<Polygon2D>& aResult) {
+  aResult.clear();
+  // crossing of the boundaries: edges and positions along them, and if the polygon enters the convex polygon
+  struct Crossing {
+    size_t edge;
+    double t;
+    size_t convexEdge;
+    double u;
+    Point2D point;
+    bool entering;
+  };
+  const double epsilon = 1e-9;
+  std::vector<Crossing> crossings;
+  for (size_t i = 0; i < aPolygon.size(); i++) {
+    const Point2D& a = aPolygon[i];
+    const Point2D& b = aPolygon[(i + 1) % aPolygon.size()];
+    Point2D d = {b[0] - a[0], b[1] - a[1]};
+    for (size_t j = 0; j < aConvex.size(); j++) {
+      const Point2D& c = aConvex[j];
+      const Point2D& e = aConvex[(j + 1) % aConvex.size()];
+      Point2D f = {e[0] - c[0], e[1] - c[1]};
+      double denominator = cross(d, f);
+      if (std::fabs(denominator) < epsilon * std::hypot(d[0], d[1]) * std::hypot(f[0], f[1])) {
+        continue;
+      }
+      Point2D ac = {c[0] - a[0], c[1] - a[1]};
+      double t = cross(ac, f) / denominator;
+      double u = cross(ac, d) / denominator;
+      if (t > epsilon && t < 1 - epsilon && u > epsilon && u < 1 - epsilon) {
+        crossings.push_back({i, t, j, u, {a[0] + t * d[0], a[1] + t * d[1]}, denominator < 0});
+      } else if (t > -epsilon && t < 1 + epsilon && u > -epsilon && u < 1 + epsilon) {
+        return false;
+      }
+    }
+  }
+  if (crossings.empty()) {
+    if (insidePolygon(aConvex, aPolygon[0])) {
+      return true;
+    }
+    if (insidePolygon(aPolygon, aConvex[0])) {
+      return false;
+    }
+    aResult.push_back(aPolygon);
+    return true;
+  }
+  // boundaries with the crossings: index of the vertex, or of the crossing (offset by the number of vertices)
+  auto boundary = [&crossings](size_t aNumVertices, bool aConvexBoundary) {
+    std::vector<size_t> sequence;
+    for (size_t i = 0; i < aNumVertices; i++) {
+      sequence.push_back(i);
+      std::vector<size_t> onEdge;
+      for (size_t k = 0; k < crossings.size(); k++) {
+        if ((aConvexBoundary ? crossings[k].convexEdge : crossings[k].edge) == i) {
+          onEdge.push_back(k);
+        }
+      }
+      std::sort(onEdge.begin(), onEdge.end(), [&crossings, aConvexBoundary](size_t aK1, size_t aK2) {
+        return aConvexBoundary ? crossings[aK1].u < crossings[aK2].u : crossings[aK1].t < crossings[aK2].t;
+      });
+      for (auto k : onEdge) {
+        sequence.push_back(aNumVertices + k);
+      }
+    }
+    return sequence;
+  };
+  const std::vector<size_t> polygonBoundary = boundary(aPolygon.size(), false);
+  const std::vector<size_t> convexBoundary = boundary(aConvex.size(), true);
+  std::vector<size_t> polygonPosition(crossings.size()), convexPosition(crossings.size());
+  for (size_t n = 0; n < polygonBoundary.size(); n++) {
+    if (polygonBoundary[n] >= aPolygon.size()) {
+      polygonPosition[polygonBoundary[n] - aPolygon.size()] = n;
+    }
+  }
+  for (size_t n = 0; n < convexBoundary.size(); n++) {
+    if (convexBoundary[n] >= aConvex.size()) {
+      convexPosition[convexBoundary[n] - aConvex.size()] = n;
+    }
+  }
+  std::vector<bool> used(crossings.size(), false);
+  for (size_t start = 0; start < crossings.size(); start++) {
+    if (crossings[start].entering || used[start]) {
+      continue;
+    }
+    Polygon2D loop;
+    size_t k = start;
+    do {
+      if (used[k] || crossings[k].entering || loop.size() > polygonBoundary.size() + convexBoundary.size()) {
+        return false;
+      }
+      used[k] = true;
+      loop.push_back(crossings[k].point);
+      // along the polygon, outside of the convex polygon
+      size_t n = polygonPosition[k];
+      for (n = (n + 1) % polygonBoundary.size(); polygonBoundary[n] < aPolygon.size();
+           n = (n + 1) % polygonBoundary.size()) {
+        loop.push_back(aPolygon[polygonBoundary[n]]);
+      }
+      size_t m = polygonBoundary[n] - aPolygon.size();
+      if (!crossings[m].entering) {
+        return false;
+      }
+      used[m] = true;
+      loop.push_back(crossings[m].point);
+      // backwards along the convex polygon, inside of the polygon
+      n = convexPosition[m];
+      for (n = (n + convexBoundary.size() - 1) % convexBoundary.size(); convexBoundary[n] < aConvex.size();
+           n = (n + convexBoundary.size() - 1) % convexBoundary.size()) {
+        loop.push_back(aConvex[convexBoundary[n]]);
+      }
+      k = convexBoundary[n] - aConvex.size();
+    } while (k != start);
+    aResult.push_back(loop);
+  }
+  return true;
+}
+
+/** Polygon of a box rotated around y (as dd4hep::RotationY) and shifted, in the plane of the cross-section.
+ *  return Counter-clockwise polygon.
+ */
+static Polygon2D boxPolygon(double aHalfX, double aHalfZ, double aAngle, const Point2D& aShift) {
+  Polygon2D polygon;
+  for (const auto& corner : {Point2D{-aHalfX, -aHalfZ}, Point2D{aHalfX, -aHalfZ}, Point2D{aHalfX, aHalfZ},
+                             Point2D{-aHalfX, aHalfZ}}) {
+    polygon.push_back({corner[0] * cos(aAngle) + corner[1] * sin(aAngle) + aShift[0],
+                       -corner[0] * sin(aAngle) + corner[1] * cos(aAngle) + aShift[1]});
+  }
+  return polygon;
+}
+
+/** Cross-section of the active material on one side of the readout: trapezoid without the readout and the passive
+ *  planes (the same volume as the boolean solids).
+ *  @param[in] aHalfWidthBottom Half width of the trapezoid at the bottom (x at z = aBottom).
+ *  @param[in] aHalfWidthTop Half width of the trapezoid at the top (x at z = aTop).
+ *  @param[in] aBottom Bottom of the trapezoid (z).
+ *  @param[in] aTop Top of the trapezoid (z).
+ *  @param[in] aSide Side of the readout: 1 for x > 0, -1 for x < 0.
+ *  @param[in] aReadoutThickness Thickness of the readout plane (centred at x = 0).
+ *  @param[in] aPassives Polygons of the passive planes.
+ *  return Counter-clockwise polygon, empty if the cross-section is not one simple polygon.
+ */
+static Polygon2D activeCrossSection(double aHalfWidthBottom, double aHalfWidthTop, double aBottom, double aTop,
+                                    int aSide, double aReadoutThickness, const std::vector<Polygon2D>& aPassives) {
+  Polygon2D trapezoid = {{-aHalfWidthBottom, aBottom},
+                         {aHalfWidthBottom, aBottom},
+                         {aHalfWidthTop, aTop},
+                         {-aHalfWidthTop, aTop}};
+  Polygon2D section = clipPolygon(trapezoid, {-1. * aSide, 0}, -aReadoutThickness / 2.);
+  for (const auto& passive : aPassives) {
+    std::vector<Polygon2D> parts;
+    double expectedArea = polygonArea(section) - intersectionArea(section, passive);
+    if (!subtractConvexPolygon(section, passive, parts) || parts.size() != 1 ||
+        std::fabs(polygonArea(parts[0]) - expectedArea) > 1e-9 * std::fabs(polygonArea(trapezoid))) {
+      return {};
+    }
+    section = parts[0];
+  }
+  return section;
+}
+
+/** Solid of a cross-section extruded along its z axis (the y axis of the active volume, rotated with
+ *  dd4hep::RotationX(M_PI / 2.)).
+ *  @param[in] aSection Counter-clockwise polygon of the cross-section.
+ *  @param[in] aHalfLength Half length of the extrusion.
+ *  return Extruded polygon.
+ */
+static dd4hep::ExtrudedPolygon extrudedCrossSection(const Polygon2D& aSection, double aHalfLength) {
+  std::vector<double> x, y;
+  // TGeoXtru expects clockwise vertices
+  for (auto vertex = aSection.rbegin(); vertex != aSection.rend(); ++vertex) {
+    x.push_back((*vertex)[0]);
+    y.push_back((*vertex)[1]);
+  }
+  return dd4hep::ExtrudedPolygon(x, y, {-aHalfLength, aHalfLength}, {0, 0}, {0, 0}, {1, 1});
+}
+
 static dd4hep::detail::Ref_t createECalBarrelInclined(dd4hep::Detector& aLcdd,
                                                         dd4hep::xml::Handle_t aXmlElement,
                                                         dd4hep::SensitiveDetector aSensDet) {
@@ -366,13 +625,6 @@ static dd4hep::detail::Ref_t createECalBarrelInclined(dd4hep::Detector& aLcdd,
        << "active passive initial overlap (before subtraction) (cm) = " << passiveThickness * activePassiveOverlap
        << " = " << activePassiveOverlap * 100 << " %" << endmsg;
 
-  // creating shape for rows of layers (active material between two passive planes, with readout in the middle)
-  // first define area between two passive planes, area can reach up to the symmetry axis of passive plane
-  dd4hep::Trapezoid activeOuterShape(activeInThickness, activeOutThickness, caloDim.dz(), caloDim.dz(),
-                                               planeLength / 2.);
-  // subtract readout shape from the middle
-  dd4hep::SubtractionSolid activeShapeNoReadout(activeOuterShape, readoutShape);
-
   // make calculation for active plane that is inclined with 0 deg (= offset + angle)
   double Cx = Rmin * cos(-angle) + planeLength / 2.;
   double Cy = Rmin * sin(-angle);
@@ -392,20 +644,7 @@ static dd4hep::detail::Ref_t createECalBarrelInclined(dd4hep::Detector& aLcdd,
   zprimB = CBx;
   xprimB = CBy;
 
-  // subtract passive volume above
-  dd4hep::SubtractionSolid activeShapeNoPassiveAbove(
-      activeShapeNoReadout, passiveShape,
-      dd4hep::Transform3D(dd4hep::RotationY(-dPhi / 2.),
-                                    dd4hep::Position(-fabs(xprim), 0, fabs(zprim))));
-  // subtract passive volume below
-  dd4hep::SubtractionSolid activeShape(
-      activeShapeNoPassiveAbove, passiveShape,
-      dd4hep::Transform3D(dd4hep::RotationY(dPhi / 2.),
-                                    dd4hep::Position(fabs(xprimB), 0, -fabs(zprimB))));
-  dd4hep::Volume activeVol("active", activeShape, aLcdd.material("Air"));
-
-  std::vector<dd4hep::PlacedVolume> layerPhysVols;
-  // place layers within active volume
+  // thickness of layers at inner and outer edge
   std::vector<double> layerInThickness;
   std::vector<double> layerOutThickness;
   double layerIncreasePerUnitThickness = (activeOutThickness - activeInThickness) / layersTotalHeight;
@@ -417,26 +656,105 @@ static dd4hep::detail::Ref_t createECalBarrelInclined(dd4hep::Detector& aLcdd,
     }
     layerOutThickness.push_back(layerInThickness[iLay] + layerIncreasePerUnitThickness * layerHeight[iLay]);
   }
-  double layerOffset = layerFirstOffset;
-  for (uint iLayer = 0; iLayer < numLayers; iLayer++) {
-    dd4hep::Trapezoid layerOuterShape(layerInThickness[iLayer], layerOutThickness[iLayer], caloDim.dz(),
-                                                caloDim.dz(), layerHeight[iLayer] / 2.);
-    dd4hep::SubtractionSolid layerShapeNoReadout(layerOuterShape, readoutShape);
-    dd4hep::SubtractionSolid layerShapeNoPassiveAbove(
-        layerShapeNoReadout, passiveShape,
-        dd4hep::Transform3D(dd4hep::RotationY(-dPhi / 2.),
-                                      dd4hep::Position(-fabs(xprim), 0, fabs(zprim) - layerOffset)));
+
+  // Native shapes (constant <detector>_nativeShapes not 0): the boolean solids of the active volume and of the layers
+  // (trapezoid minus readout minus passive planes) are slow in the navigation. Instead, the cross-sections on both
+  // sides of the readout are calculated analytically and extruded (G4ExtrudedSolid in Geant4), the volume is the
+  // same. The two sides are separate volumes, distinguished by the subtype (0: side of the passive plane below,
+  // 1: side of the passive plane above), and the rotation of the extruded polygons is added to their placement.
+  // Hence the cell IDs of the active cells on the side above differ from the boolean solids (subtype 0) by the subtype;
+  // the same volume ID for both sides is not possible (unique in the volume manager). Removing the subtype from the
+  // hits (RewriteBitfield to the readout ECalBarrelEtaNoSubtype) gives the same cells for both geometries.
+  bool nativeShapes = aLcdd.constants().find(nameDet + "_nativeShapes") != aLcdd.constants().end() &&
+                      aLcdd.constant<int>(nameDet + "_nativeShapes") != 0;
+  std::vector<Polygon2D> activeSections;
+  std::vector<std::vector<Polygon2D>> layerSections;
+  if (nativeShapes) {
+    const std::vector<Polygon2D> passivePolygons = {
+        boxPolygon(passiveThickness / 2., planeLength / 2., -dPhi / 2., {-fabs(xprim), fabs(zprim)}),
+        boxPolygon(passiveThickness / 2., planeLength / 2., dPhi / 2., {fabs(xprimB), -fabs(zprimB)})};
+    for (int side : {1, -1}) {
+      activeSections.push_back(activeCrossSection(activeInThickness, activeOutThickness, -planeLength / 2.,
+                                                  planeLength / 2., side, readoutThickness, passivePolygons));
+      nativeShapes &= !activeSections.back().empty();
+      layerSections.emplace_back();
+      double layerOffset = layerFirstOffset;
+      for (uint iLayer = 0; iLayer < numLayers; iLayer++) {
+        layerSections.back().push_back(activeCrossSection(
+            layerInThickness[iLayer], layerOutThickness[iLayer], layerOffset - layerHeight[iLayer] / 2.,
+            layerOffset + layerHeight[iLayer] / 2., side, readoutThickness, passivePolygons));
+        nativeShapes &= !layerSections.back().back().empty();
+        if (iLayer != numLayers - 1) {
+          layerOffset += layerHeight[iLayer] / 2. + layerHeight[iLayer + 1] / 2.;
+        }
+      }
+    }
+    if (nativeShapes) {
+      lLog << MSG::INFO << "active volume and layers built as extruded polygons (native shapes)" << endmsg;
+    } else {
+      lLog << MSG::ERROR << "Cross-sections of the active layers cannot be calculated, boolean solids are used"
+           << endmsg;
+    }
+  }
+
+  // active volumes (one with boolean solids, one per side of the readout with native shapes) and placed layers
+  std::vector<dd4hep::Volume> activeVols;
+  std::vector<std::vector<dd4hep::PlacedVolume>> layerPhysVols;
+  if (nativeShapes) {
+    for (uint iSide = 0; iSide < activeSections.size(); iSide++) {
+      activeVols.push_back(dd4hep::Volume("active", extrudedCrossSection(activeSections[iSide], caloDim.dz()),
+                                          aLcdd.material("Air")));
+      layerPhysVols.emplace_back();
+      for (uint iLayer = 0; iLayer < numLayers; iLayer++) {
+        // cross-sections of the layers are in the frame of the active volume
+        dd4hep::Volume layerVol("layer", extrudedCrossSection(layerSections[iSide][iLayer], caloDim.dz()),
+                                aLcdd.material(activeMaterial));
+        layerVol.setSensitiveDetector(aSensDet);
+        layerPhysVols.back().push_back(activeVols.back().placeVolume(layerVol));
+        layerPhysVols.back().back().addPhysVolID("layer", iLayer);
+      }
+    }
+  } else {
+    // creating shape for rows of layers (active material between two passive planes, with readout in the middle)
+    // first define area between two passive planes, area can reach up to the symmetry axis of passive plane
+    dd4hep::Trapezoid activeOuterShape(activeInThickness, activeOutThickness, caloDim.dz(), caloDim.dz(),
+                                       planeLength / 2.);
+    // subtract readout shape from the middle
+    dd4hep::SubtractionSolid activeShapeNoReadout(activeOuterShape, readoutShape);
+
+    // subtract passive volume above
+    dd4hep::SubtractionSolid activeShapeNoPassiveAbove(
+        activeShapeNoReadout, passiveShape,
+        dd4hep::Transform3D(dd4hep::RotationY(-dPhi / 2.), dd4hep::Position(-fabs(xprim), 0, fabs(zprim))));
     // subtract passive volume below
-    dd4hep::SubtractionSolid layerShape(
-        layerShapeNoPassiveAbove, passiveShape,
-        dd4hep::Transform3D(dd4hep::RotationY(dPhi / 2.),
-                                      dd4hep::Position(fabs(xprimB), 0, -fabs(zprimB) - layerOffset)));
-    dd4hep::Volume layerVol("layer", layerShape, aLcdd.material(activeMaterial));
-    layerVol.setSensitiveDetector(aSensDet);
-    layerPhysVols.push_back(activeVol.placeVolume(layerVol, dd4hep::Position(0, 0, layerOffset)));
-    layerPhysVols.back().addPhysVolID("layer", iLayer);
-    if (iLayer != numLayers - 1) {
-      layerOffset += layerHeight[iLayer] / 2. + layerHeight[iLayer + 1] / 2.;
+    dd4hep::SubtractionSolid activeShape(
+        activeShapeNoPassiveAbove, passiveShape,
+        dd4hep::Transform3D(dd4hep::RotationY(dPhi / 2.), dd4hep::Position(fabs(xprimB), 0, -fabs(zprimB))));
+    activeVols.push_back(dd4hep::Volume("active", activeShape, aLcdd.material("Air")));
+
+    // place layers within active volume
+    layerPhysVols.emplace_back();
+    double layerOffset = layerFirstOffset;
+    for (uint iLayer = 0; iLayer < numLayers; iLayer++) {
+      dd4hep::Trapezoid layerOuterShape(layerInThickness[iLayer], layerOutThickness[iLayer], caloDim.dz(),
+                                        caloDim.dz(), layerHeight[iLayer] / 2.);
+      dd4hep::SubtractionSolid layerShapeNoReadout(layerOuterShape, readoutShape);
+      dd4hep::SubtractionSolid layerShapeNoPassiveAbove(
+          layerShapeNoReadout, passiveShape,
+          dd4hep::Transform3D(dd4hep::RotationY(-dPhi / 2.),
+                              dd4hep::Position(-fabs(xprim), 0, fabs(zprim) - layerOffset)));
+      // subtract passive volume below
+      dd4hep::SubtractionSolid layerShape(
+          layerShapeNoPassiveAbove, passiveShape,
+          dd4hep::Transform3D(dd4hep::RotationY(dPhi / 2.),
+                              dd4hep::Position(fabs(xprimB), 0, -fabs(zprimB) - layerOffset)));
+      dd4hep::Volume layerVol("layer", layerShape, aLcdd.material(activeMaterial));
+      layerVol.setSensitiveDetector(aSensDet);
+      layerPhysVols.back().push_back(activeVols.back().placeVolume(layerVol, dd4hep::Position(0, 0, layerOffset)));
+      layerPhysVols.back().back().addPhysVolID("layer", iLayer);
+      if (iLayer != numLayers - 1) {
+        layerOffset += layerHeight[iLayer] / 2. + layerHeight[iLayer + 1] / 2.;
+      }
     }
   }
 
@@ -495,20 +813,35 @@ static dd4hep::detail::Ref_t createECalBarrelInclined(dd4hep::Detector& aLcdd,
     // ACTIVE
     dd4hep::Rotation3D rotationActive(dd4hep::RotationX(-M_PI / 2) *
                                                 dd4hep::RotationY(M_PI / 2 - phiRead - angle));
-    activePhysVols.push_back(bathVol.placeVolume(
-        activeVol,
-        dd4hep::Transform3D(rotationActive, dd4hep::Position(xRotatedRead, yRotatedRead, 0))));
-    activePhysVols.back().addPhysVolID("module", iPlane);
-    activePhysVols.back().addPhysVolID("type", 0);  // 0 = active, 1 = passive, 2 = readout
+    if (nativeShapes) {
+      // to get the cross-section of the extruded polygons in the xz plane of the active volume
+      rotationActive = rotationActive * dd4hep::RotationX(M_PI / 2.);
+    }
+    for (uint iActive = 0; iActive < activeVols.size(); iActive++) {
+      activePhysVols.push_back(bathVol.placeVolume(
+          activeVols[iActive],
+          dd4hep::Transform3D(rotationActive, dd4hep::Position(xRotatedRead, yRotatedRead, 0))));
+      activePhysVols.back().addPhysVolID("module", iPlane);
+      activePhysVols.back().addPhysVolID("type", 0);  // 0 = active, 1 = passive, 2 = readout
+      if (nativeShapes) {
+        activePhysVols.back().addPhysVolID("subtype", iActive);
+      }
+    }
   }
   dd4hep::PlacedVolume bathPhysVol = envelopeVol.placeVolume(bathVol);
   bathDetElem.setPlacement(bathPhysVol);
   for (uint iPlane = 0; iPlane < numPlanes; iPlane++) {
-    dd4hep::DetElement activeDetElem(bathDetElem, "active" + std::to_string(iPlane), iPlane);
-    activeDetElem.setPlacement(activePhysVols[iPlane]);
-    for (uint iLayer = 0; iLayer < numLayers; iLayer++) {
-      dd4hep::DetElement layerDetElem(activeDetElem, "layer" + std::to_string(iLayer), iLayer);
-      layerDetElem.setPlacement(layerPhysVols[iLayer]);
+    for (uint iActive = 0; iActive < activeVols.size(); iActive++) {
+      std::string activeName = "active" + std::to_string(iPlane);
+      if (nativeShapes) {
+        activeName += "_" + std::to_string(iActive);
+      }
+      dd4hep::DetElement activeDetElem(bathDetElem, activeName, iPlane);
+      activeDetElem.setPlacement(activePhysVols[iPlane * activeVols.size() + iActive]);
+      for (uint iLayer = 0; iLayer < numLayers; iLayer++) {
+        dd4hep::DetElement layerDetElem(activeDetElem, "layer" + std::to_string(iLayer), iLayer);
+        layerDetElem.setPlacement(layerPhysVols[iActive][iLayer]);
+      }
     }
   }
 
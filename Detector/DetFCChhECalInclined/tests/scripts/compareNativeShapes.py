@@ -0,0 +1,159 @@
+"""Compare the ECal barrel built with boolean solids and with native shapes (ECalBarrel_nativeShapes).
+
+The same random points in the calorimeter (between EMBarrel_rmin and EMBarrel_rmax) are located in both geometries,
+each one loaded in its own process (one DD4hep description per process). The material and the volume (and the number
+of the layer) found for each point have to be the same, and so the volume of each material and the mass of the
+sampled calorimeter.
+The cell IDs of the points (readout of the detector) have to be the same too, except for the subtype of the active
+cells (type 0): with native shapes, the cells on the side of the passive plane above the readout have subtype 1.
+After the removal of the subtype (RewriteBitfield to the readout ECalBarrelEtaNoSubtype), the cell IDs have to be the
+same.
+"""
+import argparse
+import json
+import math
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+path_to_detector = os.environ.get("FCC_DETECTORS", "")
+master = os.path.join(path_to_detector, "Detector/DetFCChhBaseline1/compact/FCChh_DectEmptyMaster.xml")
+compact_dir = os.path.join(path_to_detector, "Detector/DetFCChhECalInclined/compact")
+boolean = os.path.join(compact_dir, "FCChh_ECalBarrel_withCryostat.xml")
+native = os.path.join(compact_dir, "FCChh_ECalBarrel_withCryostat_nativeShapes.xml")
+detector_name = "ECalBarrel"
+# readout of the hits after RewriteBitfield removing the subtype
+rewritten_readout_name = "ECalBarrelEtaNoSubtype"
+
+
+def volume_ids(navigator):
+    """Get the volume ID fields of the placements of the current path of the navigator (the deepest first)."""
+    import ROOT
+    fields = {}
+    for up in range(navigator.GetLevel() + 1):
+        try:
+            ids = ROOT.dd4hep.PlacedVolume(navigator.GetMother(up)).volIDs()
+        except Exception:
+            # not placed by DD4hep (no volume IDs)
+            continue
+        for name_value in ids:
+            fields.setdefault(name_value.first, name_value.second)
+    return fields
+
+
+def cell_id(readout, fields, position):
+    """Get the cell ID of the point in the volume with the given volume ID fields, without the subtype of the active
+    cells and without the fields that are not in the readout (as removed by RewriteBitfield).
+
+    Returns None if the point is not in the detector (no system ID).
+    """
+    import ROOT
+    if "system" not in fields:
+        return None
+    decoder = readout.idSpec().decoder()
+    volume_id = 0
+    for name, value in fields.items():
+        if name == "subtype" and fields.get("type") == 0:
+            continue
+        if name not in [decoder[i].name() for i in range(decoder.size())]:
+            continue
+        element = decoder[decoder.index(name)]
+        volume_id |= (value << element.offset()) & element.mask()
+    point = ROOT.dd4hep.Position(*position)
+    return int(readout.segmentation().cellID(point, point, volume_id))
+
+
+def sample(compact_files, num_points, seed, output):
+    """Locate the random points in the geometry and write the found volumes to the output file."""
+    import ROOT
+    ROOT.gSystem.Load("libDDCore")
+    description = ROOT.dd4hep.Detector.getInstance()
+    for compact in compact_files:
+        description.fromXML(compact)
+    manager = description.manager()
+    rmin = description.constantAsDouble("EMBarrel_rmin")
+    rmax = description.constantAsDouble("EMBarrel_rmax")
+    dz = description.constantAsDouble("EMBarrel_dz")
+    readout = description.sensitiveDetector(detector_name).readout()
+    rewritten_readout = description.readout(rewritten_readout_name)
+    generator = random.Random(seed)
+    points = []
+    for _ in range(num_points):
+        # uniform in the volume of the tube
+        r = math.sqrt(generator.uniform(rmin ** 2, rmax ** 2))
+        phi = generator.uniform(-math.pi, math.pi)
+        z = generator.uniform(-dz, dz)
+        position = (r * math.cos(phi), r * math.sin(phi), z)
+        node = manager.FindNode(*position)
+        volume = node.GetVolume()
+        material = volume.GetMaterial()
+        layer = node.GetNumber() if volume.GetName() == "layer" else -1
+        fields = volume_ids(manager.GetCurrentNavigator())
+        points.append([volume.GetName(), layer, material.GetName(), material.GetDensity(),
+                       cell_id(readout, fields, position), cell_id(rewritten_readout, fields, position)])
+    with open(output, "w") as result:
+        json.dump({"volume": math.pi * (rmax ** 2 - rmin ** 2) * 2 * dz, "points": points}, result)
+
+
+def run(compact_files, num_points, seed):
+    """Sample the geometry in a separate process."""
+    with tempfile.NamedTemporaryFile(suffix=".json") as output:
+        subprocess.check_call([sys.executable, __file__, "--sample", "--points", str(num_points), "--seed", str(seed),
+                               "--output", output.name] + compact_files)
+        with open(output.name) as result:
+            return json.load(result)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--points", type=int, default=200000, help="number of the random points")
+    parser.add_argument("--seed", type=int, default=42, help="seed of the random points")
+    parser.add_argument("--sample", action="store_true", help="only sample the geometry of the given compact files")
+    parser.add_argument("--output", help="output of the sampling")
+    parser.add_argument("compact", nargs="*", help="compact files of the sampled geometry")
+    args = parser.parse_args()
+    if args.sample:
+        sample(args.compact, args.points, args.seed, args.output)
+        sys.exit(0)
+
+    reference = run([master, boolean], args.points, args.seed)
+    tested = run([master, native], args.points, args.seed)
+    mismatches = 0
+    cell_mismatches = 0
+    rewritten_cell_mismatches = 0
+    volumes = {}
+    masses = [0., 0.]
+    for point_reference, point_tested in zip(reference["points"], tested["points"]):
+        if point_reference[:3] != point_tested[:3]:
+            mismatches += 1
+            if mismatches <= 10:
+                print("Point in %s (layer %d, %s) and in %s (layer %d, %s)" % tuple(point_reference[:3] +
+                                                                                 point_tested[:3]))
+        if point_reference[4] != point_tested[4]:
+            cell_mismatches += 1
+            if cell_mismatches <= 10:
+                print("Point in cell %s and in cell %s" % (point_reference[4], point_tested[4]))
+        if point_reference[5] != point_tested[5]:
+            rewritten_cell_mismatches += 1
+            if rewritten_cell_mismatches <= 10:
+                print("Point in cell %s and in cell %s of %s" % (point_reference[5], point_tested[5],
+                                                                 rewritten_readout_name))
+        for iGeo, point in enumerate([point_reference, point_tested]):
+            volumes.setdefault(point[2], [0, 0])[iGeo] += 1
+            masses[iGeo] += point[3]
+    pointVolume = reference["volume"] / args.points
+    for material, counts in sorted(volumes.items()):
+        print("%-16s volume (cm3): boolean %12.1f native %12.1f" % (material, counts[0] * pointVolume,
+                                                                     counts[1] * pointVolume))
+    print("Mass (kg): boolean %.3f native %.3f" % (masses[0] * pointVolume / 1000., masses[1] * pointVolume / 1000.))
+    print("Points in different volumes: %d of %d" % (mismatches, args.points))
+    print("Points in different cells (without the subtype of the active cells): %d of %d" % (cell_mismatches,
+                                                                                             args.points))
+    print("Points in different cells of %s: %d of %d" % (rewritten_readout_name, rewritten_cell_mismatches,
+                                                         args.points))
+    # only the points at the boundaries (rounding) can differ
+    if (mismatches > 1e-4 * args.points or cell_mismatches > 1e-4 * args.points or
+            rewritten_cell_mismatches > 1e-4 * args.points or abs(masses[0] - masses[1]) > 1e-4 * masses[0]):
+        sys.exit(1)
@@ -0,0 +1,526 @@
+// FCCSW
+#include "DetSegmentation/DriftChamberWireIndex.h"
+#include "DetSegmentation/FCCSWGridPhiEta.h"
+#include "DetSegmentation/FCCSWGridPhiEtaVarEta.h"
+#include "DetSegmentation/GridDriftChamber.h"
+#include "DetSegmentation/GridEta.h"
+#include "DetSegmentation/GridRPhiEta.h"
+
+// std
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/** SegmentationBenchmark Detector/DetSegmentation/bench/SegmentationBenchmark.cpp
+ *
+ *  Standalone benchmark of the segmentations of DetSegmentation.
+ *  Segmentations are created from the encoding strings and parameters of the FCC-hh ECal barrel and of the IDEA
+ *  drift chamber, without loading any geometry. Methods cellID(), position(), eta(), phi() and r() are called over
+ *  randomly generated points (fixed seed) and the time per call is reported (best of the repetitions).
+ *  For the batched methods (distancesTrackWire, cellIDs) the time is reported per point.
+ *  The drift chamber cellID is also validated against its reference implementation (cellIDReference) and the wire
+ *  positions against wirePos_vs_z, both without and with an offset in phi. The queries of DriftChamberWireIndex are
+ *  validated against the test of all the wires, the batched distances against distanceTrackWire and the batched
+ *  calorimeter cellIDs against cellID.
+ *  The calorimeter cellIDs with the binning lookup (prepareBinningLookup), of FCCSWGridPhiEtaVarEta (0.01 bins in
+ *  |eta| < 1, 0.02 above) and with the granularity of each layer (as the readout ECalBarrelPhiEtaLayers) are measured
+ *  here and validated by SegmentationLookupTest (tests/).
+ *  If a measurement exceeds its threshold or the validation fails, the executable returns 1.
+ *
+ *  Usage: SegmentationBenchmark [-n <points>] [-r <repetitions>] [-s <seed>] [-t <name>=<ns>] [--no-thresholds]
+ *    -n, --points       Number of generated points (default: 1000000)
+ *    -r, --repetitions  Number of repetitions of each measurement, the fastest one is taken (default: 5)
+ *    -s, --seed         Seed of the random number generator (default: 42)
+ *    -t, --threshold    Threshold for measurement <name> in ns per call (may be repeated)
+ *    --no-thresholds    Only report the measurements
+ */
+
+using dd4hep::DDSegmentation::CellID;
+using dd4hep::DDSegmentation::Vector3D;
+
+namespace {
+/// Definition of one measurement
+struct Measurement {
+  /// Name of the measurement (<segmentation>::<method>)
+  std::string name;
+  /// Call of the measured method for the point of given index, returns a value added to the checksum
+  std::function<double(std::size_t)> call;
+  /// Maximum allowed time per call (in ns)
+  double threshold = 0;
+  /// Number of calls, if not set one call per point
+  std::size_t numCalls = 0;
+  /// Number of points processed by one call (batched methods), the time is reported per point
+  std::size_t pointsPerCall = 1;
+};
+
+/// Default thresholds in ns per call. They are set well above the measured time to catch only significant regressions
+const std::map<std::string, double> kDefaultThresholds = {
+    {"GridEta::cellID", 300.},           {"GridEta::position", 300.},          {"GridEta::eta", 150.},
+    {"FCCSWGridPhiEta::cellID", 400.},   {"FCCSWGridPhiEta::position", 400.}, {"FCCSWGridPhiEta::phi", 150.},
+    {"GridRPhiEta::cellID", 500.},       {"GridRPhiEta::position", 500.},     {"GridRPhiEta::r", 150.},
+    {"GridDriftChamber::cellID", 400.},  {"GridDriftChamber::cellIDReference", 1000.},
+    {"GridDriftChamber::position", 150.},          {"DriftChamberWireIndex::withinDCA", 3000.},
+    {"DriftChamberWireIndex::kNearest", 6000.},   {"DriftChamberWireIndex::withinDCAAllWires", 2000000.},
+    {"GridDriftChamber::distanceTrackWire", 1000.}, {"GridDriftChamber::distancesTrackWire", 100.},
+    {"FCCSWGridPhiEta::cellIDs", 300.},            {"GridRPhiEta::cellIDs", 400.},
+    {"GridEta::cellIDLookup", 150.},               {"FCCSWGridPhiEta::cellIDLookup", 200.},
+    {"GridRPhiEta::cellIDLookup", 250.},           {"FCCSWGridPhiEtaVarEta::cellID", 400.},
+    {"FCCSWGridPhiEtaVarEta::cellIDLookup", 200.}, {"FCCSWGridPhiEta::cellIDLayersLookup", 300.}};
+
+/** Time the loop over all points, repeated aRepetitions times.
+ *  @param[in] aMeasurement Measured method.
+ *  @param[in] aPoints Number of points.
+ *  @param[in] aRepetitions Number of repetitions.
+ *  @param[out] aChecksum Sum of the values returned by the measured method (prevents the optimisation of the loop).
+ *  return Time per call (or per point for batched methods) of the fastest repetition (in ns).
+ */
+double timeLoop(const Measurement& aMeasurement, std::size_t aPoints, unsigned aRepetitions, double& aChecksum) {
+  double best = std::numeric_limits<double>::max();
+  for (unsigned iRep = 0; iRep < aRepetitions; ++iRep) {
+    double sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < aPoints; ++i) {
+      sum += aMeasurement.call(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    aChecksum += sum;
+    double time =
+        std::chrono::duration<double, std::nano>(stop - start).count() / (aPoints * aMeasurement.pointsPerCall);
+    if (time < best) {
+      best = time;
+    }
+  }
+  return best;
+}
+
+void printUsage(const char* aName) {
+  std::cout << "Usage: " << aName
+            << " [-n <points>] [-r <repetitions>] [-s <seed>] [-t <name>=<ns>] [--no-thresholds]" << std::endl;
+}
+}
+
+int main(int argc, char* argv[]) {
+  std::size_t numPoints = 1000000;
+  unsigned numRepetitions = 5;
+  unsigned seed = 42;
+  bool useThresholds = true;
+  std::map<std::string, double> thresholds = kDefaultThresholds;
+  for (int iArg = 1; iArg < argc; ++iArg) {
+    std::string arg = argv[iArg];
+    bool hasValue = iArg + 1 < argc;
+    if ((arg == "-n" || arg == "--points") && hasValue) {
+      numPoints = std::stoul(argv[++iArg]);
+    } else if ((arg == "-r" || arg == "--repetitions") && hasValue) {
+      numRepetitions = std::stoul(argv[++iArg]);
+    } else if ((arg == "-s" || arg == "--seed") && hasValue) {
+      seed = std::stoul(argv[++iArg]);
+    } else if ((arg == "-t" || arg == "--threshold") && hasValue) {
+      std::string threshold = argv[++iArg];
+      auto separator = threshold.find('=');
+      if (separator == std::string::npos || thresholds.find(threshold.substr(0, separator)) == thresholds.end()) {
+        std::cerr << "Unknown threshold: " << threshold << std::endl;
+        return 2;
+      }
+      thresholds[threshold.substr(0, separator)] = std::stod(threshold.substr(separator + 1));
+    } else if (arg == "--no-thresholds") {
+      useThresholds = false;
+    } else {
+      printUsage(argv[0]);
+      return arg == "-h" || arg == "--help" ? 0 : 2;
+    }
+  }
+  if (numPoints == 0 || numRepetitions == 0) {
+    printUsage(argv[0]);
+    return 2;
+  }
+
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+
+  // FCC-hh ECal barrel: eta-phi segmentations (calorimeter volume between R = 190 cm and R = 265 cm)
+  const std::string caloEncoding = "system:4,cryo:1,type:3,subtype:3,layer:8,eta:9,phi:10";
+  dd4hep::DDSegmentation::GridEta gridEta(caloEncoding);
+  gridEta.setGridSizeEta(0.01);
+  gridEta.setOffsetEta(-1.68024);
+  dd4hep::DDSegmentation::FCCSWGridPhiEta gridPhiEta(caloEncoding);
+  gridPhiEta.setGridSizeEta(0.01);
+  gridPhiEta.setOffsetEta(-1.68024);
+  gridPhiEta.setPhiBins(704);
+  gridPhiEta.setOffsetPhi(-M_PI + M_PI / 704.);
+  dd4hep::DDSegmentation::GridRPhiEta gridRPhiEta("system:4,cryo:1,type:3,subtype:3,r:8,eta:9,phi:10");
+  gridRPhiEta.setGridSizeEta(0.01);
+  gridRPhiEta.setOffsetEta(-1.68024);
+  gridRPhiEta.setPhiBins(704);
+  gridRPhiEta.setOffsetPhi(-M_PI + M_PI / 704.);
+  gridRPhiEta.setGridSizeR(5.);
+  gridRPhiEta.setOffsetR(190.);
+  // the same segmentations with the binning lookup
+  dd4hep::DDSegmentation::GridEta gridEtaLookup(caloEncoding);
+  gridEtaLookup.setGridSizeEta(0.01);
+  gridEtaLookup.setOffsetEta(-1.68024);
+  gridEtaLookup.prepareBinningLookup();
+  dd4hep::DDSegmentation::FCCSWGridPhiEta gridPhiEtaLookup(caloEncoding);
+  gridPhiEtaLookup.setGridSizeEta(0.01);
+  gridPhiEtaLookup.setOffsetEta(-1.68024);
+  gridPhiEtaLookup.setPhiBins(704);
+  gridPhiEtaLookup.setOffsetPhi(-M_PI + M_PI / 704.);
+  gridPhiEtaLookup.prepareBinningLookup();
+  dd4hep::DDSegmentation::GridRPhiEta gridRPhiEtaLookup("system:4,cryo:1,type:3,subtype:3,r:8,eta:9,phi:10");
+  gridRPhiEtaLookup.setGridSizeEta(0.01);
+  gridRPhiEtaLookup.setOffsetEta(-1.68024);
+  gridRPhiEtaLookup.setPhiBins(704);
+  gridRPhiEtaLookup.setOffsetPhi(-M_PI + M_PI / 704.);
+  gridRPhiEtaLookup.setGridSizeR(5.);
+  gridRPhiEtaLookup.setOffsetR(190.);
+  gridRPhiEtaLookup.prepareBinningLookup();
+  // variable eta bins: 0.01 in |eta| < 1, 0.02 up to |eta| = 1.68, with and without the lookup
+  std::vector<double> etaEdges;
+  for (int i = -84; i <= 84; ++i) {
+    etaEdges.push_back(i * 0.02);
+    if (std::abs(i) < 50) {
+      etaEdges.push_back(i * 0.02 + 0.01);
+    }
+  }
+  dd4hep::DDSegmentation::FCCSWGridPhiEtaVarEta gridVarEta(caloEncoding);
+  gridVarEta.setEtaEdges(etaEdges);
+  gridVarEta.setPhiBins(704);
+  gridVarEta.setOffsetPhi(-M_PI + M_PI / 704.);
+  dd4hep::DDSegmentation::FCCSWGridPhiEtaVarEta gridVarEtaLookup(caloEncoding);
+  gridVarEtaLookup.setEtaEdges(etaEdges);
+  gridVarEtaLookup.setPhiBins(704);
+  gridVarEtaLookup.setOffsetPhi(-M_PI + M_PI / 704.);
+  gridVarEtaLookup.prepareBinningLookup();
+  // granularity of each layer, as the readout ECalBarrelPhiEtaLayers: eta strips in the second layer, coarser phi in
+  // the last two layers
+  const std::string caloLayersEncoding = "system:4,cryo:1,type:3,subtype:3,layer:8,eta:11,phi:10";
+  const std::vector<double> layerGridSizeEta = {0.01, 0.0025, 0.01, 0.01, 0.01, 0.01, 0.01, 0.01};
+  const std::vector<double> layerOffsetEta = {-1.68024, -1.68399, -1.68024, -1.68024,
+                                              -1.68024, -1.68024, -1.68024, -1.68024};
+  const std::vector<int> layerPhiBins = {704, 704, 704, 704, 704, 704, 352, 352};
+  std::vector<double> layerOffsetPhi;
+  for (int bins : layerPhiBins) {
+    layerOffsetPhi.push_back(-M_PI + M_PI / bins);
+  }
+  dd4hep::DDSegmentation::FCCSWGridPhiEta gridPhiEtaLayersLookup(caloLayersEncoding);
+  gridPhiEtaLayersLookup.setGridSizeEta(0.01);
+  gridPhiEtaLayersLookup.setOffsetEta(-1.68024);
+  gridPhiEtaLayersLookup.setPhiBins(704);
+  gridPhiEtaLayersLookup.setOffsetPhi(-M_PI + M_PI / 704.);
+  gridPhiEtaLayersLookup.setGridSizeEtaLayers(layerGridSizeEta);
+  gridPhiEtaLayersLookup.setOffsetEtaLayers(layerOffsetEta);
+  gridPhiEtaLayersLookup.setPhiBinsLayers(layerPhiBins);
+  gridPhiEtaLayersLookup.setOffsetPhiLayers(layerOffsetPhi);
+  gridPhiEtaLayersLookup.prepareBinningLookup();
+
+  // IDEA drift chamber: 14 superlayers of 8 layers, parameters as in Detector/DetFCCeeIDEA/compact/DriftChamber.xml
+  const int numSuperLayers = 14;
+  const int numRings = 8;
+  const double r0 = 34.5;
+  const double cellSize = 1.2;
+  const double halfLength = 225.;
+  const double alpha = 30. / 180. * M_PI;
+  auto setUpDriftChamber = [&](dd4hep::DDSegmentation::GridDriftChamber& aSegmentation, double aOffsetPhi) {
+    aSegmentation.parameter("inner_radius")->setValue(std::to_string(r0));
+    aSegmentation.parameter("cell_size")->setValue(std::to_string(cellSize));
+    aSegmentation.parameter("detector_length")->setValue(std::to_string(2 * halfLength));
+    aSegmentation.parameter("offset_phi")->setValue(std::to_string(aOffsetPhi));
+    for (int superlayer = 0; superlayer < numSuperLayers; superlayer++) {
+      for (int iring = 0; iring < numRings; iring++) {
+        int layer = superlayer * numRings + iring;
+        int numWire = 192 + superlayer * 48;
+        double R_i0 = r0 + layer * cellSize;
+        double R_i = R_i0 / std::cos(alpha / 2.0);
+        double eps = (layer % 2 ? -1 : 1) * std::atan(2 * R_i0 * std::tan(alpha / 2.0) / (halfLength * 2.0));
+        aSegmentation.setGeomParams(layer, 2.0 * M_PI / double(numWire), R_i, eps);
+        aSegmentation.setWiresInLayer(layer, numWire);
+      }
+    }
+  };
+  dd4hep::DDSegmentation::GridDriftChamber gridDriftChamber("system:1,layer:16,phi:16");
+  setUpDriftChamber(gridDriftChamber, 0);
+  // same chamber with the wires rotated by an offset in phi (only validated), smaller than half of the smallest cell
+  // to keep the phi bins positive
+  dd4hep::DDSegmentation::GridDriftChamber gridDriftChamberOffset("system:1,layer:16,phi:16");
+  setUpDriftChamber(gridDriftChamberOffset, 0.002);
+
+  // Generate the points and the volume IDs
+  std::vector<Vector3D> caloPoints, dchPoints;
+  std::vector<CellID> caloVolumeIDs, dchVolumeIDs;
+  caloPoints.reserve(numPoints);
+  dchPoints.reserve(numPoints);
+  caloVolumeIDs.reserve(numPoints);
+  dchVolumeIDs.reserve(numPoints);
+  const auto& caloDecoder = *gridEta.decoder();
+  const auto& dchDecoder = *gridDriftChamber.decoder();
+  for (std::size_t i = 0; i < numPoints; ++i) {
+    double phi = (2 * uniform(generator) - 1) * M_PI;
+    double eta = (2 * uniform(generator) - 1) * 1.6;
+    double r = 190. + 75. * uniform(generator);
+    caloPoints.emplace_back(r * std::cos(phi), r * std::sin(phi), r * std::sinh(eta));
+    CellID volumeID = 0;
+    caloDecoder.set(volumeID, "system", 5);
+    caloDecoder.set(volumeID, "layer", static_cast<int>(8 * uniform(generator)));
+    caloVolumeIDs.push_back(volumeID);
+
+    int layer = static_cast<int>(numSuperLayers * numRings * uniform(generator));
+    double rWire = r0 + (layer + uniform(generator) - 0.5) * cellSize;
+    double z = (2 * uniform(generator) - 1) * halfLength;
+    dchPoints.emplace_back(rWire * std::cos(phi), rWire * std::sin(phi), z);
+    volumeID = 0;
+    dchDecoder.set(volumeID, "system", 1);
+    dchDecoder.set(volumeID, "layer", layer);
+    dchVolumeIDs.push_back(volumeID);
+  }
+  // Track segments of the length of a cell in random directions, starting at the drift chamber points
+  std::vector<TVector3> dchSegmentStarts, dchSegmentEnds;
+  dchSegmentStarts.reserve(numPoints);
+  dchSegmentEnds.reserve(numPoints);
+  for (const auto& point : dchPoints) {
+    double cosTheta = 2 * uniform(generator) - 1;
+    double phi = 2 * M_PI * uniform(generator);
+    double sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+    dchSegmentStarts.emplace_back(point.X, point.Y, point.Z);
+    dchSegmentEnds.emplace_back(point.X + cellSize * sinTheta * std::cos(phi),
+                                point.Y + cellSize * sinTheta * std::sin(phi), point.Z + cellSize * cosTheta);
+  }
+  dd4hep::DDSegmentation::DriftChamberWireIndex wireIndex(gridDriftChamber);
+  // Cell IDs used by the measurements of the methods taking a cell ID as an argument
+  auto cellIDs = [numPoints](const dd4hep::DDSegmentation::Segmentation& aSeg, const std::vector<Vector3D>& aPoints,
+                             const std::vector<CellID>& aVolumeIDs) {
+    std::vector<CellID> ids(numPoints);
+    for (std::size_t i = 0; i < numPoints; ++i) {
+      ids[i] = aSeg.cellID(aPoints[i], aPoints[i], aVolumeIDs[i]);
+    }
+    return ids;
+  };
+  const auto etaCellIDs = cellIDs(gridEta, caloPoints, caloVolumeIDs);
+  const auto phiEtaCellIDs = cellIDs(gridPhiEta, caloPoints, caloVolumeIDs);
+  const auto rPhiEtaCellIDs = cellIDs(gridRPhiEta, caloPoints, caloVolumeIDs);
+  const auto dchCellIDs = cellIDs(gridDriftChamber, dchPoints, dchVolumeIDs);
+  // Track segments of the hits in structure of arrays, all of them and split in batches for distancesTrackWire
+  const std::size_t batchSize = std::min<std::size_t>(numPoints, 1000);
+  const std::size_t numBatches = numPoints / batchSize;
+  dd4hep::DDSegmentation::DriftChamberSegments dchSegments;
+  std::vector<dd4hep::DDSegmentation::DriftChamberSegments> dchBatches(numBatches);
+  dd4hep::DDSegmentation::DriftChamberDistances dchDistances;
+  dchSegments.reserve(numPoints);
+  for (std::size_t i = 0; i < numPoints; ++i) {
+    const auto& start = dchSegmentStarts[i];
+    const auto& end = dchSegmentEnds[i];
+    dchSegments.push_back(dchCellIDs[i], start.X(), start.Y(), start.Z(), end.X(), end.Y(), end.Z());
+    if (i / batchSize < numBatches) {
+      dchBatches[i / batchSize].push_back(dchCellIDs[i], start.X(), start.Y(), start.Z(), end.X(), end.Y(), end.Z());
+    }
+  }
+
+  // Calorimeter points split in batches for the batched cellIDs
+  std::vector<std::vector<Vector3D>> caloPointBatches(numBatches);
+  std::vector<std::vector<CellID>> caloVolumeIDBatches(numBatches);
+  for (std::size_t i = 0; i < numBatches * batchSize; ++i) {
+    caloPointBatches[i / batchSize].push_back(caloPoints[i]);
+    caloVolumeIDBatches[i / batchSize].push_back(caloVolumeIDs[i]);
+  }
+  std::vector<CellID> caloBatchCellIDs;
+
+  auto sumOf = [](const Vector3D& aVec) { return aVec.X + aVec.Y + aVec.Z; };
+  std::vector<Measurement> measurements = {
+      {"GridEta::cellID",
+       [&](std::size_t i) { return gridEta.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]); }},
+      {"GridEta::position", [&](std::size_t i) { return sumOf(gridEta.position(etaCellIDs[i])); }},
+      {"GridEta::eta", [&](std::size_t i) { return gridEta.eta(etaCellIDs[i]); }},
+      {"FCCSWGridPhiEta::cellID",
+       [&](std::size_t i) { return gridPhiEta.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]); }},
+      {"FCCSWGridPhiEta::position", [&](std::size_t i) { return sumOf(gridPhiEta.position(phiEtaCellIDs[i])); }},
+      {"FCCSWGridPhiEta::phi", [&](std::size_t i) { return gridPhiEta.phi(phiEtaCellIDs[i]); }},
+      {"GridRPhiEta::cellID",
+       [&](std::size_t i) { return gridRPhiEta.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]); }},
+      {"GridRPhiEta::position", [&](std::size_t i) { return sumOf(gridRPhiEta.position(rPhiEtaCellIDs[i])); }},
+      {"GridRPhiEta::r", [&](std::size_t i) { return gridRPhiEta.r(rPhiEtaCellIDs[i]); }},
+      {"GridDriftChamber::cellID",
+       [&](std::size_t i) { return gridDriftChamber.cellID(dchPoints[i], dchPoints[i], dchVolumeIDs[i]); }},
+      {"GridDriftChamber::cellIDReference",
+       [&](std::size_t i) { return gridDriftChamber.cellIDReference(dchPoints[i], dchPoints[i], dchVolumeIDs[i]); }},
+      {"GridDriftChamber::position", [&](std::size_t i) { return sumOf(gridDriftChamber.position(dchCellIDs[i])); }},
+      {"DriftChamberWireIndex::withinDCA",
+       [&](std::size_t i) { return wireIndex.withinDCA(dchSegmentStarts[i], dchSegmentEnds[i], cellSize).size(); }},
+      {"DriftChamberWireIndex::kNearest",
+       [&](std::size_t i) { return wireIndex.kNearest(dchSegmentStarts[i], dchSegmentEnds[i], 3).front().dca; }},
+      {"DriftChamberWireIndex::withinDCAAllWires", [&](std::size_t i) {
+         return wireIndex.withinDCAAllWires(dchSegmentStarts[i], dchSegmentEnds[i], cellSize).size();
+       }}};
+  // testing all the wires is slow, call it for a fraction of the points
+  measurements.back().numCalls = std::max<std::size_t>(1, numPoints / 1000);
+  measurements.push_back({"GridDriftChamber::distanceTrackWire", [&](std::size_t i) {
+                            return gridDriftChamber.distanceTrackWire(dchCellIDs[i], dchSegmentStarts[i],
+                                                                      dchSegmentEnds[i]);
+                          }});
+  measurements.push_back({"GridDriftChamber::distancesTrackWire", [&](std::size_t i) {
+                            gridDriftChamber.distancesTrackWire(dchBatches[i], dchDistances);
+                            return dchDistances.dca.front();
+                          }});
+  measurements.back().numCalls = numBatches;
+  measurements.back().pointsPerCall = batchSize;
+  measurements.push_back({"FCCSWGridPhiEta::cellIDs", [&](std::size_t i) {
+                            gridPhiEta.cellIDs(caloPointBatches[i], caloVolumeIDBatches[i], caloBatchCellIDs);
+                            return caloBatchCellIDs.front();
+                          }});
+  measurements.back().numCalls = numBatches;
+  measurements.back().pointsPerCall = batchSize;
+  measurements.push_back({"GridRPhiEta::cellIDs", [&](std::size_t i) {
+                            gridRPhiEta.cellIDs(caloPointBatches[i], caloVolumeIDBatches[i], caloBatchCellIDs);
+                            return caloBatchCellIDs.front();
+                          }});
+  measurements.back().numCalls = numBatches;
+  measurements.back().pointsPerCall = batchSize;
+  measurements.push_back({"GridEta::cellIDLookup", [&](std::size_t i) {
+                            return gridEtaLookup.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]);
+                          }});
+  measurements.push_back({"FCCSWGridPhiEta::cellIDLookup", [&](std::size_t i) {
+                            return gridPhiEtaLookup.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]);
+                          }});
+  measurements.push_back({"GridRPhiEta::cellIDLookup", [&](std::size_t i) {
+                            return gridRPhiEtaLookup.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]);
+                          }});
+  measurements.push_back({"FCCSWGridPhiEtaVarEta::cellID", [&](std::size_t i) {
+                            return gridVarEta.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]);
+                          }});
+  measurements.push_back({"FCCSWGridPhiEtaVarEta::cellIDLookup", [&](std::size_t i) {
+                            return gridVarEtaLookup.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]);
+                          }});
+  measurements.push_back({"FCCSWGridPhiEta::cellIDLayersLookup", [&](std::size_t i) {
+                            return gridPhiEtaLayersLookup.cellID(caloPoints[i], caloPoints[i], caloVolumeIDs[i]);
+                          }});
+
+  std::cout << "Segmentation benchmark: " << numPoints << " points, best of " << numRepetitions << " repetitions"
+            << std::endl;
+  std::cout << std::left << std::setw(44) << "measurement" << std::right << std::setw(12) << "ns/call"
+            << std::setw(12) << "threshold" << std::endl;
+  double checksum = 0;
+  int numFailed = 0;
+  for (auto& measurement : measurements) {
+    measurement.threshold = thresholds.at(measurement.name);
+    double time = timeLoop(measurement, measurement.numCalls > 0 ? measurement.numCalls : numPoints, numRepetitions,
+                           checksum);
+    bool failed = useThresholds && time > measurement.threshold;
+    std::cout << std::left << std::setw(44) << measurement.name << std::right << std::fixed << std::setprecision(2)
+              << std::setw(12) << time << std::setw(12) << measurement.threshold << (failed ? "  FAILED" : "")
+              << std::endl;
+    if (failed) {
+      numFailed++;
+    }
+  }
+  std::cout << "checksum: " << std::setprecision(6) << checksum << std::endl;
+
+  // Validation of the fast drift chamber cellID against the reference implementation: identical cell IDs.
+  // Validation of the drift chamber wire positions against the wire calculated for each cell (at z = 0).
+  // Both for the chamber without and with an offset in phi.
+  std::size_t numErrors = 0;
+  std::size_t numWrongPositions = 0;
+  std::vector<Vector3D> dchPositions(numPoints);
+  for (const auto* segmentation : {&gridDriftChamber, &gridDriftChamberOffset}) {
+    const auto segmentationCellIDs = cellIDs(*segmentation, dchPoints, dchVolumeIDs);
+    for (std::size_t i = 0; i < numPoints; ++i) {
+      if (segmentationCellIDs[i] != segmentation->cellIDReference(dchPoints[i], dchPoints[i], dchVolumeIDs[i])) {
+        numErrors++;
+      }
+    }
+    segmentation->positions(segmentationCellIDs.data(), numPoints, dchPositions.data());
+    for (std::size_t i = 0; i < numPoints; ++i) {
+      TVector3 wire = segmentation->wirePos_vs_z(segmentationCellIDs[i], 0);
+      if (std::hypot(dchPositions[i].X - wire.X(), dchPositions[i].Y - wire.Y(), dchPositions[i].Z - wire.Z()) >
+          1e-9) {
+        numWrongPositions++;
+      }
+    }
+  }
+  std::cout << "GridDriftChamber::cellID vs cellIDReference: " << numErrors << " errors" << std::endl;
+  if (numErrors > 0) {
+    std::cerr << "GridDriftChamber::cellID differs from the reference implementation" << std::endl;
+    numFailed++;
+  }
+  std::cout << "GridDriftChamber::positions vs wirePos_vs_z: " << numWrongPositions << " errors" << std::endl;
+  if (numWrongPositions > 0) {
+    std::cerr << "GridDriftChamber::positions differs from the wire positions" << std::endl;
+    numFailed++;
+  }
+
+  // Validation of the wire index queries against the test of all the wires
+  std::size_t numWrongQueries = 0;
+  const std::size_t numQueries = std::min<std::size_t>(numPoints, 1000);
+  for (std::size_t i = 0; i < numQueries; ++i) {
+    auto found = wireIndex.withinDCA(dchSegmentStarts[i], dchSegmentEnds[i], cellSize);
+    auto all = wireIndex.withinDCAAllWires(dchSegmentStarts[i], dchSegmentEnds[i], cellSize);
+    bool same = found.size() == all.size();
+    for (std::size_t j = 0; same && j < found.size(); ++j) {
+      same = found[j].layer == all[j].layer && found[j].wire == all[j].wire;
+    }
+    // nearest wires of the whole chamber, ordered by the distance
+    auto nearest = wireIndex.kNearest(dchSegmentStarts[i], dchSegmentEnds[i], 3);
+    auto allNearest = wireIndex.withinDCAAllWires(dchSegmentStarts[i], dchSegmentEnds[i], 1e9);
+    std::sort(allNearest.begin(), allNearest.end(),
+              [](const auto& aLhs, const auto& aRhs) { return aLhs.dca < aRhs.dca; });
+    for (std::size_t j = 0; same && j < nearest.size(); ++j) {
+      same = nearest[j].layer == allNearest[j].layer && nearest[j].wire == allNearest[j].wire;
+    }
+    if (!same) {
+      numWrongQueries++;
+    }
+  }
+  std::cout << "DriftChamberWireIndex::withinDCA/kNearest vs all wires: " << numWrongQueries << " errors in "
+            << numQueries << " queries" << std::endl;
+  if (numWrongQueries > 0) {
+    std::cerr << "DriftChamberWireIndex differs from the test of all the wires" << std::endl;
+    numFailed++;
+  }
+
+  // Validation of the batched distances against the calculation for each hit: same DCA (for segments not parallel
+  // to the wire) and point of the closest approach on the wire
+  gridDriftChamber.distancesTrackWire(dchSegments, dchDistances);
+  std::size_t numWrongDistances = 0;
+  for (std::size_t i = 0; i < numPoints; ++i) {
+    double dca = gridDriftChamber.distanceTrackWire(dchCellIDs[i], dchSegmentStarts[i], dchSegmentEnds[i]);
+    TVector3 wire = gridDriftChamber.wirePos_vs_z(dchCellIDs[i], dchDistances.wireZ[i]);
+    if (std::abs(dchDistances.dca[i] - dca) > 1e-9 * (1 + dca) ||
+        std::hypot(dchDistances.wireX[i] - wire.X(), dchDistances.wireY[i] - wire.Y()) > 1e-9) {
+      numWrongDistances++;
+    }
+  }
+  std::cout << "GridDriftChamber::distancesTrackWire vs distanceTrackWire: " << numWrongDistances << " errors"
+            << std::endl;
+  if (numWrongDistances > 0) {
+    std::cerr << "GridDriftChamber::distancesTrackWire differs from distanceTrackWire" << std::endl;
+    numFailed++;
+  }
+
+  // Validation of the batched calorimeter cellIDs against the cellID of each point
+  std::size_t numWrongCellIDs = 0;
+  std::vector<CellID> etaBatchCellIDs, phiEtaBatchCellIDs, rPhiEtaBatchCellIDs;
+  gridEta.cellIDs(caloPoints, caloVolumeIDs, etaBatchCellIDs);
+  gridPhiEta.cellIDs(caloPoints, caloVolumeIDs, phiEtaBatchCellIDs);
+  gridRPhiEta.cellIDs(caloPoints, caloVolumeIDs, rPhiEtaBatchCellIDs);
+  for (std::size_t i = 0; i < numPoints; ++i) {
+    numWrongCellIDs += (etaBatchCellIDs[i] != etaCellIDs[i]) + (phiEtaBatchCellIDs[i] != phiEtaCellIDs[i]) +
+                       (rPhiEtaBatchCellIDs[i] != rPhiEtaCellIDs[i]);
+  }
+  std::cout << "GridEta/FCCSWGridPhiEta/GridRPhiEta::cellIDs vs cellID: " << numWrongCellIDs << " errors"
+            << std::endl;
+  if (numWrongCellIDs > 0) {
+    std::cerr << "Batched cellIDs differ from cellID" << std::endl;
+    numFailed++;
+  }
+
+  if (numFailed > 0) {
+    std::cerr << numFailed << " check(s) failed" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,71 @@
+#ifndef DETSEGMENTATION_DRIFTCHAMBERSEGMENTS_H
+#define DETSEGMENTATION_DRIFTCHAMBERSEGMENTS_H
+
+#include "DDSegmentation/Segmentation.h"
+
+#include <vector>
+
+/** DriftChamberSegments Detector/DetSegmentation/DetSegmentation/DriftChamberSegments.h DriftChamberSegments.h
+ *
+ *  Input and output of the batched distance calculation of GridDriftChamber (distancesTrackWire).
+ *  Both are structures of arrays: one plain array of doubles per coordinate, so that the loop over the hits can be
+ *  vectorised by the compiler. Positions are in the units of the segmentation (cm).
+ */
+
+namespace dd4hep {
+namespace DDSegmentation {
+/// Track segments of the drift chamber hits: cell ID and pre- and post-step positions
+struct DriftChamberSegments {
+  std::vector<CellID> cellID;
+  std::vector<double> preX, preY, preZ;
+  std::vector<double> postX, postY, postZ;
+
+  inline size_t size() const { return cellID.size(); }
+  inline void clear() { resize(0); }
+  void reserve(size_t aSize) {
+    for (auto* vec : {&preX, &preY, &preZ, &postX, &postY, &postZ}) {
+      vec->reserve(aSize);
+    }
+    cellID.reserve(aSize);
+  }
+  void resize(size_t aSize) {
+    for (auto* vec : {&preX, &preY, &preZ, &postX, &postY, &postZ}) {
+      vec->resize(aSize);
+    }
+    cellID.resize(aSize);
+  }
+  void push_back(CellID aCellID, double aPreX, double aPreY, double aPreZ, double aPostX, double aPostY,
+                 double aPostZ) {
+    cellID.push_back(aCellID);
+    preX.push_back(aPreX);
+    preY.push_back(aPreY);
+    preZ.push_back(aPreZ);
+    postX.push_back(aPostX);
+    postY.push_back(aPostY);
+    postZ.push_back(aPostZ);
+  }
+};
+
+/// Distances between the track segments and the wires of their cells, filled by GridDriftChamber::distancesTrackWire
+struct DriftChamberDistances {
+  /// distance of the closest approach between the track and the wire (-1 if the layer of the cell is unknown)
+  std::vector<double> dca;
+  /// point of the closest approach on the wire
+  std::vector<double> wireX, wireY, wireZ;
+  /// distance along the wire from the wire end at z = +L/2 to the point of the closest approach
+  std::vector<double> distanceAlongWire;
+  /// start of the wire (at z = +L/2) and vector from the start to the end of the wire, gathered for each hit
+  std::vector<double> wireStartX, wireStartY, wireStartZ;
+  std::vector<double> wireDirX, wireDirY, wireDirZ;
+
+  inline size_t size() const { return dca.size(); }
+  void resize(size_t aSize) {
+    for (auto* vec : {&dca, &wireX, &wireY, &wireZ, &distanceAlongWire, &wireStartX, &wireStartY, &wireStartZ,
+                      &wireDirX, &wireDirY, &wireDirZ}) {
+      vec->resize(aSize);
+    }
+  }
+};
+}
+}
+#endif /* DETSEGMENTATION_DRIFTCHAMBERSEGMENTS_H */
@@ -0,0 +1,138 @@
+#ifndef DETSEGMENTATION_DRIFTCHAMBERWIREINDEX_H
+#define DETSEGMENTATION_DRIFTCHAMBERWIREINDEX_H
+
+// FCCSW
+#include "DetSegmentation/GridDriftChamber.h"
+
+#include "TVector3.h"
+
+#include <string>
+#include <vector>
+
+/** DriftChamberWireIndex Detector/DetSegmentation/DetSegmentation/DriftChamberWireIndex.h DriftChamberWireIndex.h
+ *
+ *  Spatial index of the wires of the drift chamber, for the association of track segments to wires.
+ *  Built from the wires of GridDriftChamber (returnAllWires), after the geometry is constructed.
+ *
+ *  All wires of a layer are rotations of wire 0 by a multiple of the cell size in phi, so at any z the wire
+ *  number near a point follows from the angle between the point and wire 0 at the same z. For each layer
+ *  overlapping the segment in radius (binary search over layers ordered in radius), the angle is evaluated along
+ *  the segment and only the wires in the angular window that may be within the DCA cut are tested.
+ *  The window is conservative: no wire closer than the cut is missed.
+ *  Cost of a query: the binary search over the layers, then for each layer overlapping the segment in radius one
+ *  atan2 per sample of the segment (length / smallest wire spacing + 1 samples, at most 257), plus the DCA to each
+ *  wire of the window. A query is therefore not O(log n + k): long segments crossing many layers pay for the samples
+ *  in every layer. kNearest repeats withinDCA with the cut doubled until enough wires are found.
+ *  Validated against withinDCAAllWires by DriftChamberWireIndexTest (tests/).
+ *  Distance of the closest approach (DCA) is computed between the track segment and the wire (both finite).
+ */
+
+namespace dd4hep {
+namespace DDSegmentation {
+class DriftChamberWireIndex {
+public:
+  /// Wire found by a query
+  struct WireMatch {
+    /// ID of the layer
+    int layer;
+    /// number of the wire in the layer
+    int wire;
+    /// distance of the closest approach between the segment and the wire
+    double dca;
+  };
+
+  /** Constructor.
+   *  @param[in] aSegmentation Segmentation of the drift chamber, with the wires set for all the layers.
+   */
+  DriftChamberWireIndex(const GridDriftChamber& aSegmentation);
+  ~DriftChamberWireIndex() = default;
+
+  /**  Find all the wires within a distance from the segment.
+   *   @param[in] aStart Start of the track segment.
+   *   @param[in] aEnd End of the track segment.
+   *   @param[in] aMaxDCA Maximal distance of the closest approach.
+   *   return Wires within aMaxDCA, ordered by layer.
+   */
+  std::vector<WireMatch> withinDCA(const TVector3& aStart, const TVector3& aEnd, double aMaxDCA) const;
+  /**  Find the wires closest to the segment.
+   *   @param[in] aStart Start of the track segment.
+   *   @param[in] aEnd End of the track segment.
+   *   @param[in] aK Number of wires.
+   *   return aK closest wires (less if the chamber has less wires), ordered by the DCA.
+   */
+  std::vector<WireMatch> kNearest(const TVector3& aStart, const TVector3& aEnd, size_t aK) const;
+  /**  Find all the wires within a distance from the segment, testing all the wires.
+   *   Reference implementation used to validate and benchmark withinDCA.
+   *   @param[in] aStart Start of the track segment.
+   *   @param[in] aEnd End of the track segment.
+   *   @param[in] aMaxDCA Maximal distance of the closest approach.
+   *   return Wires within aMaxDCA, ordered by layer.
+   */
+  std::vector<WireMatch> withinDCAAllWires(const TVector3& aStart, const TVector3& aEnd, double aMaxDCA) const;
+  /**  Get the cell ID of a wire.
+   *   @param[in] aWire Wire.
+   *   @param[in] aVolumeID ID of the volume (other fields of the cell ID).
+   *   return Cell ID.
+   */
+  CellID cellID(const WireMatch& aWire, const VolumeID& aVolumeID) const;
+  /**  Get the number of indexed wires.
+   *   return Number of wires.
+   */
+  inline size_t numberOfWires() const { return m_numWires; }
+
+private:
+  /// Wires of one layer
+  struct Layer {
+    /// ID of the layer
+    int id;
+    /// number of wires
+    int numWires;
+    /// cell size in phi
+    double gridSizePhi;
+    /// position of the wire 0 at z: x = wire0X + wire0dXdZ * z, y = wire0Y + wire0dYdZ * z
+    double wire0X;
+    double wire0dXdZ;
+    double wire0Y;
+    double wire0dYdZ;
+    /// minimal radius of the wire lines (hyperboloid waist)
+    double waistRadius;
+    /// radius of the wires at the ends
+    double outerRadius;
+    /// 1/cos of the stereo angle
+    double invCosEpsilon;
+    /// maximal change of the angle of the wire 0 with z
+    double maxPhiRate;
+    /// z range of the wires
+    double zMin;
+    double zMax;
+    /// start point of the wires and vector from start to end of the wires (SoA)
+    std::vector<double> startX, startY, startZ, dirX, dirY, dirZ;
+  };
+  /// Track segment of a query, with the points at which the angle to the wires is evaluated
+  struct Segment;
+  /// Add the wires of the layer within aMaxDCA from the segment (not sorted)
+  void collect(const Layer& aLayer, const Segment& aSegment, double aMaxDCA, std::vector<WireMatch>& aWires) const;
+  /// Add all the wires of the layer within aMaxDCA from the segment (not sorted)
+  void collectAll(const Layer& aLayer, const Segment& aSegment, double aMaxDCA, std::vector<WireMatch>& aWires) const;
+
+  /// layers ordered by the waist radius
+  std::vector<Layer> m_layers;
+  /// waist radius of the layers (ordered)
+  std::vector<double> m_waistRadii;
+  /// running maximum of the outer radius of the layers (same order as m_layers)
+  std::vector<double> m_maxOuterRadii;
+  /// maximal tangent and 1/cos of the stereo angle among all the layers
+  double m_maxTanEpsilon = 0;
+  double m_maxInvCosEpsilon = 1;
+  /// smallest distance between neighbouring wires, used as the step along the segments
+  double m_minWireSpacing = 0;
+  /// total number of wires
+  size_t m_numWires = 0;
+  /// decoder of the segmentation
+  const BitFieldCoder* m_decoder;
+  /// field name used for phi
+  std::string m_phiID;
+};
+}
+}
+#endif /* DETSEGMENTATION_DRIFTCHAMBERWIREINDEX_H */
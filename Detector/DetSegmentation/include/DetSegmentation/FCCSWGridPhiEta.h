@@ -4,10 +4,18 @@
 // FCCSW
 #include "DetSegmentation/GridEta.h"
 
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
 /** FCCSWGridPhiEta Detector/DetSegmentation/DetSegmentation/FCCSWGridPhiEta.h FCCSWGridPhiEta.h
  *
  *  Segmentation in eta and phi.
  *  Based on GridEta, addition of azimuthal angle coordinate.
+ *  After prepareBinningLookup() the phi bin is found from a pseudo-angle (monotonic in phi, without atan2).
+ *  The granularity may depend on the layer: if any of the vectors grid_size_eta_layers, offset_eta_layers,
+ *  phi_bins_layers or offset_phi_layers is given, the layer field (identifier_layer) of the volume ID indexes it and
+ *  the scalar parameter is used for the vectors that are not given.
  *
  *  @author    Anna Zaborowska
  */
@@ -38,15 +46,79 @@ public:
    */
   virtual CellID cellID(const Vector3D& aLocalPosition, const Vector3D& aGlobalPosition,
                         const VolumeID& aVolumeID) const;
+  /**  Determine the cell IDs of a batch of positions, as cellID for each of them.
+   *   @param[in] aGlobalPositions Positions in the global coordinates.
+   *   @param[in] aVolumeIDs IDs of the volumes (one per position).
+   *   @param[out] aCellIDs Cell IDs (resized to the number of positions).
+   */
+  virtual void cellIDs(const std::vector<Vector3D>& aGlobalPositions, const std::vector<VolumeID>& aVolumeIDs,
+                       std::vector<CellID>& aCellIDs) const;
+  /**  Prepare the lookup of the eta and phi bins from the positions, without the calculation of the angles.
+   *   To be called after the parameters are set, the lookup is not used if they change afterwards.
+   */
+  virtual void prepareBinningLookup();
+  /**  Determine the pseudorapidity based on the cell ID.
+   *   @param[in] aCellId ID of a cell.
+   *   return Pseudorapidity.
+   */
+  virtual double eta(const CellID& aCellID) const;
   /**  Determine the azimuthal angle based on the cell ID.
    *   @param[in] aCellId ID of a cell.
    *   return Phi.
    */
   double phi(const CellID& aCellID) const;
+  using GridEta::gridSizeEta;
+  using GridEta::offsetEta;
+  /**  Get the grid size in pseudorapidity of a layer.
+   *   @param[in] aLayer Layer, negative for the granularity independent of the layer.
+   *   return Grid size in eta.
+   */
+  inline double gridSizeEta(int aLayer) const { return layerParameter(m_gridSizeEtaLayers, m_gridSizeEta, aLayer); }
+  /**  Get the coordinate offset in pseudorapidity of a layer.
+   *   @param[in] aLayer Layer, negative for the granularity independent of the layer.
+   *   return The offset in eta.
+   */
+  inline double offsetEta(int aLayer) const { return layerParameter(m_offsetEtaLayers, m_offsetEta, aLayer); }
+  /**  Get the number of bins in azimuthal angle of a layer.
+   *   @param[in] aLayer Layer, negative for the granularity independent of the layer.
+   *   return Number of bins in phi.
+   */
+  inline int phiBins(int aLayer) const { return layerParameter(m_phiBinsLayers, m_phiBins, aLayer); }
+  /**  Get the coordinate offset in azimuthal angle of a layer.
+   *   @param[in] aLayer Layer, negative for the granularity independent of the layer.
+   *   return The offset in phi.
+   */
+  inline double offsetPhi(int aLayer) const { return layerParameter(m_offsetPhiLayers, m_offsetPhi, aLayer); }
+  /**  Check if the granularity depends on the layer.
+   *   return True if any of the per-layer parameters is given.
+   */
+  inline bool hasLayerBinning() const {
+    return !m_gridSizeEtaLayers.empty() || !m_offsetEtaLayers.empty() || !m_phiBinsLayers.empty() ||
+           !m_offsetPhiLayers.empty();
+  }
+  /**  Get the number of layers with the per-layer granularity.
+   *   return Largest size of the per-layer parameters.
+   */
+  inline int numberOfLayers() const {
+    return static_cast<int>(std::max(std::max(m_gridSizeEtaLayers.size(), m_offsetEtaLayers.size()),
+                                     std::max(m_phiBinsLayers.size(), m_offsetPhiLayers.size())));
+  }
+  /**  Get the layer indexing the granularity of a cell (or volume).
+   *   @param[in] aCellId ID of a cell or a volume.
+   *   return Layer, -1 if the granularity does not depend on the layer.
+   */
+  inline int layer(const CellID& aCellID) const {
+    return hasLayerBinning() ? static_cast<int>(_decoder->get(aCellID, m_layerID)) : -1;
+  }
   /**  Get the grid size in phi.
    *   return Grid size in phi.
    */
   inline double gridSizePhi() const { return 2 * M_PI / static_cast<double>(m_phiBins); }
+  /**  Get the grid size in phi of a layer.
+   *   @param[in] aLayer Layer, negative for the granularity independent of the layer.
+   *   return Grid size in phi.
+   */
+  inline double gridSizePhi(int aLayer) const { return 2 * M_PI / static_cast<double>(phiBins(aLayer)); }
   /**  Get the number of bins in azimuthal angle.
    *   return Number of bins in phi.
    */
@@ -59,6 +131,10 @@ public:
    *   return The field name for phi.
    */
   inline const std::string& fieldNamePhi() const { return m_phiID; }
+  /**  Get the field name for the layer.
+   *   return The field name for the layer.
+   */
+  inline const std::string& fieldNameLayer() const { return m_layerID; }
   /**  Set the number of bins in azimuthal angle.
    *   @param[in] aNumberBins Number of bins in phi.
    */
@@ -71,16 +147,117 @@ public:
    *   @param[in] aFieldName Field name for phi.
    */
   inline void setFieldNamePhi(const std::string& fieldName) { m_phiID = fieldName; }
+  /**  Set the grid sizes in pseudorapidity of the layers.
+   *   @param[in] aCellSizes Cell size in eta of each layer (empty for the same size in all the layers).
+   */
+  inline void setGridSizeEtaLayers(const std::vector<double>& aCellSizes) { m_gridSizeEtaLayers = aCellSizes; }
+  /**  Set the coordinate offsets in pseudorapidity of the layers.
+   *   @param[in] aOffsets Offset in eta of each layer (empty for the same offset in all the layers).
+   */
+  inline void setOffsetEtaLayers(const std::vector<double>& aOffsets) { m_offsetEtaLayers = aOffsets; }
+  /**  Set the numbers of bins in azimuthal angle of the layers.
+   *   @param[in] aNumberBins Number of bins in phi of each layer (empty for the same number in all the layers).
+   */
+  inline void setPhiBinsLayers(const std::vector<int>& aNumberBins) { m_phiBinsLayers = aNumberBins; }
+  /**  Set the coordinate offsets in azimuthal angle of the layers.
+   *   @param[in] aOffsets Offset in phi of each layer (empty for the same offset in all the layers).
+   */
+  inline void setOffsetPhiLayers(const std::vector<double>& aOffsets) { m_offsetPhiLayers = aOffsets; }
+  /**  Set the field name used for the layer.
+   *   @param[in] aFieldName Field name for the layer.
+   */
+  inline void setFieldNameLayer(const std::string& fieldName) { m_layerID = fieldName; }
 
 protected:
   /// determine the azimuthal angle phi based on the current cell ID
   double phi() const;
+  /// pseudo-angle in (-2, 2], monotonic in atan2(y, x) for y != 0 (y = 0 and x < 0 gives 2, also for y = -0)
+  static inline double pseudoAngle(double aX, double aY) {
+    double slope = aY / (std::abs(aX) + std::abs(aY));
+    return aX >= 0 ? slope : (aY >= 0 ? 2 - slope : -2 - slope);
+  }
+  /// determine the phi bin of the position, from the lookup if it is prepared for the current parameters
+  inline int phiBin(const Vector3D& aPosition) const {
+    int bin;
+    if (m_lookupPhiBins == m_phiBins && m_lookupOffsetPhi == m_offsetPhi &&
+        m_phiLookup.find(pseudoAngle(aPosition.X, aPosition.Y), bin)) {
+      return bin;
+    }
+    return positionToBin(phiFromXYZ(aPosition), 2 * M_PI / (double)m_phiBins, m_offsetPhi);
+  }
+  using GridEta::etaBin;
+  /// determine the eta bin of the position in a layer (negative for the granularity independent of the layer)
+  inline int etaBin(const Vector3D& aPosition, int aLayer) const {
+    if (aLayer < 0) {
+      return etaBin(aPosition);
+    }
+    const double gridSize = gridSizeEta(aLayer);
+    const double offset = offsetEta(aLayer);
+    int bin;
+    if (aLayer < (int)m_layerLookups.size() && m_layerLookups[aLayer].gridSizeEta == gridSize &&
+        m_layerLookups[aLayer].offsetEta == offset &&
+        m_layerLookups[aLayer].eta.find(
+            aPosition.Z * std::abs(aPosition.Z) / (aPosition.X * aPosition.X + aPosition.Y * aPosition.Y), bin)) {
+      return bin;
+    }
+    return positionToBin(etaFromXYZ(aPosition), gridSize, offset);
+  }
+  /// determine the phi bin of the position in a layer (negative for the granularity independent of the layer)
+  inline int phiBin(const Vector3D& aPosition, int aLayer) const {
+    if (aLayer < 0) {
+      return phiBin(aPosition);
+    }
+    const int bins = phiBins(aLayer);
+    const double offset = offsetPhi(aLayer);
+    int bin;
+    if (aLayer < (int)m_layerLookups.size() && m_layerLookups[aLayer].phiBins == bins &&
+        m_layerLookups[aLayer].offsetPhi == offset &&
+        m_layerLookups[aLayer].phi.find(pseudoAngle(aPosition.X, aPosition.Y), bin)) {
+      return bin;
+    }
+    return positionToBin(phiFromXYZ(aPosition), 2 * M_PI / (double)bins, offset);
+  }
+  /// create the lookup of the phi bins of given number and offset, from the pseudo-angle
+  static MonotonicBinLookup phiBinLookup(int aBins, double aOffset);
+  /// parameter of a layer: element of the per-layer vector, or the scalar if the vector is empty
+  template <typename T>
+  inline T layerParameter(const std::vector<T>& aLayerValues, T aValue, int aLayer) const {
+    if (aLayer < 0 || aLayerValues.empty()) {
+      return aValue;
+    }
+    if (aLayer >= (int)aLayerValues.size()) {
+      throw std::runtime_error("Layer " + std::to_string(aLayer) + " is outside of the per-layer parameters of " +
+                               _type);
+    }
+    return aLayerValues[aLayer];
+  }
   /// the number of bins in phi
   int m_phiBins;
   /// the coordinate offset in phi
   double m_offsetPhi;
   /// the field name used for phi
   std::string m_phiID;
+  /// lookup of the phi bins from the pseudo-angle, and the parameters it was prepared for
+  MonotonicBinLookup m_phiLookup;
+  int m_lookupPhiBins = 0;
+  double m_lookupOffsetPhi = 0;
+  /// the grid sizes and offsets in eta, the numbers of bins and offsets in phi of each layer (empty if not given)
+  std::vector<double> m_gridSizeEtaLayers;
+  std::vector<double> m_offsetEtaLayers;
+  std::vector<int> m_phiBinsLayers;
+  std::vector<double> m_offsetPhiLayers;
+  /// the field name used for the layer
+  std::string m_layerID;
+  /// lookups of the eta and phi bins of a layer, and the parameters they were prepared for
+  struct LayerLookup {
+    double gridSizeEta = 0;
+    double offsetEta = 0;
+    int phiBins = 0;
+    double offsetPhi = 0;
+    MonotonicBinLookup eta;
+    MonotonicBinLookup phi;
+  };
+  std::vector<LayerLookup> m_layerLookups;
 };
 }
 }
@@ -105,13 +105,14 @@ public:
       in natural order of dimensions (dPhi, dEta)
 
       Returns a std::vector of the cellDimensions of the given cell ID
-      \param cellID is ignored as all cells have the same dimension
+      \param cellID is the ID of the cell (the sizes depend on the layer if the granularity is given per layer)
       \return std::vector<double> size 2:
       -# size in phi
       -# size in eta
   */
-  inline std::vector<double> cellDimensions(const CellID& /*id*/) const {
-    return {access()->implementation->gridSizePhi(), access()->implementation->gridSizeEta()};
+  inline std::vector<double> cellDimensions(const CellID& id) const {
+    int layer = access()->implementation->layer(id);
+    return {access()->implementation->gridSizePhi(layer), access()->implementation->gridSizeEta(layer)};
   }
 };
 
@@ -0,0 +1,95 @@
+#ifndef DETSEGMENTATION_GRIDPHIETAVARETA_H
+#define DETSEGMENTATION_GRIDPHIETAVARETA_H
+
+// FCCSW
+#include "DetSegmentation/FCCSWGridPhiEta.h"
+
+/** FCCSWGridPhiEtaVarEta Detector/DetSegmentation/DetSegmentation/FCCSWGridPhiEtaVarEta.h FCCSWGridPhiEtaVarEta.h
+ *
+ *  Segmentation in eta and phi, with bins of variable width in eta.
+ *  Based on FCCSWGridPhiEta, the eta bins are given by the list of their edges (parameter eta_edges, increasing):
+ *  bin i covers [eta_edges[i], eta_edges[i+1]). Parameters grid_size_eta and offset_eta are not used (optional).
+ *  The bin is found with a binary search of the edges or, after prepareBinningLookup(), with the lookup of a uniform
+ *  grid of the eta range (see MonotonicBinLookup), as cheap as the uniform bins of FCCSWGridPhiEta.
+ *  A position outside of the edges is an error (std::runtime_error).
+ *  Of the per-layer granularity of FCCSWGridPhiEta only phi_bins_layers and offset_phi_layers are used.
+ */
+
+namespace dd4hep {
+namespace DDSegmentation {
+class FCCSWGridPhiEtaVarEta : public FCCSWGridPhiEta {
+public:
+  /// default constructor using an arbitrary type
+  FCCSWGridPhiEtaVarEta(const std::string& aCellEncoding);
+  /// Default constructor used by derived classes passing an existing decoder
+  FCCSWGridPhiEtaVarEta(const BitFieldCoder* decoder);
+
+  /// destructor
+  virtual ~FCCSWGridPhiEtaVarEta() = default;
+
+  /**  Determine the global position based on the cell ID.
+   *   @warning This segmentation has no knowledge of radius, so radius = 1 is taken into calculations.
+   *   @param[in] aCellId ID of a cell.
+   *   return Position (radius = 1).
+   */
+  virtual Vector3D position(const CellID& aCellID) const;
+  /**  Determine the cell ID based on the position.
+   *   @param[in] aLocalPosition (not used).
+   *   @param[in] aGlobalPosition position in the global coordinates.
+   *   @param[in] aVolumeId ID of a volume.
+   *   return Cell ID.
+   */
+  virtual CellID cellID(const Vector3D& aLocalPosition, const Vector3D& aGlobalPosition,
+                        const VolumeID& aVolumeID) const;
+  /**  Determine the cell IDs of a batch of positions, as cellID for each of them.
+   *   @param[in] aGlobalPositions Positions in the global coordinates.
+   *   @param[in] aVolumeIDs IDs of the volumes (one per position).
+   *   @param[out] aCellIDs Cell IDs (resized to the number of positions).
+   */
+  virtual void cellIDs(const std::vector<Vector3D>& aGlobalPositions, const std::vector<VolumeID>& aVolumeIDs,
+                       std::vector<CellID>& aCellIDs) const;
+  /**  Prepare the lookups of the eta bins (from eta and from the position) and of the phi bins.
+   *   To be called after the parameters are set, the eta edges may then only be changed with setEtaEdges.
+   */
+  virtual void prepareBinningLookup();
+  /**  Determine the pseudorapidity (centre of the bin) based on the cell ID.
+   *   @param[in] aCellId ID of a cell.
+   *   return Pseudorapidity.
+   */
+  virtual double eta(const CellID& aCellID) const;
+  /**  Determine the eta bin of a pseudorapidity.
+   *   @param[in] aEta Pseudorapidity, within the edges.
+   *   return Index of the bin.
+   */
+  int etaToBin(double aEta) const;
+  /**  Get the edges of the eta bins.
+   *   return Edges in eta.
+   */
+  inline const std::vector<double>& etaEdges() const { return m_etaEdges; }
+  /**  Get the number of bins in eta.
+   *   return Number of bins in eta.
+   */
+  inline int etaBins() const { return m_etaEdges.size() < 2 ? 0 : m_etaEdges.size() - 1; }
+  /**  Set the edges of the eta bins.
+   *   @param[in] aEdges Edges in eta (increasing).
+   */
+  void setEtaEdges(const std::vector<double>& aEdges);
+
+protected:
+  /// determine the eta bin of the position, from the lookups if they are prepared
+  inline int varEtaBin(const Vector3D& aPosition) const {
+    int bin;
+    if (m_etaLookup.find(aPosition.Z * std::abs(aPosition.Z) / (aPosition.X * aPosition.X + aPosition.Y * aPosition.Y),
+                         bin)) {
+      return bin;
+    }
+    return etaToBin(etaFromXYZ(aPosition));
+  }
+  /// the edges of the eta bins
+  std::vector<double> m_etaEdges;
+  /// lookup of the eta bins from eta (exact, tolerance 0)
+  MonotonicBinLookup m_edgeLookup;
+};
+}
+}
+#endif /* DETSEGMENTATION_GRIDPHIETAVARETA_H */
@@ -0,0 +1,107 @@
+#ifndef DD4HEP_DDCORE_GRIDPHIETAVARETA_H
+#define DD4HEP_DDCORE_GRIDPHIETAVARETA_H 1
+
+// FCCSW
+#include "DetSegmentation/FCCSWGridPhiEtaVarEta.h"
+
+// DD4hep
+#include "DD4hep/Segmentations.h"
+#include "DD4hep/detail/SegmentationsInterna.h"
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+/// Namespace for base segmentations
+
+
+// Forward declarations
+class Segmentation;
+template <typename T>
+class SegmentationWrapper;
+
+/// We need some abbreviation to make the code more readable.
+typedef Handle<SegmentationWrapper<DDSegmentation::FCCSWGridPhiEtaVarEta>> FCCSWGridPhiEtaVarEtaHandle;
+
+/// Implementation class for the grid phi-eta segmentation with variable bins in eta.
+/**
+ *  Concrete user handle to serve specific needs of client code
+ *  which requires access to the base functionality not served
+ *  by the super-class Segmentation.
+ *
+ *  Note:
+ *  We only check the validity of the underlying handle.
+ *  If for whatever reason the implementation object is not valid
+ *  This is not checked.
+ */
+class FCCSWGridPhiEtaVarEta : public FCCSWGridPhiEtaVarEtaHandle {
+public:
+  /// Defintiion of the basic handled object
+  typedef FCCSWGridPhiEtaVarEtaHandle::Object Object;
+
+public:
+  /// Default constructor
+  FCCSWGridPhiEtaVarEta() = default;
+  /// Copy constructor
+  FCCSWGridPhiEtaVarEta(const FCCSWGridPhiEtaVarEta& e) = default;
+  /// Copy Constructor from segmentation base object
+  FCCSWGridPhiEtaVarEta(const Segmentation& e) : Handle<Object>(e) {}
+  /// Copy constructor from handle
+  FCCSWGridPhiEtaVarEta(const Handle<Object>& e) : Handle<Object>(e) {}
+  /// Copy constructor from other polymorph/equivalent handle
+  template <typename Q>
+  FCCSWGridPhiEtaVarEta(const Handle<Q>& e) : Handle<Object>(e) {}
+  /// Assignment operator
+  FCCSWGridPhiEtaVarEta& operator=(const FCCSWGridPhiEtaVarEta& seg) = default;
+  /// Equality operator
+  bool operator==(const FCCSWGridPhiEtaVarEta& seg) const { return m_element == seg.m_element; }
+  /// determine the position based on the cell ID
+  inline Position position(const CellID& id) const { return Position(access()->implementation->position(id)); }
+
+  /// determine the cell ID based on the position
+  inline dd4hep::CellID cellID(const Position& local, const Position& global, const VolumeID& volID) const {
+    return access()->implementation->cellID(local, global, volID);
+  }
+
+  /// access the edges of the eta bins
+  inline const std::vector<double>& etaEdges() const { return access()->implementation->etaEdges(); }
+
+  /// access the grid size in Phi
+  inline int phiBins() const { return access()->implementation->phiBins(); }
+
+  /// access the coordinate offset in Phi
+  inline double offsetPhi() const { return access()->implementation->offsetPhi(); }
+
+  /// set the edges of the eta bins
+  inline void setEtaEdges(const std::vector<double>& edges) const { access()->implementation->setEtaEdges(edges); }
+
+  /// set the coordinate offset in Phi
+  inline void setOffsetPhi(double offset) const { access()->implementation->setOffsetPhi(offset); }
+
+  /// set the grid size in Phi
+  inline void setPhiBins(int cellSize) const { access()->implementation->setPhiBins(cellSize); }
+
+  /// access the field name used for eta
+  inline const std::string& fieldNameEta() const { return access()->implementation->fieldNameEta(); }
+
+  /// access the field name used for Phi
+  inline const std::string& fieldNamePhi() const { return access()->implementation->fieldNamePhi(); }
+
+  /** \brief Returns a std::vector<double> of the cellDimensions of the given cell ID
+      in natural order of dimensions (dPhi, dEta)
+
+      Returns a std::vector of the cellDimensions of the given cell ID
+      \param cellID is the ID of the cell (the size in eta depends on the eta bin)
+      \return std::vector<double> size 2:
+      -# size in phi
+      -# size in eta
+  */
+  inline std::vector<double> cellDimensions(const CellID& id) const {
+    const auto& edges = access()->implementation->etaEdges();
+    auto etaBin = access()->implementation->decoder()->get(id, access()->implementation->fieldNameEta());
+    return {access()->implementation->gridSizePhi(access()->implementation->layer(id)),
+            edges.at(etaBin + 1) - edges.at(etaBin)};
+  }
+};
+
+} /* End namespace dd4hep                */
+#endif  // DD4HEP_DDCORE_GRIDPHIETAVARETA_H
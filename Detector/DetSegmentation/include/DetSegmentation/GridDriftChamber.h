@@ -2,6 +2,7 @@
 #define DETSEGMENTATION_GRIDDRIFTCHAMBER_H
 
 #include "DDSegmentation/Segmentation.h"
+#include "DetSegmentation/DriftChamberSegments.h"
 
 #include "TVector3.h"
 #include <cmath>
@@ -25,9 +26,46 @@ public:
   /// destructor
   virtual ~GridDriftChamber() = default;
 
+  /**  Determine the position of the wire midpoint (z = 0) based on the cell ID.
+   *   Positions are taken from the table filled in setWiresInLayer, (0,0,0) is returned for an unknown layer.
+   *   @param[in] aCellId ID of a cell.
+   *   return Position of the wire midpoint.
+   */
   virtual Vector3D position(const CellID& aCellID) const;
+  /**  Determine the positions of the wire midpoints (z = 0) for many cells.
+   *   @param[in] aCellIDs Pointer to the first cell ID.
+   *   @param[in] aNumCells Number of cells.
+   *   @param[out] aPositions Pointer to the first of aNumCells positions to fill.
+   */
+  void positions(const CellID* aCellIDs, size_t aNumCells, Vector3D* aPositions) const;
+  /**  Determine the cell ID based on the position.
+   *   Same calculation as cellIDReference (identical cell IDs), with the constants of the layer (alpha and its
+   *   cosine and sine) precomputed in setGeomParams instead of the trigonometric functions for each call.
+   *   @param[in] aLocalPosition (not used).
+   *   @param[in] aGlobalPosition position in the global coordinates.
+   *   @param[in] aVolumeId ID of a volume.
+   *   return Cell ID.
+   */
   virtual CellID cellID(const Vector3D& aLocalPosition, const Vector3D& aGlobalPosition,
                         const VolumeID& aVolumeID) const;
+  /**  Determine the cell ID based on the position, recalculating the parameters of the layer for each call.
+   *   Reference implementation used to validate and benchmark cellID.
+   *   @param[in] aLocalPosition (not used).
+   *   @param[in] aGlobalPosition position in the global coordinates.
+   *   @param[in] aVolumeId ID of a volume.
+   *   return Cell ID.
+   */
+  CellID cellIDReference(const Vector3D& aLocalPosition, const Vector3D& aGlobalPosition,
+                         const VolumeID& aVolumeID) const;
+  /**  Determine the distances between many track segments and the wires of their cells.
+   *   The wires are gathered from the tables filled in setWiresInLayer, then the distances are computed in a
+   *   branch-free loop over plain arrays (vectorised by the compiler), without any TVector3.
+   *   The DCA is the one of distanceTrackWire (infinite lines). For a segment parallel to the wire or of zero length
+   *   the distance of the middle of the segment to the wire is used instead (distanceTrackWire returns 0).
+   *   @param[in] aSegments Cell IDs and pre- and post-step positions of the hits.
+   *   @param[out] aDistances DCA, point of the closest approach on the wire and distance along the wire of each hit.
+   */
+  void distancesTrackWire(const DriftChamberSegments& aSegments, DriftChamberDistances& aDistances) const;
   virtual TVector3 distanceClosestApproach(const CellID& cID, const TVector3& hitPos) const;
   virtual double distanceTrackWire(const CellID& cID, const TVector3& hit_start, const TVector3& hit_end) const;
   virtual TVector3 Line_TrackWire(const CellID& cID, const TVector3& hit_start, const TVector3& hit_end) const;
@@ -43,16 +81,21 @@ public:
   // Setters
   inline void setEpsilon(double aEpsilon) { m_epsilon = aEpsilon; }
 
-  inline void setGeomParams(int layer, double sizePhi, double R, double eps) {
-    layer_params[layer] = {sizePhi, R, eps};
-  }
+  /**  Set the geometry parameters of a layer and precompute the constants used in cellID.
+   *   The detector length needs to be set before.
+   *   @param[in] layer ID of the layer.
+   *   @param[in] sizePhi Cell size in phi.
+   *   @param[in] R Radius of the wires at the end-caps.
+   *   @param[in] eps Stereo angle of the wires.
+   */
+  void setGeomParams(int layer, double sizePhi, double R, double eps);
 
   inline void setWiresInLayer(int layer, int numWires)
   {
     updateParams(layer);
     for (int i = 0; i<numWires; ++i)
       {
-	auto phi_start = _currentGridSizePhi* i;
+	auto phi_start = binToPosition(i, _currentGridSizePhi, m_offsetPhi);
 	auto phi_end = phi_start + returnAlpha();
 
 	TVector3 Wstart = returnWirePosition(phi_start, 1);
@@ -62,9 +105,22 @@ public:
 	TVector3 Wdirection = (Wend - Wstart);
 
 	m_wiresPositions[layer].push_back(std::make_pair(Wmid, Wdirection));
+	m_wireMidpoints.emplace_back(Wmid.X(), Wmid.Y(), Wmid.Z());
+	m_wireStartX.push_back(Wstart.X());
+	m_wireStartY.push_back(Wstart.Y());
+	m_wireStartZ.push_back(Wstart.Z());
+	m_wireDirX.push_back(Wdirection.X());
+	m_wireDirY.push_back(Wdirection.Y());
+	m_wireDirZ.push_back(Wdirection.Z());
       }
+    if (static_cast<size_t>(layer) >= m_layerWires.size()) {
+      m_layerWires.resize(layer + 1, {0, 0});
+    }
+    m_layerWires[layer] = {m_wireMidpoints.size() - numWires, numWires};
+  }
+  inline const std::map<int, std::vector<std::pair<TVector3, TVector3>>>& returnAllWires() const {
+    return m_wiresPositions;
   }
-  inline auto returnAllWires() const {return m_wiresPositions; }
 
   TVector3 LineLineIntersect(TVector3 p1, TVector3 p2, TVector3 p3, TVector3 p4) const {
     TVector3 p13, p43, p21;
@@ -202,6 +258,43 @@ public:
   }
 
 protected:
+  /// index of the wire of the cell in m_wireMidpoints, or -1 if the layer is unknown
+  inline long long wireIndex(const CellID& cID) const {
+    size_t layer = _decoder->get(cID, m_layerIndex);
+    if (layer >= m_layerWires.size() || m_layerWires[layer].second == 0) {
+      return -1;
+    }
+    // phi bin equal to the number of wires (cell at 2pi) is the wire 0
+    long long numWires = m_layerWires[layer].second;
+    long long wire = _decoder->get(cID, m_phiIndex) % numWires;
+    if (wire < 0) {
+      wire += numWires;
+    }
+    return m_layerWires[layer].first + wire;
+  }
+  /// Constants of a layer precomputed in setGeomParams
+  struct LayerConstants {
+    /// cell size in phi
+    double gridSizePhi = 0;
+    /// radius of the wires at the end-caps
+    double radius = 0;
+    /// stereo angle of the wires
+    double epsilon = 0;
+    /// azimuthal angle between both ends of the wire
+    double alpha = 0;
+    double cosAlpha = 1;
+    double sinAlpha = 0;
+    /// whether the layer was set
+    bool isSet = false;
+  };
+  /// get the constants of a layer, if the layer was not set the last set layer is taken (as in updateParams)
+  inline const LayerConstants& layerConstants(unsigned int layer) const {
+    if (layer < m_layerConstants.size() && m_layerConstants[layer].isSet) {
+      return m_layerConstants[layer];
+    }
+    return m_layerConstants[m_lastLayer];
+  }
+
   /* *** nalipour *** */
   double phi(const CellID& cID) const;
 
@@ -214,6 +307,22 @@ protected:
   double m_offsetPhi;
   std::string m_phiID;
 
+  /// constants of the layers, indexed by the layer ID
+  std::vector<LayerConstants> m_layerConstants;
+  /// highest layer ID that was set
+  unsigned int m_lastLayer = 0;
+  /// midpoints of all the wires, stored layer after layer
+  std::vector<Vector3D> m_wireMidpoints;
+  /// start of all the wires (z = +L/2) and vector from the start to the end, in the order of m_wireMidpoints
+  std::vector<double> m_wireStartX, m_wireStartY, m_wireStartZ;
+  std::vector<double> m_wireDirX, m_wireDirY, m_wireDirZ;
+  /// index of the first wire of the layer in m_wireMidpoints and number of wires, indexed by the layer ID
+  std::vector<std::pair<size_t, size_t>> m_layerWires;
+  /// index of the layer field in the decoder
+  size_t m_layerIndex = 0;
+  /// index of the phi field in the decoder
+  size_t m_phiIndex = 0;
+
   // Current parameters of the layer: sizePhi
   mutable double _currentGridSizePhi;  // current size Phi
   mutable double _currentRadius;       // current size radius
@@ -48,6 +48,10 @@ public:
   bool operator==(const GridDriftChamber& seg) const { return m_element == seg.m_element; }
   /// determine the position based on the cell ID
   inline Position position(const CellID& id) const { return Position(access()->implementation->position(id)); }
+  /// determine the positions of the wire midpoints for many cells
+  inline void positions(const CellID* ids, size_t num, DDSegmentation::Vector3D* pos) const {
+    access()->implementation->positions(ids, num, pos);
+  }
 
   /// determine the cell ID based on the position
   inline dd4hep::CellID cellID(const Position& local, const Position& global, const VolumeID& volID) const {
@@ -71,9 +75,7 @@ public:
     access()->implementation->setWiresInLayer(layer, numWires);
   }
 
-  inline auto returnAllWires() const {
-    access()->implementation->returnAllWires();
-  }
+  inline const auto& returnAllWires() const { return access()->implementation->returnAllWires(); }
 
   inline double phiFromXY(const Position& aposition) const { return access()->implementation->phiFromXY(aposition); }
   inline TVector3 distanceClosestApproach(const CellID& cID, const TVector3& hitPos) const {
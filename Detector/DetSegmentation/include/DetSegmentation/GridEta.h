@@ -2,14 +2,18 @@
 #define DETSEGMENTATION_GRIDETA_H
 
 #include "DDSegmentation/Segmentation.h"
+#include "DetSegmentation/MonotonicBinLookup.h"
 
 /* #include "DDSegmentation/SegmentationUtil.h" */
 #include "TVector3.h"
 #include <cmath>
+#include <vector>
 
 /** GridEta Detector/DetSegmentation/DetSegmentation/GridEta.h GridEta.h
  *
  *  Segmentation in eta.
+ *  After prepareBinningLookup() the eta bin is found from z|z|/(x^2+y^2) and precomputed bin boundaries instead of
+ *  the calculation of the pseudorapidity, with the same result (see MonotonicBinLookup).
  *
  *  @author    Anna Zaborowska
  */
@@ -39,11 +43,23 @@ public:
    */
   virtual CellID cellID(const Vector3D& aLocalPosition, const Vector3D& aGlobalPosition,
                         const VolumeID& aVolumeID) const;
+  /**  Determine the cell IDs of a batch of positions, as cellID for each of them.
+   *   The fields of the cell ID are looked up once per batch instead of once per position.
+   *   @param[in] aGlobalPositions Positions in the global coordinates.
+   *   @param[in] aVolumeIDs IDs of the volumes (one per position).
+   *   @param[out] aCellIDs Cell IDs (resized to the number of positions).
+   */
+  virtual void cellIDs(const std::vector<Vector3D>& aGlobalPositions, const std::vector<VolumeID>& aVolumeIDs,
+                       std::vector<CellID>& aCellIDs) const;
+  /**  Prepare the lookup of the bins from the positions, without the calculation of the angles.
+   *   To be called after the parameters are set, the lookup is not used if they change afterwards.
+   */
+  virtual void prepareBinningLookup();
   /**  Determine the pseudorapidity based on the cell ID.
    *   @param[in] aCellId ID of a cell.
    *   return Pseudorapidity.
    */
-  double eta(const CellID& aCellID) const;
+  virtual double eta(const CellID& aCellID) const;
   /**  Get the grid size in pseudorapidity.
    *   return Grid size in eta.
    */
@@ -91,12 +107,28 @@ public:
 protected:
   /// determine the pseudorapidity based on the current cell ID
   double eta() const;
+  /// create the lookup of the eta bins of given size and offset, from z|z|/(x^2+y^2)
+  MonotonicBinLookup etaBinLookup(double aGridSize, double aOffset) const;
+  /// determine the eta bin of the position, from the lookup if it is prepared for the current parameters
+  inline int etaBin(const Vector3D& aPosition) const {
+    int bin;
+    if (m_lookupGridSizeEta == m_gridSizeEta && m_lookupOffsetEta == m_offsetEta &&
+        m_etaLookup.find(aPosition.Z * std::abs(aPosition.Z) / (aPosition.X * aPosition.X + aPosition.Y * aPosition.Y),
+                         bin)) {
+      return bin;
+    }
+    return positionToBin(etaFromXYZ(aPosition), m_gridSizeEta, m_offsetEta);
+  }
   /// the grid size in eta
   double m_gridSizeEta;
   /// the coordinate offset in eta
   double m_offsetEta;
   /// the field name used for eta
   std::string m_etaID;
+  /// lookup of the eta bins from z|z|/(x^2+y^2), and the parameters it was prepared for
+  MonotonicBinLookup m_etaLookup;
+  double m_lookupGridSizeEta = 0;
+  double m_lookupOffsetEta = 0;
 };
 }
 }
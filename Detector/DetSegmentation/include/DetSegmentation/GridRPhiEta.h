@@ -37,6 +37,13 @@ public:
    */
   virtual CellID cellID(const Vector3D& aLocalPosition, const Vector3D& aGlobalPosition,
                         const VolumeID& aVolumeID) const;
+  /**  Determine the cell IDs of a batch of positions, as cellID for each of them.
+   *   @param[in] aGlobalPositions Positions in the global coordinates.
+   *   @param[in] aVolumeIDs IDs of the volumes (one per position).
+   *   @param[out] aCellIDs Cell IDs (resized to the number of positions).
+   */
+  virtual void cellIDs(const std::vector<Vector3D>& aGlobalPositions, const std::vector<VolumeID>& aVolumeIDs,
+                       std::vector<CellID>& aCellIDs) const;
   /**  Determine the radius based on the cell ID.
    *   @param[in] aCellId ID of a cell.
    *   return Radius.
@@ -119,15 +119,16 @@ public:
   /** \brief Returns a std::vector<double> of the cellDimensions of the given cell ID
       in natural order of dimensions (dR, dPhi, dEta)
       Returns a std::vector of the cellDimensions of the given cell ID
-      \param cellID is ignored as all cells have the same dimension
+      \param cellID is the ID of the cell (the sizes depend on the layer if the granularity is given per layer)
       \return std::vector<double> size 3:
       -# size in r
       -# size in phi
       -# size in eta
   */
-  inline std::vector<double> cellDimensions(const CellID& /*id*/) const {
-    return {access()->implementation->gridSizeR(), access()->implementation->gridSizePhi(),
-            access()->implementation->gridSizeEta()};
+  inline std::vector<double> cellDimensions(const CellID& id) const {
+    int layer = access()->implementation->layer(id);
+    return {access()->implementation->gridSizeR(), access()->implementation->gridSizePhi(layer),
+            access()->implementation->gridSizeEta(layer)};
   }
 };
 
@@ -0,0 +1,85 @@
+#ifndef DETSEGMENTATION_MONOTONICBINLOOKUP_H
+#define DETSEGMENTATION_MONOTONICBINLOOKUP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/** MonotonicBinLookup Detector/DetSegmentation/DetSegmentation/MonotonicBinLookup.h MonotonicBinLookup.h
+ *
+ *  Lookup of the bin of a coordinate from the bin boundaries transformed to another coordinate, monotonic in the
+ *  original one and cheap to calculate (e.g. z|z|/(x^2+y^2) instead of the pseudorapidity).
+ *  The range of the boundaries is divided into equal buckets, each storing the index of its first boundary, so that
+ *  the bin is found with one multiplication and a few comparisons.
+ *  The transformed boundaries are rounded, so for a coordinate within the tolerance of a boundary the lookup does
+ *  not return a bin: the caller calculates it from the original coordinate, and the result is always the same as
+ *  the binning of the original coordinate.
+ */
+
+namespace dd4hep {
+namespace DDSegmentation {
+class MonotonicBinLookup {
+public:
+  /// empty lookup, find() never returns a bin
+  MonotonicBinLookup() = default;
+  /** Constructor.
+   *  @param[in] aBoundaries Transformed boundaries of the bins, increasing. The bin between boundaries i-1 and i
+   *  is aFirstBin + i.
+   *  @param[in] aFirstBin Bin below the first boundary.
+   *  @param[in] aMin Lower end of the range of the lookup (at most the first boundary).
+   *  @param[in] aMax Upper end of the range of the lookup (at least the last boundary).
+   *  @param[in] aTolerance Relative tolerance of the transformed boundaries (scaled by max(1, |coordinate|)).
+   */
+  MonotonicBinLookup(const std::vector<double>& aBoundaries, int aFirstBin, double aMin, double aMax,
+                     double aTolerance);
+  /** Find the bin of a transformed coordinate.
+   *  @param[in] aCoordinate Transformed coordinate.
+   *  @param[out] aBin Bin (set only if found).
+   *  return True if the bin is found, false if the coordinate is outside of the range or close to a boundary.
+   */
+  inline bool find(double aCoordinate, int& aBin) const {
+    // false also for NaN
+    if (!(aCoordinate > m_min && aCoordinate < m_max)) {
+      return false;
+    }
+    std::size_t bucket = static_cast<std::size_t>((aCoordinate - m_min) * m_scale);
+    if (bucket >= m_buckets.size()) {
+      return false;
+    }
+    std::size_t index = m_buckets[bucket];
+    while (index < m_boundaries.size() && m_boundaries[index] <= aCoordinate) {
+      ++index;
+    }
+    while (index > 0 && m_boundaries[index - 1] > aCoordinate) {
+      --index;
+    }
+    const double tolerance = m_tolerance * std::max(1., std::abs(aCoordinate));
+    if ((index < m_boundaries.size() && m_boundaries[index] - aCoordinate < tolerance) ||
+        (index > 0 && aCoordinate - m_boundaries[index - 1] < tolerance)) {
+      return false;
+    }
+    aBin = m_firstBin + static_cast<int>(index);
+    return true;
+  }
+  /// True if the lookup has a range
+  inline bool empty() const { return m_buckets.empty(); }
+
+private:
+  /// transformed boundaries of the bins
+  std::vector<double> m_boundaries;
+  /// index of the first boundary not below the beginning of each bucket
+  std::vector<uint32_t> m_buckets;
+  /// bin below the first boundary
+  int m_firstBin = 0;
+  /// range of the lookup
+  double m_min = 0;
+  double m_max = 0;
+  /// number of buckets per unit of the transformed coordinate
+  double m_scale = 0;
+  /// relative tolerance of the boundaries
+  double m_tolerance = 0;
+};
+}
+}
+#endif /* DETSEGMENTATION_MONOTONICBINLOOKUP_H */
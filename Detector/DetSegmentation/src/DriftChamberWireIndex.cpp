@@ -0,0 +1,284 @@
+#include "DetSegmentation/DriftChamberWireIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace dd4hep {
+namespace DDSegmentation {
+
+namespace {
+/// maximal number of points at which the angle to the wires is evaluated along a segment
+constexpr size_t kMaxSegmentSamples = 256;
+
+inline double clamp01(double aValue) { return aValue < 0 ? 0 : (aValue > 1 ? 1 : aValue); }
+
+/// Distance of the closest approach between segments p1 + s * d1 and p2 + t * d2 (s, t in [0, 1])
+double segmentsDistance(double p1x, double p1y, double p1z, double d1x, double d1y, double d1z, double p2x,
+                        double p2y, double p2z, double d2x, double d2y, double d2z) {
+  const double eps = std::numeric_limits<double>::min();
+  double rx = p1x - p2x, ry = p1y - p2y, rz = p1z - p2z;
+  double a = d1x * d1x + d1y * d1y + d1z * d1z;
+  double e = d2x * d2x + d2y * d2y + d2z * d2z;
+  double f = d2x * rx + d2y * ry + d2z * rz;
+  double s = 0, t = 0;
+  if (a <= eps && e <= eps) {
+    s = t = 0;
+  } else if (a <= eps) {
+    t = clamp01(f / e);
+  } else {
+    double c = d1x * rx + d1y * ry + d1z * rz;
+    if (e <= eps) {
+      s = clamp01(-c / a);
+    } else {
+      double b = d1x * d2x + d1y * d2y + d1z * d2z;
+      double denom = a * e - b * b;
+      s = denom > 0 ? clamp01((b * f - c * e) / denom) : 0;
+      t = (b * s + f) / e;
+      if (t < 0) {
+        t = 0;
+        s = clamp01(-c / a);
+      } else if (t > 1) {
+        t = 1;
+        s = clamp01((b - c) / a);
+      }
+    }
+  }
+  double dx = rx + d1x * s - d2x * t;
+  double dy = ry + d1y * s - d2y * t;
+  double dz = rz + d1z * s - d2z * t;
+  return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+}
+
+struct DriftChamberWireIndex::Segment {
+  Segment(const TVector3& aStart, const TVector3& aEnd, double aStep) {
+    x0 = aStart.X(), y0 = aStart.Y(), z0 = aStart.Z();
+    dx = aEnd.X() - x0, dy = aEnd.Y() - y0, dz = aEnd.Z() - z0;
+    maxRadius = std::sqrt(std::max(x0 * x0 + y0 * y0, aEnd.X() * aEnd.X() + aEnd.Y() * aEnd.Y()));
+    // closest point to the z axis
+    double transverse2 = dx * dx + dy * dy;
+    double t = transverse2 > 0 ? clamp01(-(x0 * dx + y0 * dy) / transverse2) : 0;
+    minRadius = std::sqrt((x0 + t * dx) * (x0 + t * dx) + (y0 + t * dy) * (y0 + t * dy));
+    minZ = std::min(z0, aEnd.Z());
+    maxZ = std::max(z0, aEnd.Z());
+    double length = std::sqrt(transverse2 + dz * dz);
+    size_t numSteps = aStep > 0 ? static_cast<size_t>(std::ceil(length / aStep)) : 1;
+    numSteps = std::min(std::max(numSteps, size_t(1)), kMaxSegmentSamples);
+    halfStep = 0.5 * length / numSteps;
+    x.reserve(numSteps + 1);
+    y.reserve(numSteps + 1);
+    z.reserve(numSteps + 1);
+    for (size_t i = 0; i <= numSteps; ++i) {
+      double s = static_cast<double>(i) / numSteps;
+      x.push_back(x0 + s * dx);
+      y.push_back(y0 + s * dy);
+      z.push_back(z0 + s * dz);
+    }
+  }
+  /// start point and vector from start to end
+  double x0, y0, z0, dx, dy, dz;
+  /// ranges in radius (distance from the z axis) and in z
+  double minRadius, maxRadius, minZ, maxZ;
+  /// points at which the angle to the wires is evaluated, and half of the distance between them
+  std::vector<double> x, y, z;
+  double halfStep;
+};
+
+DriftChamberWireIndex::DriftChamberWireIndex(const GridDriftChamber& aSegmentation)
+    : m_decoder(aSegmentation.decoder()), m_phiID(aSegmentation.fieldNamePhi()) {
+  m_minWireSpacing = std::numeric_limits<double>::max();
+  for (const auto& layerWires : aSegmentation.returnAllWires()) {
+    const auto& wires = layerWires.second;
+    if (wires.empty()) {
+      continue;
+    }
+    Layer layer;
+    layer.id = layerWires.first;
+    layer.numWires = wires.size();
+    // wires cover the full azimuth, wire i is wire 0 rotated by i * gridSizePhi (as in setWiresInLayer)
+    layer.gridSizePhi = 2 * M_PI / layer.numWires;
+    // wire 0 goes from Wmid - Wdirection / 2 to Wmid + Wdirection / 2
+    TVector3 start = wires[0].first - 0.5 * wires[0].second;
+    TVector3 direction = wires[0].second;
+    layer.wire0dXdZ = direction.X() / direction.Z();
+    layer.wire0dYdZ = direction.Y() / direction.Z();
+    layer.wire0X = start.X() - layer.wire0dXdZ * start.Z();
+    layer.wire0Y = start.Y() - layer.wire0dYdZ * start.Z();
+    double slope2 = layer.wire0dXdZ * layer.wire0dXdZ + layer.wire0dYdZ * layer.wire0dYdZ;
+    double zWaist = slope2 > 0 ? -(layer.wire0X * layer.wire0dXdZ + layer.wire0Y * layer.wire0dYdZ) / slope2 : 0;
+    layer.waistRadius = std::hypot(layer.wire0X + layer.wire0dXdZ * zWaist, layer.wire0Y + layer.wire0dYdZ * zWaist);
+    layer.outerRadius = std::max(start.Perp(), (start + direction).Perp());
+    layer.invCosEpsilon = direction.Mag() / std::abs(direction.Z());
+    layer.maxPhiRate =
+        std::abs(layer.wire0X * layer.wire0dYdZ - layer.wire0Y * layer.wire0dXdZ) / std::pow(layer.waistRadius, 2);
+    layer.zMin = std::min(start.Z(), start.Z() + direction.Z());
+    layer.zMax = std::max(start.Z(), start.Z() + direction.Z());
+    for (const auto& wire : wires) {
+      TVector3 wireStart = wire.first - 0.5 * wire.second;
+      layer.startX.push_back(wireStart.X());
+      layer.startY.push_back(wireStart.Y());
+      layer.startZ.push_back(wireStart.Z());
+      layer.dirX.push_back(wire.second.X());
+      layer.dirY.push_back(wire.second.Y());
+      layer.dirZ.push_back(wire.second.Z());
+    }
+    m_maxTanEpsilon = std::max(m_maxTanEpsilon, std::sqrt(slope2));
+    m_maxInvCosEpsilon = std::max(m_maxInvCosEpsilon, layer.invCosEpsilon);
+    m_minWireSpacing = std::min(m_minWireSpacing, 2 * layer.waistRadius * std::sin(layer.gridSizePhi / 2));
+    m_numWires += layer.numWires;
+    m_layers.push_back(std::move(layer));
+  }
+  std::sort(m_layers.begin(), m_layers.end(),
+            [](const Layer& aLhs, const Layer& aRhs) { return aLhs.waistRadius < aRhs.waistRadius; });
+  double maxOuterRadius = 0;
+  for (const auto& layer : m_layers) {
+    m_waistRadii.push_back(layer.waistRadius);
+    maxOuterRadius = std::max(maxOuterRadius, layer.outerRadius);
+    m_maxOuterRadii.push_back(maxOuterRadius);
+  }
+}
+
+void DriftChamberWireIndex::collect(const Layer& aLayer, const Segment& aSegment, double aMaxDCA,
+                                    std::vector<WireMatch>& aWires) const {
+  // Point of the segment within aMaxDCA of a wire is within aMaxDCA / cos(epsilon) of the wire at the same z
+  double maxDistance = aMaxDCA * aLayer.invCosEpsilon;
+  if (aSegment.maxZ < aLayer.zMin - aMaxDCA || aSegment.minZ > aLayer.zMax + aMaxDCA) {
+    return;
+  }
+  if (aSegment.maxRadius < aLayer.waistRadius - maxDistance) {
+    return;
+  }
+  // radius of the wires is maximal at the ends, extended by the cut along z
+  double zLow = aLayer.zMin - aMaxDCA, zHigh = aLayer.zMax + aMaxDCA;
+  double xLow = aLayer.wire0X + aLayer.wire0dXdZ * zLow, yLow = aLayer.wire0Y + aLayer.wire0dYdZ * zLow;
+  double xHigh = aLayer.wire0X + aLayer.wire0dXdZ * zHigh, yHigh = aLayer.wire0Y + aLayer.wire0dYdZ * zHigh;
+  double maxWireRadius = std::sqrt(std::max(xLow * xLow + yLow * yLow, xHigh * xHigh + yHigh * yHigh));
+  if (aSegment.minRadius > maxWireRadius + maxDistance) {
+    return;
+  }
+
+  // Angular window around the segment: points at radii r1, r2 and distance d differ in phi by 2 asin(d / 2 sqrt(r1 r2))
+  bool allWires = true;
+  double minAngle = 0, maxAngle = 0;
+  double sinHalfWindow = maxDistance / (2 * std::sqrt(aSegment.minRadius * aLayer.waistRadius));
+  if (aSegment.minRadius > 0 && sinHalfWindow < 1) {
+    double window = 2 * std::asin(sinHalfWindow) + aSegment.halfStep * (1 / aSegment.minRadius + aLayer.maxPhiRate);
+    double previous = 0;
+    for (size_t i = 0; i < aSegment.x.size(); ++i) {
+      double x0 = aLayer.wire0X + aLayer.wire0dXdZ * aSegment.z[i];
+      double y0 = aLayer.wire0Y + aLayer.wire0dYdZ * aSegment.z[i];
+      // angle between the point and the wire 0 at the same z
+      double angle = std::atan2(x0 * aSegment.y[i] - y0 * aSegment.x[i], x0 * aSegment.x[i] + y0 * aSegment.y[i]);
+      if (i > 0) {
+        angle += 2 * M_PI * std::round((previous - angle) / (2 * M_PI));
+      }
+      previous = angle;
+      minAngle = i > 0 ? std::min(minAngle, angle) : angle;
+      maxAngle = i > 0 ? std::max(maxAngle, angle) : angle;
+    }
+    minAngle -= window;
+    maxAngle += window;
+    allWires = maxAngle - minAngle >= 2 * M_PI;
+  }
+
+  auto test = [&](int aWire) {
+    double dca = segmentsDistance(aSegment.x0, aSegment.y0, aSegment.z0, aSegment.dx, aSegment.dy, aSegment.dz,
+                                  aLayer.startX[aWire], aLayer.startY[aWire], aLayer.startZ[aWire],
+                                  aLayer.dirX[aWire], aLayer.dirY[aWire], aLayer.dirZ[aWire]);
+    if (dca <= aMaxDCA) {
+      aWires.push_back({aLayer.id, aWire, dca});
+    }
+  };
+  long long firstWire = std::ceil(minAngle / aLayer.gridSizePhi);
+  long long lastWire = std::floor(maxAngle / aLayer.gridSizePhi);
+  if (allWires || lastWire - firstWire + 1 >= aLayer.numWires) {
+    for (int iWire = 0; iWire < aLayer.numWires; ++iWire) {
+      test(iWire);
+    }
+  } else {
+    for (long long iWire = firstWire; iWire <= lastWire; ++iWire) {
+      long long wire = iWire % aLayer.numWires;
+      test(wire < 0 ? wire + aLayer.numWires : wire);
+    }
+  }
+}
+
+void DriftChamberWireIndex::collectAll(const Layer& aLayer, const Segment& aSegment, double aMaxDCA,
+                                       std::vector<WireMatch>& aWires) const {
+  for (int iWire = 0; iWire < aLayer.numWires; ++iWire) {
+    double dca = segmentsDistance(aSegment.x0, aSegment.y0, aSegment.z0, aSegment.dx, aSegment.dy, aSegment.dz,
+                                  aLayer.startX[iWire], aLayer.startY[iWire], aLayer.startZ[iWire],
+                                  aLayer.dirX[iWire], aLayer.dirY[iWire], aLayer.dirZ[iWire]);
+    if (dca <= aMaxDCA) {
+      aWires.push_back({aLayer.id, iWire, dca});
+    }
+  }
+}
+
+namespace {
+void sortByWire(std::vector<DriftChamberWireIndex::WireMatch>& aWires) {
+  std::sort(aWires.begin(), aWires.end(),
+            [](const DriftChamberWireIndex::WireMatch& aLhs, const DriftChamberWireIndex::WireMatch& aRhs) {
+              return aLhs.layer < aRhs.layer || (aLhs.layer == aRhs.layer && aLhs.wire < aRhs.wire);
+            });
+}
+}
+
+std::vector<DriftChamberWireIndex::WireMatch> DriftChamberWireIndex::withinDCA(const TVector3& aStart,
+                                                                               const TVector3& aEnd,
+                                                                               double aMaxDCA) const {
+  std::vector<WireMatch> wires;
+  Segment segment(aStart, aEnd, m_minWireSpacing);
+  // layers that may overlap in radius: waist radius below the maximal radius of the segment and outer radius
+  // (extended by the cut along the wire) above the minimal radius of the segment
+  auto last = std::upper_bound(m_waistRadii.begin(), m_waistRadii.end(),
+                               segment.maxRadius + aMaxDCA * m_maxInvCosEpsilon);
+  auto first = std::lower_bound(m_maxOuterRadii.begin(), m_maxOuterRadii.end(),
+                                segment.minRadius - aMaxDCA * (m_maxTanEpsilon + m_maxInvCosEpsilon));
+  for (auto iLayer = first - m_maxOuterRadii.begin(); iLayer < last - m_waistRadii.begin(); ++iLayer) {
+    collect(m_layers[iLayer], segment, aMaxDCA, wires);
+  }
+  sortByWire(wires);
+  return wires;
+}
+
+std::vector<DriftChamberWireIndex::WireMatch> DriftChamberWireIndex::withinDCAAllWires(const TVector3& aStart,
+                                                                                       const TVector3& aEnd,
+                                                                                       double aMaxDCA) const {
+  std::vector<WireMatch> wires;
+  Segment segment(aStart, aEnd, 0);
+  for (const auto& layer : m_layers) {
+    collectAll(layer, segment, aMaxDCA, wires);
+  }
+  sortByWire(wires);
+  return wires;
+}
+
+std::vector<DriftChamberWireIndex::WireMatch> DriftChamberWireIndex::kNearest(const TVector3& aStart,
+                                                                              const TVector3& aEnd, size_t aK) const {
+  std::vector<WireMatch> wires;
+  size_t numWanted = std::min(aK, m_numWires);
+  if (numWanted == 0) {
+    return wires;
+  }
+  // all the wires closer than the k-th nearest one are within the cut once at least k wires are found
+  double maxDCA = m_minWireSpacing;
+  for (wires = withinDCA(aStart, aEnd, maxDCA); wires.size() < numWanted; wires = withinDCA(aStart, aEnd, maxDCA)) {
+    maxDCA *= 2;
+  }
+  std::partial_sort(wires.begin(), wires.begin() + numWanted, wires.end(),
+                    [](const WireMatch& aLhs, const WireMatch& aRhs) { return aLhs.dca < aRhs.dca; });
+  wires.resize(numWanted);
+  return wires;
+}
+
+CellID DriftChamberWireIndex::cellID(const WireMatch& aWire, const VolumeID& aVolumeID) const {
+  CellID cID = aVolumeID;
+  // wire i is placed at the phi of bin i (GridDriftChamber::setWiresInLayer), the offset in phi included
+  m_decoder->set(cID, "layer", aWire.layer);
+  m_decoder->set(cID, m_phiID, aWire.wire);
+  return cID;
+}
+}
+}
@@ -13,6 +13,15 @@ FCCSWGridPhiEta::FCCSWGridPhiEta(const std::string& cellEncoding) : GridEta(cell
   registerParameter("phi_bins", "Number of bins phi", m_phiBins, 1);
   registerParameter("offset_phi", "Angular offset in phi", m_offsetPhi, 0., SegmentationParameter::AngleUnit, true);
   registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi");
+  registerParameter("grid_size_eta_layers", "Cell size in eta of each layer", m_gridSizeEtaLayers,
+                    std::vector<double>(), SegmentationParameter::NoUnit, true);
+  registerParameter("offset_eta_layers", "Angular offset in eta of each layer", m_offsetEtaLayers,
+                    std::vector<double>(), SegmentationParameter::NoUnit, true);
+  registerParameter("phi_bins_layers", "Number of bins phi of each layer", m_phiBinsLayers, std::vector<int>(),
+                    SegmentationParameter::NoUnit, true);
+  registerParameter("offset_phi_layers", "Angular offset in phi of each layer", m_offsetPhiLayers,
+                    std::vector<double>(), SegmentationParameter::AngleUnit, true);
+  registerIdentifier("identifier_layer", "Cell ID identifier for the layer", m_layerID, "layer");
 }
 
 FCCSWGridPhiEta::FCCSWGridPhiEta(const BitFieldCoder* decoder) : GridEta(decoder) {
@@ -24,6 +33,15 @@ FCCSWGridPhiEta::FCCSWGridPhiEta(const BitFieldCoder* decoder) : GridEta(decoder
   registerParameter("phi_bins", "Number of bins phi", m_phiBins, 1);
   registerParameter("offset_phi", "Angular offset in phi", m_offsetPhi, 0., SegmentationParameter::AngleUnit, true);
   registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi");
+  registerParameter("grid_size_eta_layers", "Cell size in eta of each layer", m_gridSizeEtaLayers,
+                    std::vector<double>(), SegmentationParameter::NoUnit, true);
+  registerParameter("offset_eta_layers", "Angular offset in eta of each layer", m_offsetEtaLayers,
+                    std::vector<double>(), SegmentationParameter::NoUnit, true);
+  registerParameter("phi_bins_layers", "Number of bins phi of each layer", m_phiBinsLayers, std::vector<int>(),
+                    SegmentationParameter::NoUnit, true);
+  registerParameter("offset_phi_layers", "Angular offset in phi of each layer", m_offsetPhiLayers,
+                    std::vector<double>(), SegmentationParameter::AngleUnit, true);
+  registerIdentifier("identifier_layer", "Cell ID identifier for the layer", m_layerID, "layer");
 }
 
 /// determine the local based on the cell ID
@@ -35,23 +53,96 @@ Vector3D FCCSWGridPhiEta::position(const CellID& cID) const {
 CellID FCCSWGridPhiEta::cellID(const Vector3D& /* localPosition */, const Vector3D& globalPosition,
                           const VolumeID& vID) const {
   CellID cID = vID;
-  double lEta = etaFromXYZ(globalPosition);
-  double lPhi = phiFromXYZ(globalPosition);
-  _decoder->set(cID, m_etaID, positionToBin(lEta, m_gridSizeEta, m_offsetEta));
-  _decoder->set(cID, m_phiID, positionToBin(lPhi, 2 * M_PI / (double)m_phiBins, m_offsetPhi));
+  int lLayer = layer(vID);
+  _decoder->set(cID, m_etaID, etaBin(globalPosition, lLayer));
+  _decoder->set(cID, m_phiID, phiBin(globalPosition, lLayer));
   return cID;
 }
 
+/// determine the cell IDs of a batch of positions
+void FCCSWGridPhiEta::cellIDs(const std::vector<Vector3D>& globalPositions, const std::vector<VolumeID>& vIDs,
+                              std::vector<CellID>& cIDs) const {
+  const BitFieldElement& etaField = (*_decoder)[m_etaID];
+  const BitFieldElement& phiField = (*_decoder)[m_phiID];
+  cIDs.resize(globalPositions.size());
+  if (hasLayerBinning()) {
+    const BitFieldElement& layerField = (*_decoder)[m_layerID];
+    for (size_t i = 0; i < globalPositions.size(); ++i) {
+      CellID cID = vIDs[i];
+      int lLayer = layerField.value(cID);
+      etaField.set(cID, etaBin(globalPositions[i], lLayer));
+      phiField.set(cID, phiBin(globalPositions[i], lLayer));
+      cIDs[i] = cID;
+    }
+    return;
+  }
+  for (size_t i = 0; i < globalPositions.size(); ++i) {
+    CellID cID = vIDs[i];
+    etaField.set(cID, etaBin(globalPositions[i]));
+    phiField.set(cID, phiBin(globalPositions[i]));
+    cIDs[i] = cID;
+  }
+}
+
+/// prepare the lookup of the eta and phi bins
+void FCCSWGridPhiEta::prepareBinningLookup() {
+  GridEta::prepareBinningLookup();
+  m_phiLookup = phiBinLookup(m_phiBins, m_offsetPhi);
+  m_lookupPhiBins = m_phiBins;
+  m_lookupOffsetPhi = m_offsetPhi;
+  // lookups of each layer, if the binning depends on the layer
+  m_layerLookups.clear();
+  for (int layer = 0; layer < numberOfLayers(); ++layer) {
+    LayerLookup lookup;
+    lookup.gridSizeEta = gridSizeEta(layer);
+    lookup.offsetEta = offsetEta(layer);
+    lookup.phiBins = phiBins(layer);
+    lookup.offsetPhi = offsetPhi(layer);
+    lookup.eta = etaBinLookup(lookup.gridSizeEta, lookup.offsetEta);
+    lookup.phi = phiBinLookup(lookup.phiBins, lookup.offsetPhi);
+    m_layerLookups.push_back(lookup);
+  }
+}
+
+/// create the lookup of the phi bins of given number and offset
+MonotonicBinLookup FCCSWGridPhiEta::phiBinLookup(int aBins, double aOffset) {
+  // boundaries between bins k-1 and k in (-pi, pi)
+  const double gridSizePhi = 2 * M_PI / (double)aBins;
+  long long firstBoundary = std::ceil((-M_PI - aOffset) / gridSizePhi + 0.5) - 1;
+  long long lastBoundary = std::floor((M_PI - aOffset) / gridSizePhi + 0.5) + 1;
+  std::vector<double> boundaries;
+  int firstBin = positionToBin(0., gridSizePhi, aOffset);
+  for (long long k = firstBoundary; k <= lastBoundary; ++k) {
+    double boundary = aOffset + (k - 0.5) * gridSizePhi;
+    if (boundary <= -M_PI || boundary >= M_PI) {
+      continue;
+    }
+    if (boundaries.empty()) {
+      firstBin = k - 1;
+    }
+    boundaries.push_back(pseudoAngle(std::cos(boundary), std::sin(boundary)));
+  }
+  return MonotonicBinLookup(boundaries, firstBin, -2, 2, 1e-9);
+}
+
 /// determine the azimuthal angle phi based on the current cell ID
 //double FCCSWGridPhiEta::phi() const {
 //  CellID phiValue = (*_decoder)[m_phiID].value();
 //  return binToPosition(phiValue, 2. * M_PI / (double)m_phiBins, m_offsetPhi);
 //}
 
+/// determine the pseudorapidity based on the cell ID
+double FCCSWGridPhiEta::eta(const CellID& cID) const {
+  CellID etaValue = _decoder->get(cID, m_etaID);
+  int lLayer = layer(cID);
+  return binToPosition(etaValue, gridSizeEta(lLayer), offsetEta(lLayer));
+}
+
 /// determine the azimuthal angle phi based on the cell ID
 double FCCSWGridPhiEta::phi(const CellID& cID) const {
   CellID phiValue = _decoder->get(cID, m_phiID);
-  return binToPosition(phiValue, 2. * M_PI / (double)m_phiBins, m_offsetPhi);
+  int lLayer = layer(cID);
+  return binToPosition(phiValue, 2. * M_PI / (double)phiBins(lLayer), offsetPhi(lLayer));
 }
 }
 }
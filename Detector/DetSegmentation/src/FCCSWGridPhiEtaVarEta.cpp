@@ -0,0 +1,118 @@
+#include "DetSegmentation/FCCSWGridPhiEtaVarEta.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace dd4hep {
+namespace DDSegmentation {
+
+/// default constructor using an encoding string
+FCCSWGridPhiEtaVarEta::FCCSWGridPhiEtaVarEta(const std::string& cellEncoding) : FCCSWGridPhiEta(cellEncoding) {
+  // define type and description
+  _type = "FCCSWGridPhiEtaVarEta";
+  _description = "Phi-eta segmentation in the global coordinates, variable bins in eta";
+
+  // register all necessary parameters (additional to those registered in FCCSWGridPhiEta)
+  registerParameter("eta_edges", "Edges of the bins in eta", m_etaEdges, std::vector<double>());
+  // the bins in eta are given by eta_edges, the cell size in eta registered by GridEta is optional
+  delete _parameters["grid_size_eta"];
+  registerParameter("grid_size_eta", "Cell size in Eta (not used)", m_gridSizeEta, 1.,
+                    SegmentationParameter::LengthUnit, true);
+}
+
+FCCSWGridPhiEtaVarEta::FCCSWGridPhiEtaVarEta(const BitFieldCoder* decoder) : FCCSWGridPhiEta(decoder) {
+  // define type and description
+  _type = "FCCSWGridPhiEtaVarEta";
+  _description = "Phi-eta segmentation in the global coordinates, variable bins in eta";
+
+  // register all necessary parameters (additional to those registered in FCCSWGridPhiEta)
+  registerParameter("eta_edges", "Edges of the bins in eta", m_etaEdges, std::vector<double>());
+  // the bins in eta are given by eta_edges, the cell size in eta registered by GridEta is optional
+  delete _parameters["grid_size_eta"];
+  registerParameter("grid_size_eta", "Cell size in Eta (not used)", m_gridSizeEta, 1.,
+                    SegmentationParameter::LengthUnit, true);
+}
+
+/// determine the local based on the cell ID
+Vector3D FCCSWGridPhiEtaVarEta::position(const CellID& cID) const {
+  return positionFromREtaPhi(1.0, eta(cID), phi(cID));
+}
+
+/// determine the cell ID based on the position
+CellID FCCSWGridPhiEtaVarEta::cellID(const Vector3D& /* localPosition */, const Vector3D& globalPosition,
+                                     const VolumeID& vID) const {
+  CellID cID = vID;
+  _decoder->set(cID, m_etaID, varEtaBin(globalPosition));
+  _decoder->set(cID, m_phiID, phiBin(globalPosition, layer(vID)));
+  return cID;
+}
+
+/// determine the cell IDs of a batch of positions
+void FCCSWGridPhiEtaVarEta::cellIDs(const std::vector<Vector3D>& globalPositions, const std::vector<VolumeID>& vIDs,
+                                    std::vector<CellID>& cIDs) const {
+  const BitFieldElement& etaField = (*_decoder)[m_etaID];
+  const BitFieldElement& phiField = (*_decoder)[m_phiID];
+  const BitFieldElement* layerField = hasLayerBinning() ? &(*_decoder)[m_layerID] : nullptr;
+  cIDs.resize(globalPositions.size());
+  for (size_t i = 0; i < globalPositions.size(); ++i) {
+    CellID cID = vIDs[i];
+    etaField.set(cID, varEtaBin(globalPositions[i]));
+    phiField.set(cID, phiBin(globalPositions[i], layerField ? layerField->value(cID) : -1));
+    cIDs[i] = cID;
+  }
+}
+
+/// prepare the lookups of the eta and phi bins
+void FCCSWGridPhiEtaVarEta::prepareBinningLookup() {
+  FCCSWGridPhiEta::prepareBinningLookup();
+  m_edgeLookup = MonotonicBinLookup();
+  m_etaLookup = MonotonicBinLookup();
+  if (m_etaEdges.size() < 2 || !std::is_sorted(m_etaEdges.begin(), m_etaEdges.end())) {
+    return;
+  }
+  // bin i is between edges i and i+1: exact lookup of eta between the first and the last edge
+  m_edgeLookup = MonotonicBinLookup(std::vector<double>(m_etaEdges.begin() + 1, m_etaEdges.end() - 1), 0,
+                                    m_etaEdges.front(), m_etaEdges.back(), 0.);
+  // lookup from the position for the edges up to |eta| = 6, as in GridEta
+  const double maxEta = 6.;
+  auto firstEdge = std::lower_bound(m_etaEdges.begin(), m_etaEdges.end(), -maxEta);
+  auto lastEdge = std::upper_bound(m_etaEdges.begin(), m_etaEdges.end(), maxEta);
+  std::vector<double> boundaries;
+  for (auto edge = firstEdge; edge != lastEdge; ++edge) {
+    double sinhEta = std::sinh(*edge);
+    boundaries.push_back(sinhEta * std::abs(sinhEta));
+  }
+  if (boundaries.size() >= 2) {
+    m_etaLookup = MonotonicBinLookup(boundaries, firstEdge - m_etaEdges.begin() - 1, boundaries.front(),
+                                     boundaries.back(), 1e-8);
+  }
+}
+
+/// determine the eta bin of a pseudorapidity
+int FCCSWGridPhiEtaVarEta::etaToBin(double aEta) const {
+  int bin;
+  if (m_edgeLookup.find(aEta, bin)) {
+    return bin;
+  }
+  if (m_etaEdges.size() < 2 || !(aEta >= m_etaEdges.front() && aEta < m_etaEdges.back())) {
+    throw std::runtime_error("Pseudorapidity " + std::to_string(aEta) + " is outside of the eta edges of " + _type);
+  }
+  return std::upper_bound(m_etaEdges.begin(), m_etaEdges.end(), aEta) - m_etaEdges.begin() - 1;
+}
+
+/// set the edges of the eta bins
+void FCCSWGridPhiEtaVarEta::setEtaEdges(const std::vector<double>& aEdges) {
+  m_etaEdges = aEdges;
+  // lookups of the previous edges are not valid
+  m_edgeLookup = MonotonicBinLookup();
+  m_etaLookup = MonotonicBinLookup();
+}
+
+/// determine the pseudorapidity (centre of the bin) based on the cell ID
+double FCCSWGridPhiEtaVarEta::eta(const CellID& cID) const {
+  CellID etaValue = _decoder->get(cID, m_etaID);
+  return 0.5 * (m_etaEdges.at(etaValue) + m_etaEdges.at(etaValue + 1));
+}
+REGISTER_SEGMENTATION(FCCSWGridPhiEtaVarEta)
+}
+}
@@ -0,0 +1,4 @@
+#include "DetSegmentation/FCCSWGridPhiEtaVarEtaHandle.h"
+#include "DD4hep/detail/Handle.inl"
+
+DD4HEP_INSTANTIATE_HANDLE_UNNAMED(dd4hep::DDSegmentation::FCCSWGridPhiEtaVarEta);
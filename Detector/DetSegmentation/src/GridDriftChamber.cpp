@@ -3,6 +3,58 @@
 namespace dd4hep {
 namespace DDSegmentation {
 
+namespace {
+/// Distances between the track segments and the wires, for GridDriftChamber::distancesTrackWire.
+/// The arrays do not overlap (restrict), so the loop can be vectorised without run-time alias checks.
+void distancesKernel(size_t numHits, const double* __restrict preX, const double* __restrict preY,
+                     const double* __restrict preZ, const double* __restrict postX, const double* __restrict postY,
+                     const double* __restrict postZ, const double* __restrict startX, const double* __restrict startY,
+                     const double* __restrict startZ, const double* __restrict dirX, const double* __restrict dirY,
+                     const double* __restrict dirZ, double* __restrict dca, double* __restrict wireX,
+                     double* __restrict wireY, double* __restrict wireZ, double* __restrict along) {
+  for (size_t i = 0; i < numHits; ++i) {
+    // a: track segment, b: wire, c: from the pre-step point to the wire start
+    double ax = postX[i] - preX[i];
+    double ay = postY[i] - preY[i];
+    double az = postZ[i] - preZ[i];
+    double bx = dirX[i];
+    double by = dirY[i];
+    double bz = dirZ[i];
+    double cx = startX[i] - preX[i];
+    double cy = startY[i] - preY[i];
+    double cz = startZ[i] - preZ[i];
+    double aa = ax * ax + ay * ay + az * az;
+    double bb = bx * bx + by * by + bz * bz;
+    double ab = ax * bx + ay * by + az * bz;
+    double ac = ax * cx + ay * cy + az * cz;
+    double bc = bx * cx + by * cy + bz * cz;
+    // |a x b|^2, zero for a track parallel to the wire or a segment of zero length
+    // (both cases are computed and selected without branches, to keep the loop vectorisable)
+    double denom = aa * bb - ab * ab;
+    bool parallel = denom <= 1e-12 * aa * bb;
+    double safeDenom = parallel ? 1. : denom;
+    double triple = cx * (ay * bz - az * by) + cy * (az * bx - ax * bz) + cz * (ax * by - ay * bx);
+    // parameter of the point of the closest approach on the wire (projection of the segment middle if parallel)
+    double tLines = (ab * ac - aa * bc) / safeDenom;
+    double tMiddle = (0.5 * ab - bc) / bb;
+    double t = parallel ? tMiddle : tLines;
+    double px = startX[i] + t * bx;
+    double py = startY[i] + t * by;
+    double pz = startZ[i] + t * bz;
+    double mx = preX[i] + 0.5 * ax - px;
+    double my = preY[i] + 0.5 * ay - py;
+    double mz = preZ[i] + 0.5 * az - pz;
+    double dca2Lines = triple * triple / safeDenom;
+    double dca2Middle = mx * mx + my * my + mz * mz;
+    dca[i] = std::sqrt(parallel ? dca2Middle : dca2Lines);
+    wireX[i] = px;
+    wireY[i] = py;
+    wireZ[i] = pz;
+    along[i] = t * std::sqrt(bb);
+  }
+}
+}
+
 /// default constructor using an encoding string
 GridDriftChamber::GridDriftChamber(const std::string& cellEncoding) : Segmentation(cellEncoding) {
   // define type and description
@@ -31,14 +83,63 @@ GridDriftChamber::GridDriftChamber(const BitFieldCoder* decoder) : Segmentation(
   registerIdentifier("identifier_phi", "Cell ID identifier for phi", m_phiID, "phi");
 }
 
-Vector3D GridDriftChamber::position(const CellID& /*cID*/) const {  //// ???? TODO
-  Vector3D cellPosition = {0, 0, 0};
-  return cellPosition;
+Vector3D GridDriftChamber::position(const CellID& cID) const {
+  long long wire = wireIndex(cID);
+  if (wire < 0) {
+    return {0, 0, 0};
+  }
+  return m_wireMidpoints[wire];
+}
+
+void GridDriftChamber::positions(const CellID* aCellIDs, size_t aNumCells, Vector3D* aPositions) const {
+  for (size_t i = 0; i < aNumCells; ++i) {
+    aPositions[i] = position(aCellIDs[i]);
+  }
+}
+
+void GridDriftChamber::setGeomParams(int layer, double sizePhi, double R, double eps) {
+  layer_params[layer] = {sizePhi, R, eps};
+
+  if (static_cast<size_t>(layer) >= m_layerConstants.size()) {
+    m_layerConstants.resize(layer + 1);
+  }
+  LayerConstants& constants = m_layerConstants[layer];
+  constants.gridSizePhi = sizePhi;
+  constants.radius = R;
+  constants.epsilon = eps;
+  constants.alpha = 2 * std::asin(m_detectorLength * std::tan(eps) / (2 * R));
+  constants.cosAlpha = std::cos(constants.alpha);
+  constants.sinAlpha = std::sin(constants.alpha);
+  constants.isSet = true;
+  if (static_cast<unsigned int>(layer) > m_lastLayer || !m_layerConstants[m_lastLayer].isSet) {
+    m_lastLayer = layer;
+  }
+
+  m_layerIndex = _decoder->index("layer");
+  m_phiIndex = _decoder->index(m_phiID);
 }
 
 CellID GridDriftChamber::cellID(const Vector3D& /*localPosition*/, const Vector3D& globalPosition,
                                 const VolumeID& vID) const {
+  CellID cID = vID;
+  const LayerConstants& constants = layerConstants(_decoder->get(vID, m_layerIndex));
+
+  // same operations as cellIDReference (identical cell IDs), with the constants of the layer precomputed:
+  // angle between the hit and the wire 0 at the same z, in [0, 2pi)
+  double t = 0.5 * (1 - 2.0 * globalPosition.Z / m_detectorLength);
+  Vector3D wire0(constants.radius * (1 + t * (constants.cosAlpha - 1)), constants.radius * t * constants.sinAlpha,
+                 globalPosition.Z);
+  double lphi = phiFromXY(globalPosition) - phiFromXY(wire0);
+  if (lphi < 0) {
+    lphi += 2 * M_PI;
+  }
+
+  _decoder->set(cID, m_phiIndex, positionToBin(lphi, constants.gridSizePhi, m_offsetPhi));
+  return cID;
+}
 
+CellID GridDriftChamber::cellIDReference(const Vector3D& /*localPosition*/, const Vector3D& globalPosition,
+                                         const VolumeID& vID) const {
   CellID cID = vID;
   unsigned int layerID = _decoder->get(vID, "layer");
   updateParams(layerID);
@@ -61,6 +162,42 @@ double GridDriftChamber::phi(const CellID& cID) const {
   return binToPosition(phiValue, _currentGridSizePhi, m_offsetPhi);
 }
 
+void GridDriftChamber::distancesTrackWire(const DriftChamberSegments& aSegments,
+                                          DriftChamberDistances& aDistances) const {
+  const size_t numHits = aSegments.size();
+  aDistances.resize(numHits);
+  // Gather the wires of the hits, a wire along z for unknown layers (the result is overwritten below)
+  std::vector<size_t> unknown;
+  for (size_t i = 0; i < numHits; ++i) {
+    long long wire = wireIndex(aSegments.cellID[i]);
+    if (wire < 0) {
+      unknown.push_back(i);
+    }
+    aDistances.wireStartX[i] = wire < 0 ? 0 : m_wireStartX[wire];
+    aDistances.wireStartY[i] = wire < 0 ? 0 : m_wireStartY[wire];
+    aDistances.wireStartZ[i] = wire < 0 ? 0 : m_wireStartZ[wire];
+    aDistances.wireDirX[i] = wire < 0 ? 0 : m_wireDirX[wire];
+    aDistances.wireDirY[i] = wire < 0 ? 0 : m_wireDirY[wire];
+    aDistances.wireDirZ[i] = wire < 0 ? 1 : m_wireDirZ[wire];
+  }
+
+  distancesKernel(numHits, aSegments.preX.data(), aSegments.preY.data(), aSegments.preZ.data(),
+                  aSegments.postX.data(), aSegments.postY.data(), aSegments.postZ.data(),
+                  aDistances.wireStartX.data(), aDistances.wireStartY.data(), aDistances.wireStartZ.data(),
+                  aDistances.wireDirX.data(), aDistances.wireDirY.data(), aDistances.wireDirZ.data(),
+                  aDistances.dca.data(), aDistances.wireX.data(), aDistances.wireY.data(), aDistances.wireZ.data(),
+                  aDistances.distanceAlongWire.data());
+
+  for (size_t i : unknown) {
+    aDistances.dca[i] = -1;
+    aDistances.wireX[i] = 0;
+    aDistances.wireY[i] = 0;
+    aDistances.wireZ[i] = 0;
+    aDistances.distanceAlongWire[i] = 0;
+    aDistances.wireDirZ[i] = 0;
+  }
+}
+
 // Distance between a particle track and a wire
 double GridDriftChamber::distanceTrackWire(const CellID& cID, const TVector3& hit_start,
                                            const TVector3& hit_end) const {
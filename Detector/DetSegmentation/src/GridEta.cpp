@@ -1,5 +1,7 @@
 #include "DetSegmentation/GridEta.h"
 
+#include <algorithm>
+
 namespace dd4hep {
 namespace DDSegmentation {
 
@@ -34,11 +36,49 @@ Vector3D GridEta::position(const CellID& cID) const {
 /// determine the cell ID based on the position
 CellID GridEta::cellID(const Vector3D& /* localPosition */, const Vector3D& globalPosition, const VolumeID& vID) const {
   CellID cID = vID;
-  double lEta = etaFromXYZ(globalPosition);
-  _decoder->set(cID, m_etaID, positionToBin(lEta, m_gridSizeEta, m_offsetEta));
+  _decoder->set(cID, m_etaID, etaBin(globalPosition));
   return cID;
 }
 
+/// determine the cell IDs of a batch of positions
+void GridEta::cellIDs(const std::vector<Vector3D>& globalPositions, const std::vector<VolumeID>& vIDs,
+                      std::vector<CellID>& cIDs) const {
+  const BitFieldElement& etaField = (*_decoder)[m_etaID];
+  cIDs.resize(globalPositions.size());
+  for (size_t i = 0; i < globalPositions.size(); ++i) {
+    CellID cID = vIDs[i];
+    etaField.set(cID, etaBin(globalPositions[i]));
+    cIDs[i] = cID;
+  }
+}
+
+/// prepare the lookup of the eta bins
+void GridEta::prepareBinningLookup() {
+  m_etaLookup = etaBinLookup(m_gridSizeEta, m_offsetEta);
+  m_lookupGridSizeEta = m_gridSizeEta;
+  m_lookupOffsetEta = m_offsetEta;
+}
+
+/// create the lookup of the eta bins of given size and offset
+MonotonicBinLookup GridEta::etaBinLookup(double aGridSize, double aOffset) const {
+  // boundaries between bins k-1 and k within the range of the field, up to |eta| = 6 (the lookup is not precise
+  // enough at larger eta, where the pseudorapidity is calculated)
+  const double maxEta = 6.;
+  const BitFieldElement& etaField = (*_decoder)[m_etaID];
+  long long firstBoundary =
+      std::max<long long>(etaField.minValue() + 1, std::ceil((-maxEta - aOffset) / aGridSize + 0.5));
+  long long lastBoundary = std::min<long long>(etaField.maxValue(), std::floor((maxEta - aOffset) / aGridSize + 0.5));
+  std::vector<double> boundaries;
+  for (long long k = firstBoundary; k <= lastBoundary; ++k) {
+    double sinhEta = std::sinh(aOffset + (k - 0.5) * aGridSize);
+    boundaries.push_back(sinhEta * std::abs(sinhEta));
+  }
+  if (boundaries.size() < 2) {
+    return MonotonicBinLookup();
+  }
+  return MonotonicBinLookup(boundaries, firstBoundary - 1, boundaries.front(), boundaries.back(), 1e-8);
+}
+
 /// determine the pseudorapidity based on the current cell ID
 //double GridEta::eta() const {
 //  CellID etaValue = (*_decoder)[m_etaID].value();
@@ -38,14 +38,31 @@ CellID GridRPhiEta::cellID(const Vector3D& /* localPosition */, const Vector3D&
                            const VolumeID& vID) const {
   CellID cID = vID;
   double lRadius = radiusFromXYZ(globalPosition);
-  double lEta = etaFromXYZ(globalPosition);
-  double lPhi = phiFromXYZ(globalPosition);
-  _decoder->set(cID, m_etaID, positionToBin(lEta, m_gridSizeEta, m_offsetEta));
-  _decoder->set(cID, m_phiID, positionToBin(lPhi, 2 * M_PI / (double)m_phiBins, m_offsetPhi));
+  int lLayer = layer(vID);
+  _decoder->set(cID, m_etaID, etaBin(globalPosition, lLayer));
+  _decoder->set(cID, m_phiID, phiBin(globalPosition, lLayer));
   _decoder->set(cID, m_rID, positionToBin(lRadius, m_gridSizeR, m_offsetR));
   return cID;
 }
 
+/// determine the cell IDs of a batch of positions
+void GridRPhiEta::cellIDs(const std::vector<Vector3D>& globalPositions, const std::vector<VolumeID>& vIDs,
+                          std::vector<CellID>& cIDs) const {
+  const BitFieldElement& etaField = (*_decoder)[m_etaID];
+  const BitFieldElement& phiField = (*_decoder)[m_phiID];
+  const BitFieldElement& rField = (*_decoder)[m_rID];
+  const BitFieldElement* layerField = hasLayerBinning() ? &(*_decoder)[m_layerID] : nullptr;
+  cIDs.resize(globalPositions.size());
+  for (size_t i = 0; i < globalPositions.size(); ++i) {
+    CellID cID = vIDs[i];
+    int lLayer = layerField ? layerField->value(cID) : -1;
+    etaField.set(cID, etaBin(globalPositions[i], lLayer));
+    phiField.set(cID, phiBin(globalPositions[i], lLayer));
+    rField.set(cID, positionToBin(radiusFromXYZ(globalPositions[i]), m_gridSizeR, m_offsetR));
+    cIDs[i] = cID;
+  }
+}
+
 /// determine the radial distance R based on the current cell ID
 //double GridRPhiEta::r() const {
 //  CellID rValue = (*_decoder)[m_rID].value();
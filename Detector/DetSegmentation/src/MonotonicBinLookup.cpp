@@ -0,0 +1,39 @@
+#include "DetSegmentation/MonotonicBinLookup.h"
+
+#include <algorithm>
+
+namespace dd4hep {
+namespace DDSegmentation {
+namespace {
+/// maximal number of buckets of a lookup
+const std::size_t kMaxBuckets = 1 << 18;
+}
+
+MonotonicBinLookup::MonotonicBinLookup(const std::vector<double>& aBoundaries, int aFirstBin, double aMin,
+                                       double aMax, double aTolerance)
+    : m_boundaries(aBoundaries), m_firstBin(aFirstBin), m_min(aMin), m_max(aMax), m_tolerance(aTolerance) {
+  if (!(m_max > m_min)) {
+    return;
+  }
+  // buckets of half of the narrowest bin, so that most of them contain at most one boundary
+  double narrowest = m_max - m_min;
+  double previous = m_min;
+  for (auto boundary : m_boundaries) {
+    if (boundary > previous) {
+      narrowest = std::min(narrowest, boundary - previous);
+    }
+    previous = boundary;
+  }
+  if (m_max > previous) {
+    narrowest = std::min(narrowest, m_max - previous);
+  }
+  double numBuckets = std::ceil(2 * (m_max - m_min) / narrowest);
+  m_buckets.resize(std::min(kMaxBuckets, static_cast<std::size_t>(std::max(1., numBuckets))));
+  m_scale = m_buckets.size() / (m_max - m_min);
+  for (std::size_t iBucket = 0; iBucket < m_buckets.size(); ++iBucket) {
+    double start = m_min + iBucket / m_scale;
+    m_buckets[iBucket] = std::upper_bound(m_boundaries.begin(), m_boundaries.end(), start) - m_boundaries.begin();
+  }
+}
+}
+}
@@ -14,6 +14,9 @@ DECLARE_SEGMENTATION(GridEta, create_segmentation<dd4hep::DDSegmentation::GridEt
 #include "DetSegmentation/FCCSWGridPhiEta.h"
 DECLARE_SEGMENTATION(FCCSWGridPhiEta, create_segmentation<dd4hep::DDSegmentation::FCCSWGridPhiEta>)
 
+#include "DetSegmentation/FCCSWGridPhiEtaVarEta.h"
+DECLARE_SEGMENTATION(FCCSWGridPhiEtaVarEta, create_segmentation<dd4hep::DDSegmentation::FCCSWGridPhiEtaVarEta>)
+
 #include "DetSegmentation/GridRPhiEta.h"
 DECLARE_SEGMENTATION(GridRPhiEta, create_segmentation<dd4hep::DDSegmentation::GridRPhiEta>)
 
@@ -0,0 +1,141 @@
+// FCCSW
+#include "DetSegmentation/DriftChamberWireIndex.h"
+#include "DetSegmentation/GridDriftChamber.h"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/** DriftChamberWireIndexTest Detector/DetSegmentation/tests/DriftChamberWireIndexTest.cpp
+ *
+ *  Test of the spatial index of the drift chamber wires (DriftChamberWireIndex) against the test of all the wires.
+ *  The IDEA drift chamber is created without loading any geometry, without and with an offset in phi.
+ *  For random track segments (fixed seed) of different lengths (from zero to longer than the chamber, including the
+ *  segments parallel to the wires), withinDCA must find the same wires as withinDCAAllWires for several cuts, and
+ *  kNearest the closest wires of the whole chamber. The cell ID of each found wire must give back the position of
+ *  the wire (GridDriftChamber::position).
+ *  The timing of the queries is measured by SegmentationBenchmark (bench/).
+ *  Returns 1 if any query differs.
+ *
+ *  Usage: DriftChamberWireIndexTest [<segments>]
+ */
+
+using dd4hep::DDSegmentation::CellID;
+using dd4hep::DDSegmentation::DriftChamberWireIndex;
+
+namespace {
+/// Compare the wires found by two queries (layer and number of the wire, in the same order)
+bool sameWires(const std::vector<DriftChamberWireIndex::WireMatch>& aWires,
+               const std::vector<DriftChamberWireIndex::WireMatch>& aOtherWires) {
+  if (aWires.size() != aOtherWires.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < aWires.size(); ++i) {
+    if (aWires[i].layer != aOtherWires[i].layer || aWires[i].wire != aOtherWires[i].wire) {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t numSegments = argc > 1 ? std::stoul(argv[1]) : 300;
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+
+  // IDEA drift chamber: 14 superlayers of 8 layers, parameters as in Detector/DetFCCeeIDEA/compact/DriftChamber.xml
+  const int numSuperLayers = 14;
+  const int numRings = 8;
+  const double r0 = 34.5;
+  const double cellSize = 1.2;
+  const double halfLength = 225.;
+  const double alpha = 30. / 180. * M_PI;
+  const double rMax = r0 + numSuperLayers * numRings * cellSize;
+  const std::vector<double> lengths = {0., 0.5 * cellSize, cellSize, 10 * cellSize, 400.};
+  const std::vector<double> cuts = {0.5 * cellSize, cellSize, 3 * cellSize};
+  const std::size_t numNearest = 3;
+
+  std::size_t numWrongQueries = 0;
+  std::size_t numWrongCellIDs = 0;
+  std::size_t numQueries = 0;
+  std::size_t numFound = 0;
+  for (double offsetPhi : {0., 0.002}) {
+    dd4hep::DDSegmentation::GridDriftChamber segmentation("system:1,layer:16,phi:16");
+    segmentation.parameter("inner_radius")->setValue(std::to_string(r0));
+    segmentation.parameter("cell_size")->setValue(std::to_string(cellSize));
+    segmentation.parameter("detector_length")->setValue(std::to_string(2 * halfLength));
+    segmentation.parameter("offset_phi")->setValue(std::to_string(offsetPhi));
+    for (int superlayer = 0; superlayer < numSuperLayers; superlayer++) {
+      for (int iring = 0; iring < numRings; iring++) {
+        int layer = superlayer * numRings + iring;
+        int numWire = 192 + superlayer * 48;
+        double R_i0 = r0 + layer * cellSize;
+        double R_i = R_i0 / std::cos(alpha / 2.0);
+        double eps = (layer % 2 ? -1 : 1) * std::atan(2 * R_i0 * std::tan(alpha / 2.0) / (halfLength * 2.0));
+        segmentation.setGeomParams(layer, 2.0 * M_PI / double(numWire), R_i, eps);
+        segmentation.setWiresInLayer(layer, numWire);
+      }
+    }
+    const auto& allWires = segmentation.returnAllWires();
+    DriftChamberWireIndex wireIndex(segmentation);
+    CellID volumeID = 0;
+    segmentation.decoder()->set(volumeID, "system", 1);
+
+    for (std::size_t iSegment = 0; iSegment < numSegments; ++iSegment) {
+      // start inside (or just outside) the chamber, random direction, every fifth segment parallel to the z axis
+      double phi = 2 * M_PI * uniform(generator);
+      double r = r0 - 2 + (rMax - r0 + 4) * uniform(generator);
+      TVector3 start(r * std::cos(phi), r * std::sin(phi), (2 * uniform(generator) - 1) * (halfLength + 5));
+      double cosTheta = iSegment % 5 == 0 ? 1 : 2 * uniform(generator) - 1;
+      double direction = 2 * M_PI * uniform(generator);
+      double sinTheta = std::sqrt(1 - cosTheta * cosTheta);
+      double length = lengths[iSegment % lengths.size()];
+      TVector3 end =
+          start + length * TVector3(sinTheta * std::cos(direction), sinTheta * std::sin(direction), cosTheta);
+
+      for (double cut : cuts) {
+        auto found = wireIndex.withinDCA(start, end, cut);
+        numWrongQueries += !sameWires(found, wireIndex.withinDCAAllWires(start, end, cut));
+        numQueries++;
+        numFound += found.size();
+        for (const auto& match : found) {
+          auto position = segmentation.position(wireIndex.cellID(match, volumeID));
+          const auto& midpoint = allWires.at(match.layer)[match.wire].first;
+          numWrongCellIDs +=
+              std::hypot(position.X - midpoint.X(), position.Y - midpoint.Y(), position.Z - midpoint.Z()) > 1e-9;
+        }
+      }
+      // nearest wires of the whole chamber, ordered by the distance
+      auto nearest = wireIndex.kNearest(start, end, numNearest);
+      auto all = wireIndex.withinDCAAllWires(start, end, 1e9);
+      std::sort(all.begin(), all.end(), [](const auto& aLhs, const auto& aRhs) { return aLhs.dca < aRhs.dca; });
+      all.resize(std::min(all.size(), numNearest));
+      numWrongQueries += !sameWires(nearest, all);
+      numQueries++;
+    }
+  }
+
+  int numFailed = 0;
+  std::cout << "DriftChamberWireIndex::withinDCA/kNearest vs all wires: " << numWrongQueries << " errors in "
+            << numQueries << " queries (" << numFound << " wires found)" << std::endl;
+  if (numWrongQueries > 0) {
+    std::cerr << "DriftChamberWireIndex differs from the test of all the wires" << std::endl;
+    numFailed++;
+  }
+  std::cout << "DriftChamberWireIndex::cellID vs wire position: " << numWrongCellIDs << " errors" << std::endl;
+  if (numWrongCellIDs > 0) {
+    std::cerr << "Cell ID of the wire does not give the position of the wire" << std::endl;
+    numFailed++;
+  }
+
+  if (numFailed > 0) {
+    std::cerr << numFailed << " check(s) failed" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,253 @@
+// FCCSW
+#include "DetSegmentation/FCCSWGridPhiEta.h"
+#include "DetSegmentation/FCCSWGridPhiEtaVarEta.h"
+#include "DetSegmentation/GridEta.h"
+#include "DetSegmentation/GridRPhiEta.h"
+
+// std
+#include <cmath>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/** SegmentationLookupTest Detector/DetSegmentation/tests/SegmentationLookupTest.cpp
+ *
+ *  Test of the binning lookup (prepareBinningLookup) of the segmentations of the GridEta family and of the
+ *  granularity of each layer of FCCSWGridPhiEta.
+ *  The cell IDs calculated with the lookup are compared with the ones calculated from the angles, for random points
+ *  (fixed seed), points at (and next to) the bin boundaries, on the axes and at large eta (beyond the range of the
+ *  lookup). Points out of the range of the eta field must be rejected with and without the lookup.
+ *  FCCSWGridPhiEta with the granularity of each layer (as the readout ECalBarrelPhiEtaLayers) is compared with the
+ *  segmentations of the granularity of one layer, with and without the lookup, single and batched.
+ *  The timing of these methods is measured by SegmentationBenchmark (bench/).
+ *  Returns 1 if any cell ID differs.
+ *
+ *  Usage: SegmentationLookupTest [<points>]
+ */
+
+using dd4hep::DDSegmentation::CellID;
+using dd4hep::DDSegmentation::Vector3D;
+
+namespace {
+/** Calculate the cell ID of a point.
+ *  @param[in] aSeg Segmentation.
+ *  @param[in] aPoint Global position.
+ *  @param[in] aVolumeID Volume ID.
+ *  @param[out] aCellID Cell ID (unchanged if the point is out of the range of the fields).
+ *  return False if the point is out of the range of the fields.
+ */
+bool cellID(const dd4hep::DDSegmentation::Segmentation& aSeg, const Vector3D& aPoint, CellID aVolumeID,
+            CellID& aCellID) {
+  try {
+    aCellID = aSeg.cellID(aPoint, aPoint, aVolumeID);
+  } catch (const std::exception&) {
+    return false;
+  }
+  return true;
+}
+
+/** Compare the cell IDs of a point calculated by two segmentations.
+ *  return True if both give the same cell ID or both reject the point.
+ */
+bool sameCellID(const dd4hep::DDSegmentation::Segmentation& aSeg,
+                const dd4hep::DDSegmentation::Segmentation& aOtherSeg, const Vector3D& aPoint, CellID aVolumeID) {
+  CellID id = 0, otherID = 0;
+  bool inRange = cellID(aSeg, aPoint, aVolumeID, id);
+  bool otherInRange = cellID(aOtherSeg, aPoint, aVolumeID, otherID);
+  return inRange == otherInRange && id == otherID;
+}
+}
+
+int main(int argc, char* argv[]) {
+  const std::size_t numPoints = argc > 1 ? std::stoul(argv[1]) : 100000;
+  std::mt19937_64 generator(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+
+  // FCC-hh ECal barrel: eta-phi segmentations (calorimeter volume between R = 190 cm and R = 265 cm), without and
+  // with the binning lookup
+  const std::string caloEncoding = "system:4,cryo:1,type:3,subtype:3,layer:8,eta:9,phi:10";
+  dd4hep::DDSegmentation::GridEta gridEta(caloEncoding), gridEtaLookup(caloEncoding);
+  for (auto* seg : {&gridEta, &gridEtaLookup}) {
+    seg->setGridSizeEta(0.01);
+    seg->setOffsetEta(-1.68024);
+  }
+  dd4hep::DDSegmentation::FCCSWGridPhiEta gridPhiEta(caloEncoding), gridPhiEtaLookup(caloEncoding);
+  for (auto* seg : {&gridPhiEta, &gridPhiEtaLookup}) {
+    seg->setGridSizeEta(0.01);
+    seg->setOffsetEta(-1.68024);
+    seg->setPhiBins(704);
+    seg->setOffsetPhi(-M_PI + M_PI / 704.);
+  }
+  const std::string caloREncoding = "system:4,cryo:1,type:3,subtype:3,r:8,eta:9,phi:10";
+  dd4hep::DDSegmentation::GridRPhiEta gridRPhiEta(caloREncoding), gridRPhiEtaLookup(caloREncoding);
+  for (auto* seg : {&gridRPhiEta, &gridRPhiEtaLookup}) {
+    seg->setGridSizeEta(0.01);
+    seg->setOffsetEta(-1.68024);
+    seg->setPhiBins(704);
+    seg->setOffsetPhi(-M_PI + M_PI / 704.);
+    seg->setGridSizeR(5.);
+    seg->setOffsetR(190.);
+  }
+  // variable eta bins: 0.01 in |eta| < 1, 0.02 up to |eta| = 1.68
+  std::vector<double> etaEdges;
+  for (int i = -84; i <= 84; ++i) {
+    etaEdges.push_back(i * 0.02);
+    if (std::abs(i) < 50) {
+      etaEdges.push_back(i * 0.02 + 0.01);
+    }
+  }
+  dd4hep::DDSegmentation::FCCSWGridPhiEtaVarEta gridVarEta(caloEncoding), gridVarEtaLookup(caloEncoding);
+  for (auto* seg : {&gridVarEta, &gridVarEtaLookup}) {
+    seg->setEtaEdges(etaEdges);
+    seg->setPhiBins(704);
+    seg->setOffsetPhi(-M_PI + M_PI / 704.);
+  }
+  gridEtaLookup.prepareBinningLookup();
+  gridPhiEtaLookup.prepareBinningLookup();
+  gridRPhiEtaLookup.prepareBinningLookup();
+  gridVarEtaLookup.prepareBinningLookup();
+
+  // granularity of each layer, as the readout ECalBarrelPhiEtaLayers: eta strips in the second layer, coarser phi in
+  // the last two layers, and the segmentations of the granularity of one layer
+  const std::string caloLayersEncoding = "system:4,cryo:1,type:3,subtype:3,layer:8,eta:11,phi:10";
+  const std::vector<double> layerGridSizeEta = {0.01, 0.0025, 0.01, 0.01, 0.01, 0.01, 0.01, 0.01};
+  const std::vector<double> layerOffsetEta = {-1.68024, -1.68399, -1.68024, -1.68024,
+                                              -1.68024, -1.68024, -1.68024, -1.68024};
+  const std::vector<int> layerPhiBins = {704, 704, 704, 704, 704, 704, 352, 352};
+  std::vector<double> layerOffsetPhi;
+  for (int bins : layerPhiBins) {
+    layerOffsetPhi.push_back(-M_PI + M_PI / bins);
+  }
+  dd4hep::DDSegmentation::FCCSWGridPhiEta gridPhiEtaLayers(caloLayersEncoding),
+      gridPhiEtaLayersLookup(caloLayersEncoding);
+  for (auto* seg : {&gridPhiEtaLayers, &gridPhiEtaLayersLookup}) {
+    seg->setGridSizeEta(0.01);
+    seg->setOffsetEta(-1.68024);
+    seg->setPhiBins(704);
+    seg->setOffsetPhi(-M_PI + M_PI / 704.);
+    seg->setGridSizeEtaLayers(layerGridSizeEta);
+    seg->setOffsetEtaLayers(layerOffsetEta);
+    seg->setPhiBinsLayers(layerPhiBins);
+    seg->setOffsetPhiLayers(layerOffsetPhi);
+  }
+  gridPhiEtaLayersLookup.prepareBinningLookup();
+  std::vector<std::unique_ptr<dd4hep::DDSegmentation::FCCSWGridPhiEta>> gridPhiEtaOfLayer;
+  for (std::size_t layer = 0; layer < layerPhiBins.size(); ++layer) {
+    gridPhiEtaOfLayer.emplace_back(new dd4hep::DDSegmentation::FCCSWGridPhiEta(caloLayersEncoding));
+    gridPhiEtaOfLayer.back()->setGridSizeEta(layerGridSizeEta[layer]);
+    gridPhiEtaOfLayer.back()->setOffsetEta(layerOffsetEta[layer]);
+    gridPhiEtaOfLayer.back()->setPhiBins(layerPhiBins[layer]);
+    gridPhiEtaOfLayer.back()->setOffsetPhi(layerOffsetPhi[layer]);
+  }
+
+  // Points: random points in the calorimeter volume, points at the bin boundaries of eta (up to the range of the
+  // field) and phi, next to them (one ulp of the coordinates), on the axes and at large eta
+  const auto& decoder = *gridEta.decoder();
+  CellID volumeID = 0;
+  decoder.set(volumeID, "system", 5);
+  std::vector<Vector3D> points;
+  auto addPoint = [&](double aX, double aY, double aZ) {
+    for (double x : {aX, std::nextafter(aX, -1e300), std::nextafter(aX, 1e300)}) {
+      for (double z : {aZ, std::nextafter(aZ, -1e300), std::nextafter(aZ, 1e300)}) {
+        points.emplace_back(x, aY, z);
+      }
+    }
+  };
+  for (std::size_t i = 0; i < numPoints; ++i) {
+    double phi = (2 * uniform(generator) - 1) * M_PI;
+    double eta = (2 * uniform(generator) - 1) * 1.6;
+    double r = 190. + 75. * uniform(generator);
+    points.emplace_back(r * std::cos(phi), r * std::sin(phi), r * std::sinh(eta));
+  }
+  const double gridSizePhi = 2 * M_PI / 704.;
+  for (int k = -260; k <= 260; ++k) {
+    double eta = -1.68024 + (k - 0.5) * 0.01;
+    double phi = -M_PI + M_PI / 704. + (k - 0.5) * gridSizePhi;
+    double r = 190. + 75. * uniform(generator);
+    addPoint(r * std::cos(phi), r * std::sin(phi), r * std::sinh(eta));
+    addPoint(r, 0., r * std::sinh(eta));
+  }
+  for (int k = -700; k <= 700; ++k) {
+    double eta = -1.68399 + (k - 0.5) * 0.0025;
+    double phi = -M_PI + M_PI / 352. + (k - 0.5) * 2 * M_PI / 352.;
+    double r = 190. + 75. * uniform(generator);
+    addPoint(r * std::cos(phi), r * std::sin(phi), r * std::sinh(eta));
+  }
+  for (double edge : etaEdges) {
+    double phi = (2 * uniform(generator) - 1) * M_PI;
+    double r = 190. + 75. * uniform(generator);
+    addPoint(r * std::cos(phi), r * std::sin(phi), r * std::sinh(edge));
+  }
+  for (std::size_t i = 0; i < numPoints / 10; ++i) {
+    double phi = (2 * uniform(generator) - 1) * M_PI;
+    double eta = (2 * uniform(generator) - 1) * 8.;
+    addPoint(std::cos(phi), std::sin(phi), std::sinh(eta));
+  }
+  for (double z : {-1., -0., 0., 1.}) {
+    for (double y : {-1., -0., 0., 1.}) {
+      addPoint(-1., y, z);
+      addPoint(1., y, z);
+      addPoint(0., y, z);
+    }
+  }
+
+  int numFailed = 0;
+  // Binning lookup against the binning of the angles
+  std::size_t numWrongLookups = 0;
+  for (const auto& point : points) {
+    numWrongLookups += !sameCellID(gridEta, gridEtaLookup, point, volumeID) +
+                       !sameCellID(gridPhiEta, gridPhiEtaLookup, point, volumeID) +
+                       !sameCellID(gridRPhiEta, gridRPhiEtaLookup, point, volumeID) +
+                       !sameCellID(gridVarEta, gridVarEtaLookup, point, volumeID);
+  }
+  std::cout << "GridEta/FCCSWGridPhiEta/GridRPhiEta/FCCSWGridPhiEtaVarEta::cellID with vs without lookup: "
+            << numWrongLookups << " errors in " << points.size() << " points" << std::endl;
+  if (numWrongLookups > 0) {
+    std::cerr << "Binning lookup differs from the binning of the angles" << std::endl;
+    numFailed++;
+  }
+
+  // Granularity of each layer against the segmentation of the granularity of that layer: cell IDs (with and without
+  // the lookup, single and batched) and the eta and phi of the cells
+  std::size_t numWrongLayerCellIDs = 0;
+  std::vector<Vector3D> batchPoints;
+  std::vector<CellID> batchVolumeIDs, batchCellIDs;
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    const auto& point = points[i];
+    const int layer = i % layerPhiBins.size();
+    CellID layerVolumeID = volumeID;
+    decoder.set(layerVolumeID, "layer", layer);
+    const auto& gridOfLayer = *gridPhiEtaOfLayer[layer];
+    bool same = sameCellID(gridOfLayer, gridPhiEtaLayers, point, layerVolumeID) &&
+                sameCellID(gridOfLayer, gridPhiEtaLayersLookup, point, layerVolumeID);
+    CellID id = 0;
+    if (same && cellID(gridOfLayer, point, layerVolumeID, id)) {
+      same = gridPhiEtaLayers.eta(id) == gridOfLayer.eta(id) && gridPhiEtaLayers.phi(id) == gridOfLayer.phi(id);
+      batchPoints.push_back(point);
+      batchVolumeIDs.push_back(layerVolumeID);
+    }
+    numWrongLayerCellIDs += !same;
+  }
+  gridPhiEtaLayersLookup.cellIDs(batchPoints, batchVolumeIDs, batchCellIDs);
+  for (std::size_t i = 0; i < batchPoints.size(); ++i) {
+    int layer = decoder.get(batchVolumeIDs[i], "layer");
+    numWrongLayerCellIDs +=
+        batchCellIDs[i] != gridPhiEtaOfLayer[layer]->cellID(batchPoints[i], batchPoints[i], batchVolumeIDs[i]);
+  }
+  std::cout << "FCCSWGridPhiEta::cellID with the granularity of each layer vs of one layer: " << numWrongLayerCellIDs
+            << " errors in " << points.size() + batchPoints.size() << " points" << std::endl;
+  if (numWrongLayerCellIDs > 0) {
+    std::cerr << "Granularity of each layer differs from the segmentation of the layer" << std::endl;
+    numFailed++;
+  }
+
+  if (numFailed > 0) {
+    std::cerr << numFailed << " check(s) failed" << std::endl;
+    return 1;
+  }
+  return 0;
+}
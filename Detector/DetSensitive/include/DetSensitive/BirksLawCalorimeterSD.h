@@ -4,6 +4,9 @@
 // DD4hep
 #include "DDG4/Geant4Hits.h"
 
+// FCCSW
+#include "DetSensitive/SDInstrumentation.h"
+
 // Geant
 #include "G4THitsCollection.hh"
 #include "G4VSensitiveDetector.hh"
@@ -53,12 +56,19 @@ public:
    *  @param aStep Step in which particle deposited the energy.
    */
   virtual bool ProcessHits(G4Step* aStep, G4TouchableHistory*) final;
+  /** End of event.
+   *  Flushes the hot-path counters (if instrumentation is enabled).
+   *  @param aHitsCollections Geant hits collection.
+   */
+  virtual void EndOfEvent(G4HCofThisEvent* aHitsCollections) final;
 
 private:
   /// Collection of calorimeter hits
   G4THitsCollection<k4::Geant4CaloHit>* m_calorimeterCollection;
   /// Segmentation of the detector used to retrieve the cell Ids
   dd4hep::Segmentation m_seg;
+  /// Hot-path counters (empty unless compiled with instrumentation)
+  SDCounters m_counters;
   // Variables needed for the calculation of birks law
   const std::string m_material;
   const double m_birk1;
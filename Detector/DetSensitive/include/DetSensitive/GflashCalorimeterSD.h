@@ -5,6 +5,9 @@
 #include "DDG4/Geant4Hits.h"
 #include "DDSegmentation/Segmentation.h"
 
+// FCCSW
+#include "DetSensitive/SDInstrumentation.h"
+
 // Geant
 #include "G4THitsCollection.hh"
 #include "G4VGFlashSensitiveDetector.hh"
@@ -60,6 +63,11 @@ public:
    *  @param aSpot Spot in which particle triggered the GFlash model.
    */
   virtual bool ProcessHits(G4GFlashSpot* aSpot, G4TouchableHistory*) final;
+  /** End of event.
+   *  Flushes the hot-path counters (if instrumentation is enabled).
+   *  @param aHitsCollections Geant hits collection.
+   */
+  virtual void EndOfEvent(G4HCofThisEvent* aHitsCollections) final;
   uint64_t cellID(const G4GFlashSpot& aSpot);
 
 private:
@@ -67,6 +75,8 @@ private:
   G4THitsCollection<k4::Geant4CaloHit>* m_calorimeterCollection;
   /// Segmentation of the detector used to retrieve the cell Ids
   dd4hep::Segmentation m_seg;
+  /// Hot-path counters (empty unless compiled with instrumentation)
+  SDCounters m_counters;
 };
 }
 
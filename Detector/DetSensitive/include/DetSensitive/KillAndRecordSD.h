@@ -0,0 +1,88 @@
+#ifndef DETSENSITIVE_KILLANDRECORDSD_H
+#define DETSENSITIVE_KILLANDRECORDSD_H
+
+// DD4hep
+#include "DDSegmentation/Segmentation.h"
+
+// FCCSW
+#include "DetSensitive/SDInstrumentation.h"
+
+// Geant
+#include "G4THitsCollection.hh"
+#include "G4VSensitiveDetector.hh"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace k4 {
+class Geant4CaloHit;
+}
+
+/** KillAndRecordSD Detector/DetSensitive/include/DetSensitive/KillAndRecordSD.h KillAndRecordSD.h
+ *
+ *  Sensitive detector terminating the tracks that are not worth transporting any further in its volumes (e.g. the
+ *  support, cryostat or end plates of a calorimeter): the neutrons with the kinetic energy below a threshold and all
+ *  the tracks with the global time above a cut. Both are checked at the end of each step in the volume.
+ *  The kinetic energy of the killed tracks is summed in the cells (one hit per cell, position and time of the first
+ *  killed track), the hits are saved as those of a calorimeter for the bookkeeping of the killed energy.
+ *  The steps of the other tracks are not recorded.
+ *  Without the cuts given in the compact file (see SDWrapper.cpp) no track is killed.
+ */
+
+namespace det {
+class KillAndRecordSD : public G4VSensitiveDetector {
+public:
+  /** Constructor.
+   *  @param aDetectorName Name of the detector
+   *  @param aReadoutName Name of the readout (used to name the collection)
+   *  @param aSeg Segmentation of the detector (used to retrieve the cell ID)
+   *  @param aNeutronEnergyCut Neutrons with lower kinetic energy are killed (Geant4 units)
+   *  @param aTimeCut Tracks with higher global time are killed (Geant4 units)
+   */
+  KillAndRecordSD(const std::string& aDetectorName,
+                  const std::string& aReadoutName,
+                  const dd4hep::Segmentation& aSeg,
+                  double aNeutronEnergyCut,
+                  double aTimeCut);
+  /// Destructor
+  virtual ~KillAndRecordSD();
+  /** Initialization.
+   *  Creates the hit collection with the name passed in the constructor.
+   *  The hit collection is registered in Geant.
+   *  @param aHitsCollections Geant hits collection.
+   */
+  virtual void Initialize(G4HCofThisEvent* aHitsCollections) final;
+  /** Process the step in the sensitive volume.
+   *  Kills the track if it is a neutron below the energy cut or if it is out of time, and adds its kinetic energy
+   *  to the hit of the cell.
+   *  @param aStep Step in the sensitive volume.
+   *  return True if the track was killed.
+   */
+  virtual bool ProcessHits(G4Step* aStep, G4TouchableHistory*) final;
+  /** End of event.
+   *  Flushes the hot-path counters (if instrumentation is enabled).
+   *  @param aHitsCollections Geant hits collection.
+   */
+  virtual void EndOfEvent(G4HCofThisEvent* aHitsCollections) final;
+  /// Kinetic energy below which the neutrons are killed
+  inline double neutronEnergyCut() const { return m_neutronEnergyCut; }
+  /// Global time above which the tracks are killed
+  inline double timeCut() const { return m_timeCut; }
+
+private:
+  /// Collection of the hits with the killed energy
+  G4THitsCollection<k4::Geant4CaloHit>* m_calorimeterCollection;
+  /// Hit of each cell in the collection
+  std::unordered_map<uint64_t, k4::Geant4CaloHit*> m_cellHits;
+  /// Segmentation of the detector used to retrieve the cell Ids
+  dd4hep::Segmentation m_seg;
+  /// Kinetic energy below which the neutrons are killed
+  double m_neutronEnergyCut;
+  /// Global time above which the tracks are killed
+  double m_timeCut;
+  /// Hot-path counters (empty unless compiled with instrumentation)
+  SDCounters m_counters;
+};
+}
+
+#endif /* DETSENSITIVE_KILLANDRECORDSD_H */
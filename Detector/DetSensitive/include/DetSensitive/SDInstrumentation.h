@@ -0,0 +1,127 @@
+#ifndef DETSENSITIVE_SDINSTRUMENTATION_H
+#define DETSENSITIVE_SDINSTRUMENTATION_H
+
+#include <string>
+
+#ifdef DETSENSITIVE_INSTRUMENTATION
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#endif
+
+/** SDCounters Detector/DetSensitive/include/DetSensitive/SDInstrumentation.h SDInstrumentation.h
+ *
+ *  Hot-path counters of the sensitive detectors: number of processed steps, steps rejected by the cuts,
+ *  created hits and the time spent in det::utils::cellID (measured for one call out of kCellIDSampling).
+ *  Enabled at compile time with the CMake option SD_INSTRUMENTATION (defines DETSENSITIVE_INSTRUMENTATION).
+ *  If disabled, the class holds no data and all the methods are empty inline functions.
+ *
+ *  Each sensitive detector owns its counters. Geant4 creates one sensitive detector per worker thread,
+ *  so counting does not need any synchronisation. The counters are flushed at the end of each event
+ *  (G4VSensitiveDetector::EndOfEvent) to det::SDRunSummary, which aggregates them per readout
+ *  and prints the summary at the end of the job.
+ */
+
+namespace det {
+class SDCounters {
+public:
+#ifdef DETSENSITIVE_INSTRUMENTATION
+  /// Only every kCellIDSampling-th call of cellID is timed (needs to be a power of 2)
+  static constexpr std::uint64_t kCellIDSampling = 64;
+  /** Constructor.
+   *  @param aDetectorName Name of the detector (name of the sensitive detector instance)
+   *  @param aReadoutName Name of the readout (used to aggregate the counters of the run)
+   */
+  SDCounters(const std::string& aDetectorName, const std::string& aReadoutName)
+      : m_detectorName(aDetectorName), m_readoutName(aReadoutName) {}
+  /// Count step processed by the sensitive detector
+  inline void countStep() { ++m_steps; }
+  /// Count step rejected by the cuts of the sensitive detector
+  inline void countRejected() { ++m_rejected; }
+  /// Count hit created by the sensitive detector
+  inline void countHit() { ++m_hits; }
+  /** Calculate the cellID with the given function, timing one call out of kCellIDSampling.
+   *  @param aCellIDFunction Function returning the cellID.
+   *  return Cell ID.
+   */
+  template <typename F>
+  inline auto timeCellID(F&& aCellIDFunction) {
+    if ((m_cellIDCalls++ & (kCellIDSampling - 1)) != 0) {
+      return aCellIDFunction();
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto id = aCellIDFunction();
+    auto stop = std::chrono::steady_clock::now();
+    m_cellIDTime += std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count();
+    ++m_cellIDTimed;
+    return id;
+  }
+  /// Flush the counters of the event to the run summary and reset them
+  void endOfEvent();
+
+private:
+  /// Name of the detector
+  std::string m_detectorName;
+  /// Name of the readout
+  std::string m_readoutName;
+  /// Number of processed steps
+  std::uint64_t m_steps = 0;
+  /// Number of steps rejected by the cuts
+  std::uint64_t m_rejected = 0;
+  /// Number of created hits
+  std::uint64_t m_hits = 0;
+  /// Number of calls of cellID
+  std::uint64_t m_cellIDCalls = 0;
+  /// Number of timed calls of cellID
+  std::uint64_t m_cellIDTimed = 0;
+  /// Total time of the timed calls of cellID (in ns)
+  std::int64_t m_cellIDTime = 0;
+#else
+  SDCounters(const std::string&, const std::string&) {}
+  inline void countStep() {}
+  inline void countRejected() {}
+  inline void countHit() {}
+  template <typename F>
+  inline auto timeCellID(F&& aCellIDFunction) {
+    return aCellIDFunction();
+  }
+  inline void endOfEvent() {}
+#endif
+};
+
+#ifdef DETSENSITIVE_INSTRUMENTATION
+/** SDRunSummary Detector/DetSensitive/include/DetSensitive/SDInstrumentation.h SDInstrumentation.h
+ *
+ *  Run-level aggregator of the counters of all the sensitive detectors (all threads).
+ *  Counters are summed per readout and per detector. Summary is printed when the job ends,
+ *  or on demand with print().
+ */
+class SDRunSummary {
+public:
+  /// Get the instance of the aggregator
+  static SDRunSummary& instance();
+  /** Add the counters of one sensitive detector.
+   *  @param aDetectorName Name of the detector
+   *  @param aReadoutName Name of the readout
+   *  @param aSteps Number of processed steps
+   *  @param aRejected Number of steps rejected by the cuts
+   *  @param aHits Number of created hits
+   *  @param aCellIDCalls Number of calls of cellID
+   *  @param aCellIDTimed Number of timed calls of cellID
+   *  @param aCellIDTime Time spent in the timed calls of cellID (in ns)
+   */
+  void add(const std::string& aDetectorName, const std::string& aReadoutName, std::uint64_t aSteps,
+           std::uint64_t aRejected, std::uint64_t aHits, std::uint64_t aCellIDCalls, std::uint64_t aCellIDTimed,
+           std::int64_t aCellIDTime);
+  /// Print the summary table
+  void print(std::ostream& aStream) const;
+  /// Destructor prints the summary
+  ~SDRunSummary();
+
+private:
+  SDRunSummary() = default;
+};
+#endif
+}
+
+#endif /* DETSENSITIVE_SDINSTRUMENTATION_H */
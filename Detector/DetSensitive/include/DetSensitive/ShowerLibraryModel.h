@@ -0,0 +1,90 @@
+#ifndef DETSENSITIVE_SHOWERLIBRARYMODEL_H
+#define DETSENSITIVE_SHOWERLIBRARYMODEL_H
+
+// FCCSW
+#include "DetCommon/ShowerLibrary.h"
+
+// Geant
+#include "G4Navigator.hh"
+#include "G4TouchableHandle.hh"
+#include "G4VFastSimulationModel.hh"
+
+#include <memory>
+
+/** ShowerLibraryModel Detector/DetSensitive/include/DetSensitive/ShowerLibraryModel.h ShowerLibraryModel.h
+ *
+ *  Fast simulation model replaying frozen showers (det::utils::ShowerLibrary) in a calorimeter envelope (region).
+ *  It is triggered for electrons, positrons and photons entering the envelope (on its surface) with the energy within
+ *  the range of the model and the pseudorapidity of the entry point within the library. A shower of the closest
+ *  energy bin of the eta bin is chosen randomly, its spots are placed in the frame of the particle (entry point and
+ *  direction), their energy scaled with the energy of the particle, and the particle is killed.
+ *  Each spot is located in the geometry and given as G4GFlashSpot to the sensitive detector of the volume, as in
+ *  GFlashHitMaker: the sensitive detectors need to implement G4VGFlashSensitiveDetector (det::GflashCalorimeterSD).
+ *  The spots in the volumes without such a sensitive detector are dropped (and counted).
+ *  One model is created per thread (e.g. in G4VUserDetectorConstruction::ConstructSDandField), the library is shared.
+ */
+
+namespace det {
+class ShowerLibraryModel : public G4VFastSimulationModel {
+public:
+  /** Constructor.
+   *  @param aModelName Name of the model
+   *  @param aEnvelope Region in which the model is applied
+   *  @param aLibrary Shower library
+   *  @param aMinEnergy Minimal energy of the particle (Geant4 units)
+   *  @param aMaxEnergy Maximal energy of the particle (Geant4 units)
+   */
+  ShowerLibraryModel(const std::string& aModelName,
+                     G4Region* aEnvelope,
+                     std::shared_ptr<const utils::ShowerLibrary> aLibrary,
+                     double aMinEnergy,
+                     double aMaxEnergy);
+  /// Destructor
+  virtual ~ShowerLibraryModel();
+  /** Check if the particle can be simulated with the model.
+   *  @param aParticle Type of the particle.
+   *  return True for electrons, positrons and photons.
+   */
+  virtual G4bool IsApplicable(const G4ParticleDefinition& aParticle) final;
+  /** Check if the model is triggered for the track.
+   *  @param aFastTrack Track in the envelope.
+   *  return True if the track enters the envelope with the energy and eta in the range of the library.
+   */
+  virtual G4bool ModelTrigger(const G4FastTrack& aFastTrack) final;
+  /** Replay a shower and kill the track.
+   *  @param aFastTrack Track in the envelope.
+   *  @param aFastStep Result of the fast simulation step.
+   */
+  virtual void DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) final;
+  /// Number of the replayed showers
+  inline uint64_t numberOfShowers() const { return m_numShowers; }
+  /// Number of the spots given to the sensitive detectors
+  inline uint64_t numberOfSpots() const { return m_numSpots; }
+  /// Number of the spots outside of the sensitive volumes with G4VGFlashSensitiveDetector
+  inline uint64_t numberOfDroppedSpots() const { return m_numDroppedSpots; }
+
+private:
+  /** Get the eta bin of the track.
+   *  return Index of the bin, or the number of the eta bins if outside of the library.
+   */
+  size_t etaBin(const G4FastTrack& aFastTrack) const;
+  /// Shower library (memory-mapped)
+  std::shared_ptr<const utils::ShowerLibrary> m_library;
+  /// Minimal energy of the particle
+  double m_minEnergy;
+  /// Maximal energy of the particle
+  double m_maxEnergy;
+  /// Navigator to locate the spots (not the navigator of the tracking)
+  std::unique_ptr<G4Navigator> m_navigator;
+  /// Touchable of the last located spot
+  G4TouchableHandle m_touchable;
+  /// Flag set once the world volume is set in the navigator
+  bool m_navigatorReady = false;
+  /// Counters (the model is used by one thread)
+  uint64_t m_numShowers = 0;
+  uint64_t m_numSpots = 0;
+  uint64_t m_numDroppedSpots = 0;
+};
+}
+
+#endif /* DETSENSITIVE_SHOWERLIBRARYMODEL_H */
@@ -5,6 +5,9 @@
 #include "DDG4/Geant4Hits.h"
 #include "DDSegmentation/Segmentation.h"
 
+// FCCSW
+#include "DetSensitive/SDInstrumentation.h"
+
 // Geant
 #include "G4THitsCollection.hh"
 #include "G4VSensitiveDetector.hh"
@@ -39,12 +42,19 @@ public:
    */
   virtual void Initialize(G4HCofThisEvent* aHitsCollections) final;
   virtual bool ProcessHits(G4Step* aStep, G4TouchableHistory*) final;
+  /** End of event.
+   *  Flushes the hot-path counters (if instrumentation is enabled).
+   *  @param aHitsCollections Geant hits collection.
+   */
+  virtual void EndOfEvent(G4HCofThisEvent* aHitsCollections) final;
 
 private:
   /// Collection of tracker hits
   G4THitsCollection<k4::Geant4PreDigiTrackHit>* m_driftChamberCollection;
   /// Segmentation of the detector used to retrieve the cell Ids
   dd4hep::Segmentation m_seg;
+  /// Hot-path counters (empty unless compiled with instrumentation)
+  SDCounters m_counters;
 
   // cuts on the Edep and the G4 step length 
   double m_edepCut = 10 * CLHEP::eV;
@@ -20,7 +20,8 @@ namespace det {
 AggregateCalorimeterSD::AggregateCalorimeterSD(const std::string& aDetectorName,
                                                const std::string& aReadoutName,
                                                const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg) {
+    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -37,16 +38,20 @@ void AggregateCalorimeterSD::Initialize(G4HCofThisEvent* aHitsCollections) {
 }
 
 bool AggregateCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
   // check if energy was deposited
   G4double edep = aStep->GetTotalEnergyDeposit();
-  if (edep == 0.) return false;
+  if (edep == 0.) {
+    m_counters.countRejected();
+    return false;
+  }
 
   // as in dd4hep::sim::Geant4GenericSD<Calorimeter>
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   CLHEP::Hep3Vector postPos = aStep->GetPostStepPoint()->GetPosition();
   CLHEP::Hep3Vector midPos = 0.5 * (postPos + prePos);
   // check the cell ID
-  uint64_t id = utils::cellID(m_seg, *aStep);
+  uint64_t id = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   k4::Geant4CaloHit* hit = nullptr;
   k4::Geant4CaloHit* hitMatch = nullptr;
   // Check if there is already some energy deposit in that cell
@@ -69,6 +74,9 @@ bool AggregateCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   hitMatch->position = midPos;
   hitMatch->cellID = id;
   m_calorimeterCollection->insert(hitMatch);
+  m_counters.countHit();
   return true;
 }
+
+void AggregateCalorimeterSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
@@ -24,6 +24,7 @@ BirksLawCalorimeterSD::BirksLawCalorimeterSD(const std::string& aDetectorName,
     : G4VSensitiveDetector(aDetectorName),
       m_calorimeterCollection(nullptr),
       m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName),
       // variables for birks law
       m_material("Polystyrene"),
       m_birk1(0.0130 * CLHEP::g / (CLHEP::MeV * CLHEP::cm2)),
@@ -44,9 +45,13 @@ void BirksLawCalorimeterSD::Initialize(G4HCofThisEvent* aHitsCollections) {
 }
 
 bool BirksLawCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
   // check if energy was deposited
   G4double edep = aStep->GetTotalEnergyDeposit();
-  if (edep == 0.) return false;
+  if (edep == 0.) {
+    m_counters.countRejected();
+    return false;
+  }
 
   G4double response = 0.;
 
@@ -76,10 +81,13 @@ bool BirksLawCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   auto hit = new k4::Geant4CaloHit(
       track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(), edep, track->GetGlobalTime());
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   hit->position = prePos;
   hit->energyDeposit = edep;
   m_calorimeterCollection->insert(hit);
+  m_counters.countHit();
   return true;
 }
+
+void BirksLawCalorimeterSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
@@ -18,7 +18,8 @@ namespace det {
 FullParticleAbsorptionSD::FullParticleAbsorptionSD(const std::string& aDetectorName,
                                                    const std::string& aReadoutName,
                                                    const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg) {
+    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -34,16 +35,20 @@ void FullParticleAbsorptionSD::Initialize(G4HCofThisEvent* aHitsCollections) {
 }
 
 bool FullParticleAbsorptionSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
   G4Track* aTrack = aStep->GetTrack();
   G4double kineticEnergy = aTrack->GetKineticEnergy();
   auto hit = new k4::Geant4CaloHit(
       aTrack->GetTrackID(), aTrack->GetDefinition()->GetPDGEncoding(), kineticEnergy, aTrack->GetGlobalTime());
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   hit->position = prePos;
   m_calorimeterCollection->insert(hit);
+  m_counters.countHit();
   // kill the track to ensure no double counting
   aTrack->SetTrackStatus(fStopAndKill);
   return true;
 }
+
+void FullParticleAbsorptionSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
@@ -31,7 +31,8 @@ namespace det {
 GflashCalorimeterSD::GflashCalorimeterSD(const std::string& aDetectorName,
                                          const std::string& aReadoutName,
                                          const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), G4VGFlashSensitiveDetector(), m_seg(aSeg) {
+    : G4VSensitiveDetector(aDetectorName), G4VGFlashSensitiveDetector(), m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -49,34 +50,44 @@ void GflashCalorimeterSD::Initialize(G4HCofThisEvent* aHitsCollections) {
 
 bool GflashCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   // This method is called if full simulation is performed
+  m_counters.countStep();
   // check if energy was deposited
   G4double edep = aStep->GetTotalEnergyDeposit();
-  if (edep == 0.) return false;
+  if (edep == 0.) {
+    m_counters.countRejected();
+    return false;
+  }
 
   // create a new hit
   // deleted in ~G4Event
   k4::Geant4CaloHit* hit = new k4::Geant4CaloHit();
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   hit->position = prePos;
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   hit->energyDeposit = edep;
   m_calorimeterCollection->insert(hit);
+  m_counters.countHit();
   return true;
 }
 
 bool GflashCalorimeterSD::ProcessHits(G4GFlashSpot* aSpot, G4TouchableHistory*) {
   // This method will be called if gflash parametrisation is performed
+  m_counters.countStep();
   G4double edep = aSpot->GetEnergySpot()->GetEnergy();
   // check if energy was deposited
-  if (edep == 0.) return false;
+  if (edep == 0.) {
+    m_counters.countRejected();
+    return false;
+  }
   // create a new hit
   // deleted in ~G4Event
   k4::Geant4CaloHit* hit = new k4::Geant4CaloHit();
   CLHEP::Hep3Vector geantPos = aSpot->GetEnergySpot()->GetPosition();
   hit->position = geantPos;
-  hit->cellID = cellID(*aSpot);
+  hit->cellID = m_counters.timeCellID([&] { return cellID(*aSpot); });
   hit->energyDeposit = edep;
   m_calorimeterCollection->insert(hit);
+  m_counters.countHit();
   return true;
 }
 
@@ -93,4 +104,6 @@ uint64_t GflashCalorimeterSD::cellID(const G4GFlashSpot& aSpot) {
   }
   return volID;
 }
+
+void GflashCalorimeterSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
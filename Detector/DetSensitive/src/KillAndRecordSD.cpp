@@ -0,0 +1,62 @@
+#include "DetSensitive/KillAndRecordSD.h"
+
+// FCCSW
+#include "DetCommon/DetUtils.h"
+#include "DetCommon/Geant4CaloHit.h"
+
+// Geant4
+#include "G4Neutron.hh"
+#include "G4SDManager.hh"
+
+namespace det {
+KillAndRecordSD::KillAndRecordSD(const std::string& aDetectorName,
+                                 const std::string& aReadoutName,
+                                 const dd4hep::Segmentation& aSeg,
+                                 double aNeutronEnergyCut,
+                                 double aTimeCut)
+    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg),
+      m_neutronEnergyCut(aNeutronEnergyCut), m_timeCut(aTimeCut), m_counters(aDetectorName, aReadoutName) {
+  // name of the collection of hits is determined by the readout name (from XML)
+  collectionName.insert(aReadoutName);
+}
+
+KillAndRecordSD::~KillAndRecordSD() {}
+
+void KillAndRecordSD::Initialize(G4HCofThisEvent* aHitsCollections) {
+  // create a collection of hits and add it to G4HCofThisEvent
+  // deleted in ~G4Event
+  m_calorimeterCollection = new G4THitsCollection<k4::Geant4CaloHit>(SensitiveDetectorName, collectionName[0]);
+  aHitsCollections->AddHitsCollection(G4SDManager::GetSDMpointer()->GetCollectionID(m_calorimeterCollection),
+                                      m_calorimeterCollection);
+  m_cellHits.clear();
+}
+
+bool KillAndRecordSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
+  G4Track* track = aStep->GetTrack();
+  // the track at the end of the step
+  bool lowEnergyNeutron =
+      track->GetDefinition() == G4Neutron::Definition() && track->GetKineticEnergy() < m_neutronEnergyCut;
+  if (!lowEnergyNeutron && track->GetGlobalTime() <= m_timeCut) {
+    m_counters.countRejected();
+    return false;
+  }
+  uint64_t id = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
+  auto cell = m_cellHits.emplace(id, nullptr);
+  if (cell.second) {
+    auto hit = new k4::Geant4CaloHit(track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(),
+                                     track->GetKineticEnergy(), track->GetGlobalTime());
+    hit->cellID = id;
+    hit->position = aStep->GetPreStepPoint()->GetPosition();
+    m_calorimeterCollection->insert(hit);
+    cell.first->second = hit;
+    m_counters.countHit();
+  } else {
+    cell.first->second->energyDeposit += track->GetKineticEnergy();
+  }
+  track->SetTrackStatus(fStopAndKill);
+  return true;
+}
+
+void KillAndRecordSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
+}
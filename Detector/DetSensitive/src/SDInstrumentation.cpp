@@ -0,0 +1,79 @@
+#include "DetSensitive/SDInstrumentation.h"
+
+#ifdef DETSENSITIVE_INSTRUMENTATION
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+
+namespace {
+/// Counters summed over all events and threads
+struct SDTotals {
+  std::uint64_t steps = 0;
+  std::uint64_t rejected = 0;
+  std::uint64_t hits = 0;
+  std::uint64_t cellIDCalls = 0;
+  std::uint64_t cellIDTimed = 0;
+  std::int64_t cellIDTime = 0;
+};
+/// Protects the totals: only taken once per event per sensitive detector
+std::mutex s_summaryMutex;
+/// Totals per (readout, detector)
+std::map<std::pair<std::string, std::string>, SDTotals> s_totals;
+}
+
+namespace det {
+void SDCounters::endOfEvent() {
+  if (m_steps == 0 && m_cellIDCalls == 0) return;
+  SDRunSummary::instance().add(m_detectorName, m_readoutName, m_steps, m_rejected, m_hits, m_cellIDCalls,
+                               m_cellIDTimed, m_cellIDTime);
+  m_steps = 0;
+  m_rejected = 0;
+  m_hits = 0;
+  m_cellIDCalls = 0;
+  m_cellIDTimed = 0;
+  m_cellIDTime = 0;
+}
+
+SDRunSummary& SDRunSummary::instance() {
+  static SDRunSummary summary;
+  return summary;
+}
+
+void SDRunSummary::add(const std::string& aDetectorName, const std::string& aReadoutName, std::uint64_t aSteps,
+                       std::uint64_t aRejected, std::uint64_t aHits, std::uint64_t aCellIDCalls,
+                       std::uint64_t aCellIDTimed, std::int64_t aCellIDTime) {
+  std::lock_guard<std::mutex> lock(s_summaryMutex);
+  auto& totals = s_totals[std::make_pair(aReadoutName, aDetectorName)];
+  totals.steps += aSteps;
+  totals.rejected += aRejected;
+  totals.hits += aHits;
+  totals.cellIDCalls += aCellIDCalls;
+  totals.cellIDTimed += aCellIDTimed;
+  totals.cellIDTime += aCellIDTime;
+}
+
+void SDRunSummary::print(std::ostream& aStream) const {
+  std::lock_guard<std::mutex> lock(s_summaryMutex);
+  if (s_totals.empty()) return;
+  aStream << "Sensitive detector counters (cellID time estimated from 1/" << SDCounters::kCellIDSampling
+          << " of calls):\n";
+  aStream << std::left << std::setw(30) << "readout" << std::setw(30) << "detector" << std::right << std::setw(14)
+          << "steps" << std::setw(14) << "rejected" << std::setw(14) << "hits" << std::setw(18) << "cellID [ns/call]"
+          << std::setw(14) << "cellID [s]" << '\n';
+  for (const auto& entry : s_totals) {
+    const auto& totals = entry.second;
+    double nsPerCall = totals.cellIDTimed > 0 ? double(totals.cellIDTime) / totals.cellIDTimed : 0.;
+    aStream << std::left << std::setw(30) << entry.first.first << std::setw(30) << entry.first.second << std::right
+            << std::setw(14) << totals.steps << std::setw(14) << totals.rejected << std::setw(14) << totals.hits
+            << std::setw(18) << std::fixed << std::setprecision(1) << nsPerCall << std::setw(14)
+            << std::setprecision(3) << nsPerCall * totals.cellIDCalls * 1e-9 << '\n';
+  }
+  aStream.flush();
+}
+
+SDRunSummary::~SDRunSummary() { print(std::cout); }
+}
+
+#endif /* DETSENSITIVE_INSTRUMENTATION */
@@ -1,14 +1,21 @@
+#include "DD4hep/DD4hepUnits.h"
 #include "DD4hep/Detector.h"
 #include "DDG4/Factories.h"
 
+// CLHEP
+#include "CLHEP/Units/SystemOfUnits.h"
+
 #include "DetSensitive/AggregateCalorimeterSD.h"
 #include "DetSensitive/BirksLawCalorimeterSD.h"
 #include "DetSensitive/FullParticleAbsorptionSD.h"
 #include "DetSensitive/GflashCalorimeterSD.h"
+#include "DetSensitive/KillAndRecordSD.h"
 #include "DetSensitive/SimpleCalorimeterSD.h"
 #include "DetSensitive/SimpleTrackerSD.h"
 #include "DetSensitive/SimpleDriftChamber.h"
 
+#include <cfloat>
+
 namespace dd4hep {
 namespace sim {
 
@@ -61,6 +68,28 @@ static G4VSensitiveDetector* create_simple_driftchamber(const std::string& aDete
   return new det::SimpleDriftChamber(
       aDetectorName, readoutName, aLcdd.sensitiveDetector(aDetectorName).readout().segmentation());
 }
+// Value of the constant <detector>_<name> or <name> of the compact file, default if neither is defined
+static double kill_cut(dd4hep::Detector& aLcdd, const std::string& aDetectorName, const std::string& aName,
+                       double aDefault) {
+  for (const auto& name : {aDetectorName + "_" + aName, aName}) {
+    if (aLcdd.constants().find(name) != aLcdd.constants().end()) {
+      return aLcdd.constant<double>(name);
+    }
+  }
+  return aDefault;
+}
+// Factory method to create an instance of KillAndRecordSD
+// Cuts from the constants killNeutronEnergy and killTime (or <detector>_killNeutronEnergy, <detector>_killTime)
+static G4VSensitiveDetector* create_kill_and_record_sd(const std::string& aDetectorName, dd4hep::Detector& aLcdd) {
+  std::string readoutName = aLcdd.sensitiveDetector(aDetectorName).readout().name();
+  double neutronEnergyCut = kill_cut(aLcdd, aDetectorName, "killNeutronEnergy", 0) / dd4hep::GeV * CLHEP::GeV;
+  // no time cut if not positive
+  double timeCut = kill_cut(aLcdd, aDetectorName, "killTime", 0);
+  timeCut = timeCut > 0 ? timeCut / dd4hep::ns * CLHEP::ns : DBL_MAX;
+  return new det::KillAndRecordSD(aDetectorName, readoutName,
+                                  aLcdd.sensitiveDetector(aDetectorName).readout().segmentation(),
+                                  neutronEnergyCut, timeCut);
+}
 }
 }
 
@@ -71,4 +100,5 @@ DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(AggregateCalorimeterSD, dd4hep::sim::cr
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(GflashCalorimeterSD, dd4hep::sim::create_gflash_calorimeter_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(FullParticleAbsorptionSD, dd4hep::sim::create_full_particle_absorbtion_sd)
 DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(SimpleDriftChamber, dd4hep::sim::create_simple_driftchamber)
+DECLARE_EXTERNAL_GEANT4SENSITIVEDETECTOR(KillAndRecordSD, dd4hep::sim::create_kill_and_record_sd)
 
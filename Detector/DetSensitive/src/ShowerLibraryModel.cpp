@@ -0,0 +1,100 @@
+#include "DetSensitive/ShowerLibraryModel.h"
+
+// CLHEP
+#include "CLHEP/Units/SystemOfUnits.h"
+
+// Geant4
+#include "G4Electron.hh"
+#include "G4FastStep.hh"
+#include "G4FastTrack.hh"
+#include "G4GFlashSpot.hh"
+#include "G4Gamma.hh"
+#include "G4Positron.hh"
+#include "G4TouchableHistory.hh"
+#include "G4TransportationManager.hh"
+#include "G4VGFlashSensitiveDetector.hh"
+#include "GFlashEnergySpot.hh"
+#include "Randomize.hh"
+
+#include <algorithm>
+
+namespace det {
+ShowerLibraryModel::ShowerLibraryModel(const std::string& aModelName,
+                                       G4Region* aEnvelope,
+                                       std::shared_ptr<const utils::ShowerLibrary> aLibrary,
+                                       double aMinEnergy,
+                                       double aMaxEnergy)
+    : G4VFastSimulationModel(aModelName, aEnvelope), m_library(aLibrary), m_minEnergy(aMinEnergy),
+      m_maxEnergy(aMaxEnergy), m_navigator(new G4Navigator()), m_touchable(new G4TouchableHistory()) {}
+
+ShowerLibraryModel::~ShowerLibraryModel() {}
+
+G4bool ShowerLibraryModel::IsApplicable(const G4ParticleDefinition& aParticle) {
+  return &aParticle == G4Electron::Definition() || &aParticle == G4Positron::Definition() ||
+         &aParticle == G4Gamma::Definition();
+}
+
+size_t ShowerLibraryModel::etaBin(const G4FastTrack& aFastTrack) const {
+  return m_library->etaBin(aFastTrack.GetPrimaryTrack()->GetPosition().eta());
+}
+
+G4bool ShowerLibraryModel::ModelTrigger(const G4FastTrack& aFastTrack) {
+  double energy = aFastTrack.GetPrimaryTrack()->GetKineticEnergy();
+  if (energy < m_minEnergy || energy > m_maxEnergy) {
+    return false;
+  }
+  // only the particles entering the envelope, the showers start at its surface
+  if (aFastTrack.GetEnvelopeSolid()->Inside(aFastTrack.GetPrimaryTrackLocalPosition()) != kSurface) {
+    return false;
+  }
+  size_t eta = etaBin(aFastTrack);
+  return eta < m_library->numberOfEtaBins() &&
+         m_library->numberOfShowers(m_library->energyBin(energy / CLHEP::GeV), eta) > 0;
+}
+
+void ShowerLibraryModel::DoIt(const G4FastTrack& aFastTrack, G4FastStep& aFastStep) {
+  const G4Track* track = aFastTrack.GetPrimaryTrack();
+  double energy = track->GetKineticEnergy();
+  // the particle is absorbed, its energy is deposited in the spots
+  aFastStep.KillPrimaryTrack();
+  aFastStep.ProposePrimaryTrackPathLength(0.0);
+  aFastStep.ProposeTotalEnergyDeposited(energy);
+
+  size_t energyBin = m_library->energyBin(energy / CLHEP::GeV);
+  size_t eta = etaBin(aFastTrack);
+  size_t numShowers = m_library->numberOfShowers(energyBin, eta);
+  size_t index = std::min(numShowers - 1, static_cast<size_t>(G4UniformRand() * numShowers));
+  auto shower = m_library->shower(energyBin, eta, index);
+  ++m_numShowers;
+
+  if (!m_navigatorReady) {
+    m_navigator->SetWorldVolume(
+        G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+    m_navigatorReady = true;
+  }
+  const G4ThreeVector& entry = track->GetPosition();
+  const G4ThreeVector& direction = track->GetMomentumDirection();
+  utils::ShowerFrame frame(direction.x(), direction.y(), direction.z());
+  const G4ThreeVector axisU(frame.u[0], frame.u[1], frame.u[2]);
+  const G4ThreeVector axisV(frame.v[0], frame.v[1], frame.v[2]);
+  const G4ThreeVector axisW(frame.w[0], frame.w[1], frame.w[2]);
+  for (size_t iSpot = 0; iSpot < shower.second; ++iSpot) {
+    const utils::ShowerSpot& spot = shower.first[iSpot];
+    G4ThreeVector position = entry + spot.longitudinal * CLHEP::mm * axisW + spot.transverseU * CLHEP::mm * axisU +
+                             spot.transverseV * CLHEP::mm * axisV;
+    m_navigator->LocateGlobalPointAndUpdateTouchable(position, m_touchable(), false);
+    G4VPhysicalVolume* volume = m_touchable->GetVolume();
+    auto sensitive = volume != nullptr ? dynamic_cast<G4VGFlashSensitiveDetector*>(
+                                             volume->GetLogicalVolume()->GetSensitiveDetector())
+                                       : nullptr;
+    if (sensitive == nullptr) {
+      ++m_numDroppedSpots;
+      continue;
+    }
+    GFlashEnergySpot energySpot(position, spot.energyFraction * energy);
+    G4GFlashSpot gflashSpot(&energySpot, &aFastTrack, m_touchable);
+    sensitive->Hit(&gflashSpot);
+    ++m_numSpots;
+  }
+}
+}
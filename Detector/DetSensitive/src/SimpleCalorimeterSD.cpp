@@ -19,7 +19,8 @@ namespace det {
 SimpleCalorimeterSD::SimpleCalorimeterSD(const std::string& aDetectorName,
                                          const std::string& aReadoutName,
                                          const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg) {
+    : G4VSensitiveDetector(aDetectorName), m_calorimeterCollection(nullptr), m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -35,19 +36,26 @@ void SimpleCalorimeterSD::Initialize(G4HCofThisEvent* aHitsCollections) {
 }
 
 bool SimpleCalorimeterSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
   // check if energy was deposited
   G4double edep = aStep->GetTotalEnergyDeposit();
-  if (edep == 0.) return false;
+  if (edep == 0.) {
+    m_counters.countRejected();
+    return false;
+  }
 
   // as in dd4hep::sim::Geant4GenericSD<Calorimeter>
   const G4Track* track = aStep->GetTrack();
   auto hit = new k4::Geant4CaloHit(
       track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(), edep, track->GetGlobalTime());
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   hit->energyDeposit = edep;
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
   hit->position = prePos;
   m_calorimeterCollection->insert(hit);
+  m_counters.countHit();
   return true;
 }
+
+void SimpleCalorimeterSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
@@ -19,7 +19,8 @@ namespace det {
 SimpleDriftChamber::SimpleDriftChamber(const std::string& aDetectorName,
                                        const std::string& aReadoutName,
                                        const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_driftChamberCollection(nullptr), m_seg(aSeg) {
+    : G4VSensitiveDetector(aDetectorName), m_driftChamberCollection(nullptr), m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -36,12 +37,14 @@ void SimpleDriftChamber::Initialize(G4HCofThisEvent* aHitsCollections) {
 }
 
 bool SimpleDriftChamber::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
   // check if energy was deposited
   G4double edep = aStep->GetTotalEnergyDeposit();
   G4double stepLength = aStep->GetStepLength();
 
   // cuts on the Edep and the G4 step length 
   if (edep < m_edepCut || stepLength < m_stepLengthCut) {
+    m_counters.countRejected();
     return false;
   }
 
@@ -54,11 +57,14 @@ bool SimpleDriftChamber::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   auto hit = new k4::Geant4PreDigiTrackHit(
       track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(), edep, track->GetGlobalTime());
 
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   hit->energyDeposit = edep;
   hit->prePos = prePos;
   hit->postPos = postPos;
   m_driftChamberCollection->insert(hit);
+  m_counters.countHit();
   return true;
 }
+
+void SimpleDriftChamber::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
@@ -19,7 +19,8 @@ namespace det {
 SimpleTrackerSD::SimpleTrackerSD(const std::string& aDetectorName,
                                  const std::string& aReadoutName,
                                  const dd4hep::Segmentation& aSeg)
-    : G4VSensitiveDetector(aDetectorName), m_trackerCollection(nullptr), m_seg(aSeg) {
+    : G4VSensitiveDetector(aDetectorName), m_trackerCollection(nullptr), m_seg(aSeg),
+      m_counters(aDetectorName, aReadoutName) {
   // name of the collection of hits is determined byt the readout name (from XML)
   collectionName.insert(aReadoutName);
 }
@@ -35,9 +36,13 @@ void SimpleTrackerSD::Initialize(G4HCofThisEvent* aHitsCollections) {
 }
 
 bool SimpleTrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  m_counters.countStep();
   // check if energy was deposited
   G4double edep = aStep->GetTotalEnergyDeposit();
-  if (edep == 0.) return false;
+  if (edep == 0.) {
+    m_counters.countRejected();
+    return false;
+  }
   // get track
   const G4Track* track = aStep->GetTrack();
   CLHEP::Hep3Vector prePos = aStep->GetPreStepPoint()->GetPosition();
@@ -46,10 +51,13 @@ bool SimpleTrackerSD::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   // deleted in ~G4Event
   auto hit = new k4::Geant4PreDigiTrackHit(
       track->GetTrackID(), track->GetDefinition()->GetPDGEncoding(), edep, track->GetGlobalTime());
-  hit->cellID = utils::cellID(m_seg, *aStep);
+  hit->cellID = m_counters.timeCellID([&] { return utils::cellID(m_seg, *aStep); });
   hit->prePos = prePos;
   hit->postPos = postPos;
   m_trackerCollection->insert(hit);
+  m_counters.countHit();
   return true;
 }
+
+void SimpleTrackerSD::EndOfEvent(G4HCofThisEvent*) { m_counters.endOfEvent(); }
 }
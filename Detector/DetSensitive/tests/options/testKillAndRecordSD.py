@@ -0,0 +1,62 @@
+from Gaudi.Configuration import *
+
+from Configurables import GenAlg, MomentumRangeParticleGun
+pgun = MomentumRangeParticleGun("PGun",
+                                PdgCodes=[211], # pion
+                                MomentumMin = 50, # GeV
+                                MomentumMax = 50, # GeV
+                                ThetaMin = -0.45, # rad
+                                ThetaMax = -0.45, # rad
+                                PhiMin = 1.6, # rad
+                                PhiMax = 1.6) # rad
+gen = GenAlg("ParticleGun", SignalProvider=pgun)
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter("Converter")
+hepmc_converter.hepmc.Path="hepmc"
+hepmc_converter.genparticles.Path="allGenParticles"
+hepmc_converter.genvertices.Path="allGenVertices"
+
+from Configurables import HepMCDumper
+hepmc_dump = HepMCDumper("hepmc")
+hepmc_dump.hepmc.Path="hepmc"
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=['file:compact/Box_killAndRecordSD.xml'], OutputLevel = DEBUG)
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc",
+                        detector='SimG4DD4hepDetector',
+                        physicslist="SimG4FtfpBert",
+                        actions="SimG4FullSimActions")
+
+from Configurables import SimG4Alg, SimG4SaveCalHits, SimG4PrimariesFromEdmTool, InspectHitsCollectionsTool
+inspecttool = InspectHitsCollectionsTool("inspect", readoutNames=["KilledEnergy"], OutputLevel = DEBUG)
+
+savekilltool = SimG4SaveCalHits("saveKilledEnergy", readoutNames = ["KilledEnergy"])
+savekilltool.positionedCaloHits.Path = "positionedCaloHits"
+savekilltool.caloHits.Path = "caloHits"
+
+particle_converter = SimG4PrimariesFromEdmTool("EdmConverter")
+particle_converter.genParticles.Path = "allGenParticles"
+geantsim = SimG4Alg("SimG4Alg",
+                    outputs=["SimG4SaveCalHits/saveKilledEnergy",
+                             "InspectHitsCollectionsTool/inspect"],
+                    eventProvider=particle_converter)
+
+from Configurables import FCCDataSvc, PodioOutput
+podiosvc = FCCDataSvc("EventDataSvc")
+out = PodioOutput("out", OutputLevel=DEBUG, filename="out_killAndRecordSD.root")
+out.outputCommands = ["keep *"]
+
+
+# ApplicationMgr
+from Configurables import ApplicationMgr
+ApplicationMgr( TopAlg = [gen, hepmc_converter, hepmc_dump, geantsim, out],
+                EvtSel = 'NONE',
+                EvtMax   = 1,
+                # order is important, as GeoSvc is needed by SimG4Svc
+                ExtSvc = [podiosvc, geoservice, geantservice],
+                OutputLevel=DEBUG
+ )
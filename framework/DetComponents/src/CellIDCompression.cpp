@@ -0,0 +1,69 @@
+#include "CellIDCompression.h"
+
+// FCCSW
+#include "DetCommon/CellIDCodec.h"
+#include "DetCommon/RadixSort.h"
+
+// datamodel
+#include "edm4hep/CalorimeterHitCollection.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace det {
+namespace utils {
+void compressCellIDs(const edm4hep::CalorimeterHitCollection& aHits,
+                     podio::UserDataCollection<uint8_t>& aEncodedCellIDs, podio::UserDataCollection<float>& aValues,
+                     podio::UserDataCollection<int32_t>& aTypes) {
+  std::vector<uint64_t> cellIDs(aHits.size());
+  for (size_t iHit = 0; iHit < aHits.size(); ++iHit) {
+    cellIDs[iHit] = aHits[iHit].getCellID();
+  }
+  std::vector<uint32_t> order;
+  radixSortOrder(cellIDs, order);
+  std::vector<uint64_t> sortedCellIDs(order.size());
+  auto& values = aValues.vec();
+  auto& types = aTypes.vec();
+  values.reserve(values.size() + numHitValues * order.size());
+  types.reserve(types.size() + order.size());
+  for (size_t iHit = 0; iHit < order.size(); ++iHit) {
+    sortedCellIDs[iHit] = cellIDs[order[iHit]];
+    const auto& hit = aHits[order[iHit]];
+    const auto& position = hit.getPosition();
+    values.insert(values.end(),
+                  {hit.getEnergy(), hit.getEnergyError(), hit.getTime(), position.x, position.y, position.z});
+    types.push_back(hit.getType());
+  }
+  encodeCellIDs(sortedCellIDs, aEncodedCellIDs.vec());
+}
+
+void expandCellIDs(const podio::UserDataCollection<uint8_t>& aEncodedCellIDs,
+                   const podio::UserDataCollection<float>& aValues, const podio::UserDataCollection<int32_t>& aTypes,
+                   edm4hep::CalorimeterHitCollection& aOutHits) {
+  std::vector<uint64_t> cellIDs;
+  // empty data (no count of the cell IDs) is reported as truncated
+  const uint8_t* encoded = aEncodedCellIDs.size() > 0 ? &aEncodedCellIDs[0] : nullptr;
+  size_t numBytesRead = decodeCellIDs(encoded, aEncodedCellIDs.size(), cellIDs);
+  if (numBytesRead != aEncodedCellIDs.size()) {
+    throw std::runtime_error("Encoded cell IDs are followed by " +
+                             std::to_string(aEncodedCellIDs.size() - numBytesRead) + " unexpected bytes.");
+  }
+  if (aValues.size() != numHitValues * cellIDs.size() || aTypes.size() != cellIDs.size()) {
+    throw std::runtime_error("Number of the encoded cell IDs (" + std::to_string(cellIDs.size()) +
+                             ") does not match the number of the values (" + std::to_string(aValues.size()) +
+                             ") or of the types (" + std::to_string(aTypes.size()) + ") of the hits.");
+  }
+  for (size_t iHit = 0; iHit < cellIDs.size(); ++iHit) {
+    const float* values = &aValues[numHitValues * iHit];
+    edm4hep::CalorimeterHit newHit = aOutHits.create();
+    newHit.setCellID(cellIDs[iHit]);
+    newHit.setEnergy(values[0]);
+    newHit.setEnergyError(values[1]);
+    newHit.setTime(values[2]);
+    newHit.setPosition({values[3], values[4], values[5]});
+    newHit.setType(aTypes[iHit]);
+  }
+}
+}
+}
@@ -0,0 +1,50 @@
+#ifndef DETCOMPONENTS_CELLIDCOMPRESSION_H
+#define DETCOMPONENTS_CELLIDCOMPRESSION_H
+
+#include <cstddef>
+#include <cstdint>
+
+// datamodel
+#include "podio/UserDataCollection.h"
+namespace edm4hep {
+class CalorimeterHitCollection;
+}
+
+/** Compressed cell IDs of the calorimeter hit collections (see DetCommon/CellIDCodec.h).
+ *
+ *  CompressCellIDs writes the hits sorted by the cell ID in three collections, without the 64-bit cell ID:
+ *  - the encoded cell IDs (1-3 bytes per hit for neighbouring cells),
+ *  - the values of the hits (numHitValues floats per hit: energy, energy error, time, position x, y, z),
+ *  - the types of the hits.
+ *  ExpandCellIDs restores the hit collection. A hit takes then about 30 bytes instead of the 36 bytes of
+ *  edm4hep::CalorimeterHit, before any compression of the output file.
+ */
+
+namespace det {
+namespace utils {
+/// Number of the values stored per hit (energy, energy error, time, position x, y, z)
+constexpr size_t numHitValues = 6;
+
+/** Store the hits sorted by the cell ID, without the cell ID member.
+ *  @param[in] aHits Hits with the cell IDs.
+ *  @param[out] aEncodedCellIDs Encoded cell IDs of the sorted hits.
+ *  @param[out] aValues Values of the sorted hits (numHitValues per hit).
+ *  @param[out] aTypes Types of the sorted hits.
+ */
+void compressCellIDs(const edm4hep::CalorimeterHitCollection& aHits,
+                     podio::UserDataCollection<uint8_t>& aEncodedCellIDs, podio::UserDataCollection<float>& aValues,
+                     podio::UserDataCollection<int32_t>& aTypes);
+/** Restore the hits stored by compressCellIDs.
+ *  Throws std::runtime_error if the encoded cell IDs are truncated, corrupted or followed by other data, or if the
+ *  numbers of the cell IDs, of the values and of the types do not match.
+ *  @param[in] aEncodedCellIDs Encoded cell IDs of the hits.
+ *  @param[in] aValues Values of the hits.
+ *  @param[in] aTypes Types of the hits.
+ *  @param[out] aOutHits Hits with the cell IDs.
+ */
+void expandCellIDs(const podio::UserDataCollection<uint8_t>& aEncodedCellIDs,
+                   const podio::UserDataCollection<float>& aValues, const podio::UserDataCollection<int32_t>& aTypes,
+                   edm4hep::CalorimeterHitCollection& aOutHits);
+}
+}
+#endif /* DETCOMPONENTS_CELLIDCOMPRESSION_H */
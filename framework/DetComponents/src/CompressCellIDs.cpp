@@ -0,0 +1,27 @@
+#include "CompressCellIDs.h"
+#include "CellIDCompression.h"
+
+#include <memory>
+
+DECLARE_COMPONENT(CompressCellIDs)
+
+CompressCellIDs::CompressCellIDs(const std::string& aName, ISvcLocator* aSvcLoc)
+    : MultiTransformer(aName, aSvcLoc, KeyValue("inhits", "hits/caloInHits"),
+                       {KeyValue("outcellids", "hits/caloOutCellIDs"), KeyValue("outvalues", "hits/caloOutValues"),
+                        KeyValue("outtypes", "hits/caloOutTypes")}) {}
+
+CompressCellIDs::~CompressCellIDs() {}
+
+std::tuple<DataWrapper<podio::UserDataCollection<uint8_t>>, DataWrapper<podio::UserDataCollection<float>>,
+           DataWrapper<podio::UserDataCollection<int32_t>>>
+CompressCellIDs::operator()(const DataWrapper<edm4hep::CalorimeterHitCollection>& aInHits) const {
+  const auto inHits = aInHits.getData();
+  auto cellIDs = std::make_unique<podio::UserDataCollection<uint8_t>>();
+  auto values = std::make_unique<podio::UserDataCollection<float>>();
+  auto types = std::make_unique<podio::UserDataCollection<int32_t>>();
+  det::utils::compressCellIDs(*inHits, *cellIDs, *values, *types);
+  debug() << "Compressed cell IDs of " << inHits->size() << " hits to " << cellIDs->size() << " bytes" << endmsg;
+  return std::make_tuple(DataWrapper<podio::UserDataCollection<uint8_t>>(std::move(cellIDs)),
+                         DataWrapper<podio::UserDataCollection<float>>(std::move(values)),
+                         DataWrapper<podio::UserDataCollection<int32_t>>(std::move(types)));
+}
@@ -0,0 +1,43 @@
+#ifndef DETCOMPONENTS_COMPRESSCELLIDS_H
+#define DETCOMPONENTS_COMPRESSCELLIDS_H
+
+// GAUDI
+#include "GaudiAlg/Transformer.h"
+
+// FCCSW
+#include "k4FWCore/BaseClass.h"
+#include "k4FWCore/DataWrapper.h"
+#include "podio/UserDataCollection.h"
+
+// datamodel
+#include "edm4hep/CalorimeterHitCollection.h"
+
+/** @class CompressCellIDs Detector/DetComponents/src/CompressCellIDs.h CompressCellIDs.h
+ *
+ *  Write the hits with compressed cell IDs (see CellIDCompression.h).
+ *  The hits ('\b inhits', e.g. the output of RedoSegmentation, MergeCells or RewriteBitfield) are sorted by the cell
+ *  ID and written without the cell ID member: the encoded cell IDs to '\b outcellids', the energies, times and
+ *  positions to '\b outvalues' and the types to '\b outtypes'. ExpandCellIDs restores the hit collection.
+ *
+ *  For an example see Detector/DetComponents/tests/options/compressCellIDs.py
+ *
+ */
+
+class CompressCellIDs final
+    : public Gaudi::Functional::MultiTransformer<
+          std::tuple<DataWrapper<podio::UserDataCollection<uint8_t>>, DataWrapper<podio::UserDataCollection<float>>,
+                     DataWrapper<podio::UserDataCollection<int32_t>>>(
+              const DataWrapper<edm4hep::CalorimeterHitCollection>&),
+          BaseClass_t> {
+public:
+  explicit CompressCellIDs(const std::string&, ISvcLocator*);
+  virtual ~CompressCellIDs();
+  /**  Compress the cell IDs of the hits of one event.
+   *   @param[in] aInHits Hit collection with cell IDs.
+   *   @return Encoded cell IDs, values and types of the sorted hits.
+   */
+  virtual std::tuple<DataWrapper<podio::UserDataCollection<uint8_t>>, DataWrapper<podio::UserDataCollection<float>>,
+                     DataWrapper<podio::UserDataCollection<int32_t>>>
+  operator()(const DataWrapper<edm4hep::CalorimeterHitCollection>& aInHits) const override;
+};
+#endif /* DETCOMPONENTS_COMPRESSCELLIDS_H */
@@ -0,0 +1,33 @@
+#include "ExpandCellIDs.h"
+#include "CellIDCompression.h"
+
+// GAUDI
+#include "GaudiKernel/GaudiException.h"
+
+#include <memory>
+#include <stdexcept>
+
+DECLARE_COMPONENT(ExpandCellIDs)
+
+ExpandCellIDs::ExpandCellIDs(const std::string& aName, ISvcLocator* aSvcLoc)
+    : Transformer(aName, aSvcLoc,
+                  {KeyValue("incellids", "hits/caloInCellIDs"), KeyValue("invalues", "hits/caloInValues"),
+                   KeyValue("intypes", "hits/caloInTypes")},
+                  KeyValue("outhits", "hits/caloOutHits")) {}
+
+ExpandCellIDs::~ExpandCellIDs() {}
+
+DataWrapper<edm4hep::CalorimeterHitCollection>
+ExpandCellIDs::operator()(const DataWrapper<podio::UserDataCollection<uint8_t>>& aInCellIDs,
+                          const DataWrapper<podio::UserDataCollection<float>>& aInValues,
+                          const DataWrapper<podio::UserDataCollection<int32_t>>& aInTypes) const {
+  const auto inCellIDs = aInCellIDs.getData();
+  auto outHits = std::make_unique<edm4hep::CalorimeterHitCollection>();
+  try {
+    det::utils::expandCellIDs(*inCellIDs, *aInValues.getData(), *aInTypes.getData(), *outHits);
+  } catch (const std::runtime_error& error) {
+    throw GaudiException("Unable to expand the cell IDs: " + std::string(error.what()), name(), StatusCode::FAILURE);
+  }
+  debug() << "Expanded cell IDs of " << outHits->size() << " hits from " << inCellIDs->size() << " bytes" << endmsg;
+  return DataWrapper<edm4hep::CalorimeterHitCollection>(std::move(outHits));
+}
@@ -0,0 +1,46 @@
+#ifndef DETCOMPONENTS_EXPANDCELLIDS_H
+#define DETCOMPONENTS_EXPANDCELLIDS_H
+
+// GAUDI
+#include "GaudiAlg/Transformer.h"
+
+// FCCSW
+#include "k4FWCore/BaseClass.h"
+#include "k4FWCore/DataWrapper.h"
+#include "podio/UserDataCollection.h"
+
+// datamodel
+#include "edm4hep/CalorimeterHitCollection.h"
+
+/** @class ExpandCellIDs Detector/DetComponents/src/ExpandCellIDs.h ExpandCellIDs.h
+ *
+ *  Restore the hits written with compressed cell IDs (by CompressCellIDs).
+ *  The hits are created in the output collection ('\b outhits') from the encoded cell IDs ('\b incellids'), the
+ *  values ('\b invalues') and the types ('\b intypes') written by CompressCellIDs. The event fails if these
+ *  collections do not match (e.g. the encoded cell IDs are truncated or followed by other data).
+ *
+ *  For an example see Detector/DetComponents/tests/options/compressCellIDs.py
+ *
+ */
+
+class ExpandCellIDs final
+    : public Gaudi::Functional::Transformer<DataWrapper<edm4hep::CalorimeterHitCollection>(
+                                                const DataWrapper<podio::UserDataCollection<uint8_t>>&,
+                                                const DataWrapper<podio::UserDataCollection<float>>&,
+                                                const DataWrapper<podio::UserDataCollection<int32_t>>&),
+                                            BaseClass_t> {
+public:
+  explicit ExpandCellIDs(const std::string&, ISvcLocator*);
+  virtual ~ExpandCellIDs();
+  /**  Restore the hits of one event.
+   *   @param[in] aInCellIDs Encoded cell IDs of the hits.
+   *   @param[in] aInValues Values of the hits.
+   *   @param[in] aInTypes Types of the hits.
+   *   @return Hits with the cell IDs.
+   */
+  virtual DataWrapper<edm4hep::CalorimeterHitCollection>
+  operator()(const DataWrapper<podio::UserDataCollection<uint8_t>>& aInCellIDs,
+             const DataWrapper<podio::UserDataCollection<float>>& aInValues,
+             const DataWrapper<podio::UserDataCollection<int32_t>>& aInTypes) const override;
+};
+#endif /* DETCOMPONENTS_EXPANDCELLIDS_H */
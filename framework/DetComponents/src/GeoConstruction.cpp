@@ -1,7 +1,14 @@
 #include "GeoConstruction.h"
 
+#include <algorithm>
+#include <mutex>
+#include <regex>
 #include <stdexcept>
 
+// FCCSW
+#include "DetCommon/ShowerLibrary.h"
+#include "DetSensitive/ShowerLibraryModel.h"
+
 // DD4hep
 #include "DD4hep/Detector.h"
 #include "DD4hep/Plugins.h"
@@ -9,16 +16,48 @@
 #include "TGeoManager.h"
 
 // Geant4
+#include "G4LogicalVolumeStore.hh"
 #include "G4PVPlacement.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
 #include "G4SDManager.hh"
+#include "G4UserLimits.hh"
 #include "G4VSensitiveDetector.hh"
 
+namespace {
+/// Regions are created once, the stepping actions set in each thread
+std::mutex regionMutex;
+
+/// Logical volumes of a volume: the volume itself, or the daughters of an assembly (not converted to Geant4)
+void collectLogicalVolumes(const TGeoVolume* aVolume, dd4hep::sim::Geant4GeometryInfo& aInfo,
+                           std::vector<G4LogicalVolume*>& aLogicalVolumes) {
+  auto it = aInfo.g4Volumes.find(aVolume);
+  if (it != aInfo.g4Volumes.end() && it->second != nullptr) {
+    aLogicalVolumes.push_back(it->second);
+    return;
+  }
+  for (int iDaughter = 0; iDaughter < aVolume->GetNdaughters(); iDaughter++) {
+    collectLogicalVolumes(aVolume->GetNode(iDaughter)->GetVolume(), aInfo, aLogicalVolumes);
+  }
+}
+}
+
 namespace det {
   
-GeoConstruction::GeoConstruction(dd4hep::Detector& lcdd) : m_lcdd(lcdd) {}
+GeoConstruction::GeoConstruction(dd4hep::Detector& lcdd, const std::vector<RegionDescription>& aRegions,
+                                 bool aCountRegionSteps)
+    : m_lcdd(lcdd), m_regions(aRegions), m_countRegionSteps(aCountRegionSteps) {}
 
 GeoConstruction::~GeoConstruction() {}
 
+bool GeoConstruction::replacesSensitiveDetector(const std::string& aDetectorName) const {
+  return std::any_of(m_regions.begin(), m_regions.end(), [&aDetectorName](const RegionDescription& aRegion) {
+    return !aRegion.showerLibrary.empty() && aRegion.showerLibraryReplaceSD &&
+           std::find(aRegion.detectors.begin(), aRegion.detectors.end(), aDetectorName) != aRegion.detectors.end();
+  });
+}
+
 // method borrowed from dd4hep::sim::Geant4DetectorSensitivesConstruction
 //                             ::constructSensitives(Geant4DetectorConstructionContext* ctxt)
 void GeoConstruction::ConstructSDandField() {
@@ -30,6 +69,11 @@ void GeoConstruction::ConstructSDandField() {
   for (_SV::const_iterator iv = vols.begin(); iv != vols.end(); ++iv) {
     dd4hep::SensitiveDetector sd = (*iv).first;
     std::string typ = sd.type(), nam = sd.name();
+    // on request of the region, the spots of the shower library are recorded by GflashCalorimeterSD
+    // (its hits have no track ID, PDG or time)
+    if (typ == "SimpleCalorimeterSD" && replacesSensitiveDetector(nam)) {
+      typ = "GflashCalorimeterSD";
+    }
     // Sensitive detectors are deleted in ~G4SDManager
     G4VSensitiveDetector* g4sd = dd4hep::PluginService::Create<G4VSensitiveDetector*>(typ, nam, &m_lcdd);
     if (g4sd == nullptr) {
@@ -61,17 +105,115 @@ void GeoConstruction::ConstructSDandField() {
       g4v->SetSensitiveDetector(g4sd);
     }
   }
+  std::lock_guard<std::mutex> lock(regionMutex);
+  constructRegions();
+  constructShowerLibraryModels();
+  if (m_countRegionSteps) {
+    countRegionSteps();
+  }
+}
+
+void GeoConstruction::constructRegions() {
+  dd4hep::sim::Geant4GeometryInfo* p = dd4hep::sim::Geant4Mapping::instance().ptr();
+  for (const auto& description : m_regions) {
+    // already created (other thread, or region of the same name converted by DD4hep)
+    if (G4RegionStore::GetInstance()->GetRegion(description.name, false) != nullptr) {
+      continue;
+    }
+    std::vector<G4LogicalVolume*> volumes;
+    for (const auto& detector : description.detectors) {
+      auto it = m_lcdd.detectors().find(detector);
+      if (it == m_lcdd.detectors().end()) {
+        throw std::runtime_error("ConstructSDandField: Detector " + detector + " of region " + description.name +
+                                 " does not exist.");
+      }
+      collectLogicalVolumes(dd4hep::DetElement(it->second).placement().volume().ptr(), *p, volumes);
+    }
+    for (const auto& pattern : description.volumePatterns) {
+      std::regex expression(pattern);
+      for (auto volume : *G4LogicalVolumeStore::GetInstance()) {
+        if (std::regex_search(volume->GetName(), expression)) {
+          volumes.push_back(volume);
+        }
+      }
+    }
+    if (volumes.empty()) {
+      throw std::runtime_error("ConstructSDandField: No volume of region " + description.name + ".");
+    }
+    // Regions are deleted in ~G4RegionStore(), cuts in ~G4ProductionCutsTable()
+    G4Region* region = new G4Region(description.name);
+    for (auto volume : volumes) {
+      // the volume may be the root volume of a region already (e.g. matching several patterns)
+      if (volume->GetRegion() != region) {
+        region->AddRootLogicalVolume(volume);
+      }
+    }
+    if (description.rangeCut >= 0 || !description.particleCuts.empty()) {
+      auto cuts = new G4ProductionCuts();
+      if (description.rangeCut >= 0) {
+        cuts->SetProductionCut(description.rangeCut);
+      }
+      for (const auto& particleCut : description.particleCuts) {
+        cuts->SetProductionCut(particleCut.second, particleCut.first);
+      }
+      region->SetProductionCuts(cuts);
+    }
+    if (description.hasUserLimits()) {
+      region->SetUserLimits(new G4UserLimits(DBL_MAX, DBL_MAX, description.maxTime, description.minKineticEnergy));
+    }
+  }
+}
+
+void GeoConstruction::constructShowerLibraryModels() {
+  for (const auto& description : m_regions) {
+    if (description.showerLibrary.empty()) {
+      continue;
+    }
+    auto& library = m_showerLibraries[description.showerLibrary];
+    if (library == nullptr) {
+      auto mappedLibrary = std::make_shared<utils::ShowerLibrary>();
+      if (!mappedLibrary->open(description.showerLibrary)) {
+        throw std::runtime_error("ConstructSDandField: Failed to open the shower library " + description.showerLibrary +
+                                 " of region " + description.name + ".");
+      }
+      library = mappedLibrary;
+    }
+    // the model is registered in the G4FastSimulationManager of the region
+    m_showerLibraryModels.push_back(std::make_unique<ShowerLibraryModel>(
+        description.name + "_showerLibrary", G4RegionStore::GetInstance()->GetRegion(description.name, false), library,
+        description.showerLibraryMinEnergy, description.showerLibraryMaxEnergy));
+  }
+}
+
+void GeoConstruction::countRegionSteps() {
+  for (auto region : *G4RegionStore::GetInstance()) {
+    if (region->GetRegionalSteppingAction() != nullptr) {
+      continue;
+    }
+    auto it = std::find_if(m_regionStepCounters.begin(), m_regionStepCounters.end(),
+                           [region](const std::unique_ptr<RegionStepCounter>& aCounter) {
+                             return aCounter->regionName() == region->GetName();
+                           });
+    if (it == m_regionStepCounters.end()) {
+      m_regionStepCounters.push_back(std::make_unique<RegionStepCounter>(region->GetName()));
+      it = std::prev(m_regionStepCounters.end());
+    }
+    region->SetRegionalSteppingAction(it->get());
+  }
 }
 
 // method borrowed from dd4hep::sim::Geant4DetectorConstruction::Construct()
 G4VPhysicalVolume* GeoConstruction::Construct() {
+  if (m_world != nullptr) {
+    return m_world;
+  }
   dd4hep::sim::Geant4Mapping& g4map = dd4hep::sim::Geant4Mapping::instance();
   dd4hep::DetElement world = m_lcdd.world();
   dd4hep::sim::Geant4Converter conv(m_lcdd, dd4hep::DEBUG);
   dd4hep::sim::Geant4GeometryInfo* geo_info = conv.create(world).detach();
   g4map.attach(geo_info);
   // All volumes are deleted in ~G4PhysicalVolumeStore()
-  G4VPhysicalVolume* m_world = geo_info->world();
+  m_world = geo_info->world();
   m_lcdd.apply("DD4hepVolumeManager", 0, 0);
   // Create Geant4 volume manager
   g4map.volumeManager();
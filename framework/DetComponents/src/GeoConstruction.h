@@ -7,14 +7,28 @@
 // Geant4
 #include "G4VUserDetectorConstruction.hh"
 
+#include "GeoRegions.h"
+
+#include <map>
+#include <memory>
+
 namespace dd4hep {
 class Detector;
 }
+namespace det {
+class ShowerLibraryModel;
+namespace utils {
+class ShowerLibrary;
+}
+}
 /** @class GeoConstruction DetectorDescription/DetDesServices/src/GeoConstruction.h GeoConstruction.h
  *
  *  Class to create Geant4 detector geometry from TGeo representation
  *  On demand (ie. when calling "Construct") the DD4hep geometry is converted
  *  to Geant4 with all volumes, assemblies, shapes, materials etc.
+ *  The regions described in the compact files (see GeoRegions.h) are created with the sensitive detectors, each
+ *  optionally with a regional stepping action counting the steps (also in the other regions, e.g. the world), and
+ *  with the fast simulation model replaying the showers of the shower library of the region.
  *
  *  @author Markus Frank
  *  @author Anna Zaborowska
@@ -24,18 +38,45 @@ namespace det {
 class GeoConstruction : public G4VUserDetectorConstruction {
 public:
   /// Constructor
-  GeoConstruction(dd4hep::Detector& lcdd);
+  GeoConstruction(dd4hep::Detector& lcdd, const std::vector<RegionDescription>& aRegions = {},
+                  bool aCountRegionSteps = false);
   /// Default destructor
   virtual ~GeoConstruction();
   /// Geometry construction callback: Invoke the conversion to Geant4
   /// All volumes (including world) are deleted in ~G4PhysicalVolumeStore()
+  /// The conversion is done once, the next calls return the same world (e.g. geometry built before the fork in
+  /// GeoSvc, then constructed again by the run manager)
   virtual G4VPhysicalVolume* Construct() final;
-  /// Construct SD
+  /// Construct SD, the regions and their stepping actions
   virtual void ConstructSDandField() final;
+  /// Step counters of the regions (if the steps are counted)
+  inline const std::vector<std::unique_ptr<RegionStepCounter>>& regionStepCounters() const {
+    return m_regionStepCounters;
+  }
 
 private:
+  /// Create the regions, set their cuts and user limits
+  void constructRegions();
+  /// Set the step counters of all the regions
+  void countRegionSteps();
+  /// Create the models replaying the shower libraries (in each thread)
+  void constructShowerLibraryModels();
+  /// Check if the sensitive detector of the detector is replaced to record the spots of a shower library
+  bool replacesSensitiveDetector(const std::string& aDetectorName) const;
   /// Reference to geometry object
   dd4hep::Detector& m_lcdd;
+  /// Converted world volume
+  G4VPhysicalVolume* m_world = nullptr;
+  /// Regions described in the compact files
+  std::vector<RegionDescription> m_regions;
+  /// Flag to count the steps in the regions
+  bool m_countRegionSteps;
+  /// Step counters of the regions
+  std::vector<std::unique_ptr<RegionStepCounter>> m_regionStepCounters;
+  /// Shower libraries (mapped once, shared by the models of all the threads)
+  std::map<std::string, std::shared_ptr<const utils::ShowerLibrary>> m_showerLibraries;
+  /// Models replaying the shower libraries
+  std::vector<std::unique_ptr<ShowerLibraryModel>> m_showerLibraryModels;
 };
 }
 #endif /* DETDESSERVICES_GEOCONSTRUCTION_H */
@@ -0,0 +1,79 @@
+#include "GeoRegions.h"
+
+// DD4hep
+#include "DD4hep/DD4hepUnits.h"
+#include "DD4hep/DetFactoryHelper.h"
+#include "XML/DocumentHandler.h"
+
+// Geant4
+#include "CLHEP/Units/SystemOfUnits.h"
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+#include <stdexcept>
+
+namespace det {
+std::vector<RegionDescription> readRegions(const std::string& aFileName) {
+  // GeoSvc accepts the file names with the prefix "file:"
+  const std::string prefix = "file:";
+  std::string fileName = aFileName.compare(0, prefix.size(), prefix) == 0 ? aFileName.substr(prefix.size()) : aFileName;
+  dd4hep::xml::DocumentHolder document(dd4hep::xml::DocumentHandler().load(fileName));
+  std::vector<RegionDescription> regions;
+  for (xml_coll_t regionsElement(document.root(), _Unicode(g4regions)); regionsElement; ++regionsElement) {
+    for (xml_coll_t regionElement(regionsElement, _Unicode(g4region)); regionElement; ++regionElement) {
+      xml_comp_t xRegion(regionElement);
+      RegionDescription region;
+      region.name = xRegion.nameStr();
+      if (region.name.empty()) {
+        throw std::runtime_error("Region without a name in " + fileName);
+      }
+      // values converted from DD4hep to Geant4 units
+      if (xRegion.hasAttr(_Unicode(cut))) {
+        region.rangeCut = xRegion.attr<double>(_Unicode(cut)) / dd4hep::mm * CLHEP::mm;
+      }
+      if (xRegion.hasAttr(_Unicode(maxTime))) {
+        region.maxTime = xRegion.attr<double>(_Unicode(maxTime)) / dd4hep::ns * CLHEP::ns;
+      }
+      if (xRegion.hasAttr(_Unicode(minKineticEnergy))) {
+        region.minKineticEnergy = xRegion.attr<double>(_Unicode(minKineticEnergy)) / dd4hep::GeV * CLHEP::GeV;
+      }
+      for (xml_coll_t cut(regionElement, _Unicode(cut)); cut; ++cut) {
+        xml_comp_t xCut(cut);
+        region.particleCuts.emplace_back(xCut.attr<std::string>(_Unicode(particle)),
+                                         xCut.attr<double>(_Unicode(value)) / dd4hep::mm * CLHEP::mm);
+      }
+      for (xml_coll_t library(regionElement, _Unicode(showerlibrary)); library; ++library) {
+        xml_comp_t xLibrary(library);
+        region.showerLibrary = xLibrary.attr<std::string>(_Unicode(file));
+        if (xLibrary.hasAttr(_Unicode(minEnergy))) {
+          region.showerLibraryMinEnergy = xLibrary.attr<double>(_Unicode(minEnergy)) / dd4hep::GeV * CLHEP::GeV;
+        }
+        if (xLibrary.hasAttr(_Unicode(maxEnergy))) {
+          region.showerLibraryMaxEnergy = xLibrary.attr<double>(_Unicode(maxEnergy)) / dd4hep::GeV * CLHEP::GeV;
+        }
+        if (xLibrary.hasAttr(_Unicode(replaceSD))) {
+          region.showerLibraryReplaceSD = xLibrary.attr<bool>(_Unicode(replaceSD));
+        }
+      }
+      for (xml_coll_t detector(regionElement, _Unicode(detector)); detector; ++detector) {
+        region.detectors.push_back(xml_comp_t(detector).nameStr());
+      }
+      for (xml_coll_t volume(regionElement, _Unicode(volume)); volume; ++volume) {
+        region.volumePatterns.push_back(xml_comp_t(volume).attr<std::string>(_Unicode(pattern)));
+      }
+      if (region.detectors.empty() && region.volumePatterns.empty()) {
+        throw std::runtime_error("Region " + region.name + " without detectors or volumes in " + fileName);
+      }
+      regions.push_back(region);
+    }
+  }
+  return regions;
+}
+
+void RegionStepCounter::UserSteppingAction(const G4Step* aStep) {
+  m_steps.fetch_add(1, std::memory_order_relaxed);
+  if (aStep->GetTrack()->GetCurrentStepNumber() == 1) {
+    m_tracks.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+}
@@ -0,0 +1,98 @@
+#ifndef DETCOMPONENTS_GEOREGIONS_H
+#define DETCOMPONENTS_GEOREGIONS_H
+
+// Geant4
+#include "G4UserSteppingAction.hh"
+
+#include <atomic>
+#include <cfloat>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** Geant4 regions with production cuts and user limits, described in the compact files.
+ *
+ *  The regions are read from the element <g4regions> of the compact file given to GeoSvc (the included files are not
+ *  searched), e.g.:
+ *    <g4regions>
+ *      <g4region name="HCalRegion" cut="1*mm" maxTime="100*ns" minKineticEnergy="0.5*MeV">
+ *        <detector name="HCalBarrel"/>
+ *        <volume pattern="ECAL_Cryo_.*"/>
+ *        <cut particle="gamma" value="2*mm"/>
+ *        <showerlibrary file="ECalBarrelShowers.lib" minEnergy="1*GeV" maxEnergy="500*GeV" replaceSD="true"/>
+ *      </g4region>
+ *    </g4regions>
+ *  The top volumes of the detectors (or the daughters of the top assembly) and the logical volumes with names matching
+ *  the patterns (std::regex_search) are the root volumes of the region. The range cut ('cut', for all particles, and
+ *  'cut' elements for a given particle: gamma, e-, e+ or proton) replaces the default one. The user limits (maximum
+ *  time and minimum kinetic energy of the tracks) are only applied if the physics list includes G4UserSpecialCuts.
+ *  With a shower library (det::utils::ShowerLibrary, written by CreateShowerLibrary), the electromagnetic showers
+ *  starting at the surface of the region are replayed from the library (det::ShowerLibraryModel, needs the fast
+ *  simulation process in the physics list). The spots are only recorded by the sensitive detectors implementing
+ *  G4VGFlashSensitiveDetector (GflashCalorimeterSD), the other spots are dropped. With 'replaceSD' (false by default)
+ *  the SimpleCalorimeterSD of the detectors of the region are replaced by GflashCalorimeterSD: in the full simulation
+ *  its hits have the cell ID, position and energy of the SimpleCalorimeterSD hits, but no track ID, PDG code or time.
+ *  The regions are created in GeoConstruction::ConstructSDandField.
+ */
+
+namespace det {
+/// Region described in the compact file (values in Geant4 units)
+struct RegionDescription {
+  /// name of the region
+  std::string name;
+  /// detectors (top volumes) of the region
+  std::vector<std::string> detectors;
+  /// regular expressions of the names of the logical volumes of the region
+  std::vector<std::string> volumePatterns;
+  /// range cut of all the particles, negative for the default cut
+  double rangeCut = -1;
+  /// range cuts of given particles
+  std::vector<std::pair<std::string, double>> particleCuts;
+  /// maximum time of the tracks
+  double maxTime = DBL_MAX;
+  /// minimum kinetic energy of the tracks
+  double minKineticEnergy = 0;
+  /// file of the shower library replayed in the region, empty for the full simulation
+  std::string showerLibrary;
+  /// energy range of the particles simulated with the shower library
+  double showerLibraryMinEnergy = 0;
+  double showerLibraryMaxEnergy = DBL_MAX;
+  /// flag to replace SimpleCalorimeterSD of the detectors by GflashCalorimeterSD, recording the spots of the library
+  bool showerLibraryReplaceSD = false;
+  /// check if the region has user limits
+  inline bool hasUserLimits() const { return maxTime < DBL_MAX || minKineticEnergy > 0; }
+};
+
+/** Read the regions of a compact file.
+ *  Throws std::runtime_error if a region has no name or no volume.
+ *  @param[in] aFileName Name of the compact file.
+ *  return Regions, empty if the file has no <g4regions> element.
+ */
+std::vector<RegionDescription> readRegions(const std::string& aFileName);
+
+/** Regional stepping action counting the steps and the tracks starting in a region.
+ *  The counters are atomic, the same action can be set for the region in all the threads.
+ */
+class RegionStepCounter : public G4UserSteppingAction {
+public:
+  explicit RegionStepCounter(const std::string& aRegionName) : m_regionName(aRegionName) {}
+  virtual ~RegionStepCounter() = default;
+  /// Count the step (and the track at its first step)
+  virtual void UserSteppingAction(const G4Step* aStep) final;
+  /// Name of the region
+  inline const std::string& regionName() const { return m_regionName; }
+  /// Number of the steps in the region
+  inline uint64_t steps() const { return m_steps; }
+  /// Number of the tracks with the first step in the region
+  inline uint64_t tracks() const { return m_tracks; }
+
+private:
+  /// name of the region
+  std::string m_regionName;
+  /// counters
+  std::atomic<uint64_t> m_steps{0};
+  std::atomic<uint64_t> m_tracks{0};
+};
+}
+#endif /* DETCOMPONENTS_GEOREGIONS_H */
@@ -1,15 +1,43 @@
 
 #include "GeoSvc.h"
+#include "Gaudi/Interfaces/IOptionsSvc.h"
+#include "Gaudi/Parsers/CommonParsers.h"
 #include "GaudiKernel/Service.h"
+#include "GaudiKernel/ToStream.h"
 #include "GeoConstruction.h"
+#include "TFileMerger.h"
 #include "TGeoManager.h"
 
 #include "DD4hep/Printout.h"
+#include "DD4hep/Readout.h"
+#include "DetSegmentation/GridEta.h"
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+// POSIX
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 using namespace Gaudi;
 
 DECLARE_COMPONENT(GeoSvc)
 
+namespace {
+/// Name of the output file of a worker: suffix "_worker<index>" before the extension
+std::string workerFileName(const std::string& aFileName, unsigned aIndex) {
+  const std::string suffix = "_worker" + std::to_string(aIndex);
+  auto dot = aFileName.rfind('.');
+  auto slash = aFileName.rfind('/');
+  if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+    return aFileName + suffix;
+  }
+  return aFileName.substr(0, dot) + suffix + aFileName.substr(dot);
+}
+}
+
 GeoSvc::GeoSvc(const std::string& name, ISvcLocator* svc)
 : base_class(name, svc), m_dd4hepgeo(0), m_geant4geo(0) {}
 
@@ -37,11 +65,147 @@ StatusCode GeoSvc::initialize() {
     error() << "Could not build Geant4 geometry" << endmsg;
   else
     info() << "Geant4 geometry SUCCESSFULLY built" << endmsg;
+  if (m_numWorkers > 1) {
+    // Geant4 geometry converted before the fork to be shared by the workers (the world is kept by GeoConstruction)
+    m_geant4geo->Construct();
+    if (forkWorkers().isFailure()) {
+      return StatusCode::FAILURE;
+    }
+  }
   // TODO: return failure
   return StatusCode::SUCCESS;
 }
 
-StatusCode GeoSvc::finalize() { return StatusCode::SUCCESS; }
+StatusCode GeoSvc::finalize() {
+  if (m_regionStepReport) {
+    printRegionStepReport();
+  }
+  if (m_workerIndex == 0 && !m_workerPids.empty()) {
+    return mergeWorkerOutputs();
+  }
+  return StatusCode::SUCCESS;
+}
+
+StatusCode GeoSvc::forkWorkers() {
+  auto appMgr = serviceLocator().as<IProperty>();
+  long numEvents = appMgr ? std::stol(appMgr->getProperty("EvtMax").toString()) : -1;
+  if (numEvents <= 0) {
+    error() << "Number of events (ApplicationMgr.EvtMax) needs to be positive to be divided between the workers."
+            << endmsg;
+    return StatusCode::FAILURE;
+  }
+  // output files of the workers, merged by the parent process
+  auto& options = serviceLocator()->getOptsSvc();
+  for (const auto& output : m_workerOutputs) {
+    std::string fileName;
+    if (!options.has(output) || Gaudi::Parsers::parse(fileName, options.get(output)).isFailure()) {
+      error() << "Output <<" << output << ">> of the workers is not a file name set in the options." << endmsg;
+      return StatusCode::FAILURE;
+    }
+    std::vector<std::string> workerFiles;
+    for (unsigned i = 0; i < m_numWorkers; i++) {
+      workerFiles.push_back(workerFileName(fileName, i));
+    }
+    m_mergedOutputs.emplace_back(fileName, workerFiles);
+  }
+  info() << "Forking " << m_numWorkers - 1 << " workers sharing the geometry, " << numEvents << " events in total"
+         << endmsg;
+  // buffered output would be written by each process
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+  for (unsigned i = 1; i < m_numWorkers; i++) {
+    pid_t pid = fork();
+    if (pid < 0) {
+      error() << "Could not fork worker " << i << ", stopping the " << m_workerPids.size() << " started workers"
+              << endmsg;
+      // the started workers would run their events and write their outputs without being merged
+      for (pid_t workerPid : m_workerPids) {
+        kill(workerPid, SIGKILL);
+      }
+      for (pid_t workerPid : m_workerPids) {
+        waitpid(workerPid, nullptr, 0);
+      }
+      m_workerPids.clear();
+      m_mergedOutputs.clear();
+      return StatusCode::FAILURE;
+    }
+    if (pid == 0) {
+      m_workerIndex = i;
+      m_workerPids.clear();
+      m_mergedOutputs.clear();
+      break;
+    }
+    m_workerPids.push_back(pid);
+  }
+  return configureWorker(numEvents);
+}
+
+StatusCode GeoSvc::configureWorker(long aNumEvents) {
+  // the first (number of events % number of workers) workers process one more event
+  long numEvents = aNumEvents / m_numWorkers.value() + (m_workerIndex < aNumEvents % m_numWorkers.value() ? 1 : 0);
+  if (serviceLocator().as<IProperty>()->setProperty("EvtMax", static_cast<int>(numEvents)).isFailure()) {
+    error() << "Could not set the number of events of worker " << m_workerIndex << endmsg;
+    return StatusCode::FAILURE;
+  }
+  auto& options = serviceLocator()->getOptsSvc();
+  for (const auto& output : m_workerOutputs) {
+    std::string fileName;
+    Gaudi::Parsers::parse(fileName, options.get(output)).ignore();
+    options.set(output, Gaudi::Utils::toString(workerFileName(fileName, m_workerIndex)));
+  }
+  for (const auto& seed : m_workerSeeds) {
+    long value = 0;
+    std::vector<long> values;
+    if (options.has(seed) && Gaudi::Parsers::parse(value, options.get(seed)).isSuccess()) {
+      options.set(seed, Gaudi::Utils::toString(value + m_workerIndex));
+    } else if (options.has(seed) && Gaudi::Parsers::parse(values, options.get(seed)).isSuccess()) {
+      for (auto& element : values) {
+        element += m_workerIndex;
+      }
+      options.set(seed, Gaudi::Utils::toString(values));
+    } else {
+      error() << "Seed <<" << seed << ">> of the workers is not an integer (or a list) set in the options." << endmsg;
+      return StatusCode::FAILURE;
+    }
+  }
+  info() << "Worker " << m_workerIndex << " (process " << getpid() << "): " << numEvents << " events" << endmsg;
+  return StatusCode::SUCCESS;
+}
+
+StatusCode GeoSvc::mergeWorkerOutputs() {
+  bool success = true;
+  for (size_t i = 0; i < m_workerPids.size(); i++) {
+    int status = 0;
+    if (waitpid(m_workerPids[i], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+      error() << "Worker " << i + 1 << " (process " << m_workerPids[i] << ") failed." << endmsg;
+      success = false;
+    }
+  }
+  m_workerPids.clear();
+  if (!success) {
+    error() << "Outputs of the workers are not merged." << endmsg;
+    return StatusCode::FAILURE;
+  }
+  for (const auto& output : m_mergedOutputs) {
+    TFileMerger merger(false);
+    bool merged = merger.OutputFile(output.first.c_str(), "RECREATE");
+    for (const auto& fileName : output.second) {
+      merged = merged && merger.AddFile(fileName.c_str(), false);
+    }
+    if (!merged || !merger.Merge()) {
+      error() << "Could not merge the outputs of the workers into " << output.first << endmsg;
+      return StatusCode::FAILURE;
+    }
+    info() << "Outputs of " << output.second.size() << " workers merged into " << output.first << endmsg;
+    if (!m_keepWorkerOutputs) {
+      for (const auto& fileName : output.second) {
+        std::remove(fileName.c_str());
+      }
+    }
+  }
+  return StatusCode::SUCCESS;
+}
 
 StatusCode GeoSvc::buildDD4HepGeo() {
   // we retrieve the the static instance of the DD4HEP::Geometry
@@ -52,9 +216,27 @@ StatusCode GeoSvc::buildDD4HepGeo() {
   for (auto& filename : m_xmlFileNames) {
     info() << "loading geometry from file:  '" << filename << "'" << endmsg;
     m_dd4hepgeo->fromCompact(filename);
+    try {
+      auto regions = det::readRegions(filename);
+      for (const auto& region : regions) {
+        debug() << "Geant4 region " << region.name << " read from file '" << filename << "'" << endmsg;
+      }
+      m_regions.insert(m_regions.end(), regions.begin(), regions.end());
+    } catch (const std::runtime_error& e) {
+      error() << e.what() << endmsg;
+      return StatusCode::FAILURE;
+    }
   }
   m_dd4hepgeo->volumeManager();
   m_dd4hepgeo->apply("DD4hepVolumeManager", 0, 0);
+  // lookups of the bins of the eta segmentations, once their parameters are read
+  for (const auto& entry : m_dd4hepgeo->readouts()) {
+    dd4hep::Readout readout(entry.second);
+    if (auto gridEta = dynamic_cast<dd4hep::DDSegmentation::GridEta*>(readout.segmentation().segmentation())) {
+      gridEta->prepareBinningLookup();
+      debug() << "Binning lookup prepared for readout " << entry.first << endmsg;
+    }
+  }
 
   return StatusCode::SUCCESS;
 }
@@ -64,7 +246,7 @@ dd4hep::Detector* GeoSvc::lcdd() { return (m_dd4hepgeo); }
 dd4hep::DetElement GeoSvc::getDD4HepGeo() { return (lcdd()->world()); }
 
 StatusCode GeoSvc::buildGeant4Geo() {
-  std::shared_ptr<G4VUserDetectorConstruction> detector(new det::GeoConstruction(*lcdd()));
+  std::shared_ptr<G4VUserDetectorConstruction> detector(new det::GeoConstruction(*lcdd(), m_regions, m_regionStepReport));
   m_geant4geo = detector;
   if (m_geant4geo) {
     return StatusCode::SUCCESS;
@@ -74,3 +256,23 @@ StatusCode GeoSvc::buildGeant4Geo() {
 
 G4VUserDetectorConstruction* GeoSvc::getGeant4Geo() { return (m_geant4geo.get()); }
 
+void GeoSvc::printRegionStepReport() {
+  auto construction = dynamic_cast<det::GeoConstruction*>(m_geant4geo.get());
+  if (construction == nullptr || construction->regionStepCounters().empty()) {
+    warning() << "No steps counted in the Geant4 regions (geometry not constructed)" << endmsg;
+    return;
+  }
+  uint64_t totalSteps = 0;
+  for (const auto& counter : construction->regionStepCounters()) {
+    totalSteps += counter->steps();
+  }
+  info() << "Steps and tracks in the Geant4 regions" << (m_workerIndex > 0 ? " of the worker " : "")
+         << (m_workerIndex > 0 ? std::to_string(m_workerIndex) : "") << ":" << endmsg;
+  for (const auto& counter : construction->regionStepCounters()) {
+    info() << std::setw(40) << std::left << counter->regionName() << std::setw(14) << std::right << counter->steps()
+           << " steps (" << std::fixed << std::setprecision(1)
+           << (totalSteps > 0 ? 100. * counter->steps() / totalSteps : 0.) << " %)" << std::setw(12)
+           << counter->tracks() << " tracks" << endmsg;
+  }
+}
+
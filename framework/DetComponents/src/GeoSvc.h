@@ -19,6 +19,30 @@
 #include "G4RunManager.hh"
 #include "G4VUserDetectorConstruction.hh"
 
+#include "GeoRegions.h"
+
+#include <sys/types.h>
+
+/** @class GeoSvc Detector/DetComponents/src/GeoSvc.h GeoSvc.h
+ *
+ *  Service building the DD4hep geometry from the XML-files '\b detectors' and the Geant4 detector construction.
+ *
+ *  If '\b numberOfWorkers' is larger than 1, the process is forked after the DD4hep and Geant4 geometries are built
+ *  (at the initialization of the service): the workers share the memory of the geometry copy-on-write and skip its
+ *  construction. The parent process is the worker 0. The events (ApplicationMgr.EvtMax, has to be positive) are
+ *  divided between the workers. The output files ('\b workerOutputs', as "Component.Property", set in the options)
+ *  get the suffix "_worker<index>" and are merged (TFileMerger) into the original file by the parent process in
+ *  finalize, once all the workers finished. The integer properties '\b workerSeeds' ("Component.Property") are
+ *  incremented by the worker index, so that the workers generate different events.
+ *  Only for sequential (not multi-threaded) Gaudi and Geant4: no threads may run at the initialization of GeoSvc.
+ *  The outputs need to be closed before GeoSvc is finalized (by the algorithms, or the services initialized after
+ *  GeoSvc).
+ *
+ *  The Geant4 regions with their production cuts and user limits are read from the <g4regions> element of the
+ *  XML-files (see GeoRegions.h). With '\b regionStepReport' the steps and tracks in each region are counted and
+ *  printed in finalize.
+ */
+
 class GeoSvc : public extends<Service, IGeoSvc> {
 
 public:
@@ -40,14 +64,54 @@ public:
   virtual dd4hep::Detector* lcdd() override;
   // receive Geant4 Geometry
   virtual G4VUserDetectorConstruction* getGeant4Geo() override;
+  /// Index of the worker process (0 for the parent process, or without workers)
+  inline unsigned workerIndex() const { return m_workerIndex; }
 
 private:
+  /**  Fork the worker processes, configure the events, outputs and seeds of each process.
+   *   @return status code
+   */
+  StatusCode forkWorkers();
+  /**  Set the events, outputs and seeds of the worker in the job options of the other components.
+   *   @param[in] aNumEvents Number of events of all the workers.
+   *   @return status code
+   */
+  StatusCode configureWorker(long aNumEvents);
+  /**  Wait for the workers and merge their outputs (parent process).
+   *   @return status code
+   */
+  StatusCode mergeWorkerOutputs();
+  /// Print the number of the steps and tracks in each region
+  void printRegionStepReport();
   /// Pointer to the interface to the DD4hep geometry
   dd4hep::Detector* m_dd4hepgeo;
   /// Pointer to the detector construction of DDG4
   std::shared_ptr<G4VUserDetectorConstruction> m_geant4geo;
   /// XML-files with the detector description
   Gaudi::Property<std::vector<std::string>> m_xmlFileNames{this, "detectors", {}, "Detector descriptions XML-files"};
+  /// Number of the processes sharing the geometry (forked after it is built)
+  Gaudi::Property<unsigned> m_numWorkers{this, "numberOfWorkers", 0,
+                                         "Number of processes forked after the geometry is built (<2: no fork)"};
+  /// Output files of the workers, merged at the end
+  Gaudi::Property<std::vector<std::string>> m_workerOutputs{
+      this, "workerOutputs", {}, "Output file properties ('Component.Property') of the workers, merged at the end"};
+  /// Seeds incremented by the worker index
+  Gaudi::Property<std::vector<std::string>> m_workerSeeds{
+      this, "workerSeeds", {}, "Integer seed properties ('Component.Property') incremented by the worker index"};
+  /// Flag to keep the output files of the workers after the merge
+  Gaudi::Property<bool> m_keepWorkerOutputs{this, "keepWorkerOutputs", false,
+                                            "Keep the output files of the workers after they are merged"};
+  /// Flag to count the steps in each Geant4 region
+  Gaudi::Property<bool> m_regionStepReport{this, "regionStepReport", false,
+                                           "Count the steps and tracks in each Geant4 region, print them in finalize"};
+  /// Regions read from the XML-files
+  std::vector<det::RegionDescription> m_regions;
+  /// Index of the worker process
+  unsigned m_workerIndex = 0;
+  /// Process IDs of the workers (parent process)
+  std::vector<pid_t> m_workerPids;
+  /// Output files and the files of the workers to be merged into them (parent process)
+  std::vector<std::pair<std::string, std::vector<std::string>>> m_mergedOutputs;
 };
 
 #endif  // GEOSVC_H
@@ -1,14 +1,20 @@
 #include "RedoSegmentation.h"
 
 // FCCSW
+#include "DetCommon/RadixSort.h"
+
 #include "k4Interface/IGeoSvc.h"
 
 // datamodel
 #include "edm4hep/CalorimeterHitCollection.h"
 
+#include <algorithm>
+#include <limits>
+
 // DD4hep
 #include "DD4hep/Detector.h"
 #include "DDSegmentation/Segmentation.h"
+#include "DetSegmentation/GridEta.h"
 
 DECLARE_COMPONENT(RedoSegmentation)
 
@@ -66,10 +72,26 @@ StatusCode RedoSegmentation::initialize() {
       return StatusCode::FAILURE;
     }
   }
+  m_detectorFieldCopy = det::utils::BitFieldCopy(*m_oldDecoder, *m_segmentation->decoder(), m_detectorIdentifiers);
+  if (m_mergedTime != "min" && m_mergedTime != "energyWeighted") {
+    error() << "Unknown time of the merged hits <<" << m_mergedTime.value() << ">>, use 'min' or 'energyWeighted'."
+            << endmsg;
+    return StatusCode::FAILURE;
+  }
+  m_energyWeightedTime = (m_mergedTime == "energyWeighted");
+  if (auto gridEta = dynamic_cast<dd4hep::DDSegmentation::GridEta*>(m_segmentation)) {
+    // eta (and phi) bins found without the calculation of the angles, same cell IDs
+    gridEta->prepareBinningLookup();
+    m_batchSegmentation = gridEta;
+  }
   info() << "Redoing the segmentation." << endmsg;
   info() << "Old bitfield:\t" << m_oldDecoder->fieldDescription() << endmsg;
   info() << "New bitfield:\t" << m_segmentation->decoder()->fieldDescription() << endmsg;
-  info() << "New segmentation is of type:\t" << m_segmentation->type() << endmsg;
+  info() << "New segmentation is of type:\t" << m_segmentation->type()
+         << (m_batchSegmentation ? " (cell IDs calculated in batches)" : "") << endmsg;
+  if (m_mergeHits) {
+    info() << "Hits with the same new cell ID are merged (time: " << m_mergedTime.value() << ")." << endmsg;
+  }
 
   return StatusCode::SUCCESS;
 }
@@ -77,32 +99,77 @@ StatusCode RedoSegmentation::initialize() {
 StatusCode RedoSegmentation::execute() {
   const auto inHits = m_inHits.get();
   auto outHits = m_outHits.createAndPut();
-  // loop over positioned hits to get the energy deposits: position and cellID
-  // cellID contains the volumeID that needs to be copied to the new id
-  dd4hep::DDSegmentation::CellID oldid = 0;
-  uint debugIter = 0;
-  for (const auto& hit : *inHits) {
-    edm4hep::CalorimeterHit newHit = outHits->create();
-    newHit.setEnergy(hit.getEnergy());
-    newHit.setTime(hit.getTime());
-    dd4hep::DDSegmentation::CellID cellId = hit.getCellID();
-    if (debugIter < m_debugPrint) {
-      debug() << "OLD: " << m_oldDecoder->valueString(cellId) << endmsg;
-    }
+  // first calculate the new cell IDs of all the hits:
+  // the detector fields (volume ID) are copied from the old cell ID, then the new segmentation fields are set
+  m_positions.resize(inHits->size());
+  m_volumeIDs.resize(inHits->size());
+  for (size_t iHit = 0; iHit < inHits->size(); ++iHit) {
+    const auto& hit = (*inHits)[iHit];
     // factor 10 to convert mm to cm // TODO: check
     auto pos = hit.getPosition();
-    dd4hep::DDSegmentation::Vector3D position(pos.x / 10., pos.y / 10., pos.z / 10.);
-    // first calculate proper segmentation fields
-    dd4hep::DDSegmentation::CellID newCellId = m_segmentation->cellID(position, position, 0);
-    // now rewrite all other fields (detector ID)
-    for (const auto& detectorField : m_detectorIdentifiers) {
-      oldid = m_oldDecoder->get(cellId, detectorField);
-      m_segmentation->decoder()->set(newCellId, detectorField, oldid);
+    m_positions[iHit] = dd4hep::DDSegmentation::Vector3D(pos.x / 10., pos.y / 10., pos.z / 10.);
+    m_volumeIDs[iHit] = m_detectorFieldCopy.copy(hit.getCellID());
+  }
+  if (m_batchSegmentation) {
+    m_batchSegmentation->cellIDs(m_positions, m_volumeIDs, m_newCellIDs);
+  } else {
+    m_newCellIDs.resize(inHits->size());
+    for (size_t iHit = 0; iHit < inHits->size(); ++iHit) {
+      m_newCellIDs[iHit] = m_segmentation->cellID(m_positions[iHit], m_positions[iHit], m_volumeIDs[iHit]);
+    }
+  }
+  uint debugIter = 0;
+  if (m_mergeHits) {
+    // hits sorted by the new cell ID, each run of the same cell ID is summed into one hit
+    det::utils::radixSortOrder(m_newCellIDs, m_order);
+    size_t iFirst = 0;
+    while (iFirst < m_order.size()) {
+      const auto cellID = m_newCellIDs[m_order[iFirst]];
+      double energy = 0, weightedTime = 0, x = 0, y = 0, z = 0;
+      float minTime = std::numeric_limits<float>::max();
+      size_t iLast = iFirst;
+      for (; iLast < m_order.size() && m_newCellIDs[m_order[iLast]] == cellID; ++iLast) {
+        const auto& hit = (*inHits)[m_order[iLast]];
+        const double hitEnergy = hit.getEnergy();
+        const auto pos = hit.getPosition();
+        energy += hitEnergy;
+        weightedTime += hitEnergy * hit.getTime();
+        minTime = std::min(minTime, hit.getTime());
+        x += hitEnergy * pos.x;
+        y += hitEnergy * pos.y;
+        z += hitEnergy * pos.z;
+      }
+      edm4hep::CalorimeterHit newHit = outHits->create();
+      newHit.setEnergy(energy);
+      // hits without deposit: the earliest time and the position of the first hit
+      if (energy > 0) {
+        newHit.setTime(m_energyWeightedTime ? weightedTime / energy : minTime);
+        newHit.setPosition(edm4hep::Vector3f(x / energy, y / energy, z / energy));
+      } else {
+        newHit.setTime(minTime);
+        newHit.setPosition((*inHits)[m_order[iFirst]].getPosition());
+      }
+      newHit.setCellID(cellID);
+      if (debugIter < m_debugPrint) {
+        debug() << "NEW: " << m_segmentation->decoder()->valueString(cellID) << " merged from " << iLast - iFirst
+                << " hits" << endmsg;
+        debugIter++;
+      }
+      iFirst = iLast;
     }
-    newHit.setCellID(newCellId);
-    if (debugIter < m_debugPrint) {
-      debug() << "NEW: " << m_segmentation->decoder()->valueString(newCellId) << endmsg;
-      debugIter++;
+  } else {
+    // loop over positioned hits to get the energy deposits and the new cellID
+    for (size_t iHit = 0; iHit < inHits->size(); ++iHit) {
+      const auto& hit = (*inHits)[iHit];
+      edm4hep::CalorimeterHit newHit = outHits->create();
+      newHit.setEnergy(hit.getEnergy());
+      newHit.setTime(hit.getTime());
+      newHit.setCellID(m_newCellIDs[iHit]);
+      if (debugIter < m_debugPrint) {
+        debug() << "OLD: " << m_oldDecoder->valueString(hit.getCellID()) << endmsg;
+        debug() << "NEW: " << m_segmentation->decoder()->valueString(m_newCellIDs[iHit]) << endmsg;
+        debugIter++;
+      }
     }
   }
   return StatusCode::SUCCESS;
@@ -7,6 +7,7 @@
 
 // FCCSW
 #include "k4FWCore/DataHandle.h"
+#include "DetCommon/BitFieldCopy.h"
 class IGeoSvc;
 
 // DD4hep
@@ -14,6 +15,7 @@ class IGeoSvc;
 namespace dd4hep {
 namespace DDSegmentation {
 class Segmentation;
+class GridEta;
 }
 }
 
@@ -30,6 +32,14 @@ class CalorimeterHitCollection;
  *  Cell IDs are rewritten from the old readout (`\b oldReadoutName`) to the new readout (`\b newReadoutName`).
  *  Names of the old segmentation fields need to be passed as a vector '\b oldSegmentationIds'.
  *  Those fields are replaced by the new segmentation.
+ *  The detector fields are copied with masks prepared in initialize(). If the new segmentation is GridEta (or
+ *  derived), the new cell IDs of all the hits of the event are calculated in one batched call, with the binning
+ *  lookup of the segmentation (GridEta::prepareBinningLookup).
+ *
+ *  If '\b mergeHits' is set, the hits with the same new cell ID are merged into one hit: the energy is summed, the
+ *  time is the earliest one ('\b mergedTime' = "min") or the energy-weighted mean ("energyWeighted") and the
+ *  position is the energy-weighted mean of the true positions. The merged hits are written sorted by the cell ID
+ *  (radix sort of the new cell IDs, see DetCommon/RadixSort.h).
  *
  *  For an example see Detector/DetComponents/tests/options/redoSegmentationXYZ.py
  *  and Detector/DetComponents/tests/options/redoSegmentationRPhi.py.
@@ -80,6 +90,25 @@ private:
       this, "oldSegmentationIds", {}, "Segmentation fields that are going to be replaced by the new segmentation"};
   /// Detector fields that are going to be rewritten
   std::vector<std::string> m_detectorIdentifiers;
+  /// Copy of the detector fields from the old to the new bitfield
+  det::utils::BitFieldCopy m_detectorFieldCopy;
+  /// New segmentation if it calculates the cell IDs in batches, nullptr otherwise
+  const dd4hep::DDSegmentation::GridEta* m_batchSegmentation = nullptr;
+  /// Positions (in cm) and volume IDs of the hits of the event
+  std::vector<dd4hep::DDSegmentation::Vector3D> m_positions;
+  std::vector<dd4hep::DDSegmentation::VolumeID> m_volumeIDs;
+  /// New cell IDs of the hits of the event
+  std::vector<dd4hep::DDSegmentation::CellID> m_newCellIDs;
+  /// Order of the hits sorted by the new cell ID (if mergeHits)
+  std::vector<uint32_t> m_order;
+  /// Flag to merge the hits with the same new cell ID
+  Gaudi::Property<bool> m_mergeHits{this, "mergeHits", false,
+                                    "Merge the hits with the same new cellID into one hit (written sorted by cellID)"};
+  /// Time of the merged hits
+  Gaudi::Property<std::string> m_mergedTime{this, "mergedTime", "min",
+                                            "Time of the merged hit: 'min' or 'energyWeighted'"};
+  /// Flag to calculate the energy-weighted time of the merged hits (otherwise the earliest time)
+  bool m_energyWeightedTime = false;
   /// Limit of debug printing
   Gaudi::Property<uint> m_debugPrint{this, "debugPrint", 10, "Limit of debug printing"};
 };
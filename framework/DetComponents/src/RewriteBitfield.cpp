@@ -64,6 +64,7 @@ StatusCode RewriteBitfield::initialize() {
       return StatusCode::FAILURE;
     }
   }
+  m_detectorFieldCopy = det::utils::BitFieldCopy(*m_oldDecoder, *m_newDecoder, m_detectorIdentifiers);
   info() << "Rewritting the readout bitfield." << endmsg;
   info() << "Old bitfield:\t" << m_oldDecoder->fieldDescription() << endmsg;
   info() << "New bitfield:\t" << m_newDecoder->fieldDescription() << endmsg;
@@ -76,7 +77,6 @@ StatusCode RewriteBitfield::execute() {
   auto outHits = m_outHits.createAndPut();
   // loop over positioned hits to get the energy deposits: position and cellID
   // cellID contains the volumeID that needs to be copied to the new id
-  uint64_t oldid = 0;
   uint debugIter = 0;
   for (const auto& hit : *inHits) {
     edm4hep::CalorimeterHit newHit = outHits->create();
@@ -87,11 +87,7 @@ StatusCode RewriteBitfield::execute() {
       debug() << "OLD: " << m_oldDecoder->valueString(cID) << endmsg;
     }
     // now rewrite all fields except for those to be removed
-    dd4hep::DDSegmentation::CellID newID=0;
-    for (const auto& detectorField : m_detectorIdentifiers) {
-      oldid = m_oldDecoder->get(cID, detectorField);
-      m_newDecoder->set(newID, detectorField, oldid);
-    }
+    dd4hep::DDSegmentation::CellID newID = m_detectorFieldCopy.copy(cID);
     newHit.setCellID(newID);
     if (debugIter < m_debugPrint) {
       debug() << "NEW: " << m_newDecoder->valueString(newID) << endmsg;
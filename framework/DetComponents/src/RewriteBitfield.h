@@ -7,6 +7,7 @@
 
 // FCCSW
 #include "k4FWCore/DataHandle.h"
+#include "DetCommon/BitFieldCopy.h"
 class IGeoSvc;
 
 // DD4hep
@@ -74,6 +75,8 @@ private:
       this, "removeIds", {}, "Segmentation fields that are going to be removed"};
   /// Detector fields that are going to be rewritten ( = old field - to be removed)
   std::vector<std::string> m_detectorIdentifiers;
+  /// Copy of the detector fields from the old to the new bitfield, prepared in initialize
+  det::utils::BitFieldCopy m_detectorFieldCopy;
   /// Limit of debug printing
   Gaudi::Property<uint> m_debugPrint{this, "debugPrint", 10, "Limit of debug printing"};
 };
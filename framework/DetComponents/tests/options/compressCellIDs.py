@@ -0,0 +1,67 @@
+from Gaudi.Configuration import *
+from Configurables import ApplicationMgr
+
+from Configurables import MomentumRangeParticleGun
+from GaudiKernel import PhysicalConstants as constants
+guntool = MomentumRangeParticleGun("Gun")
+guntool.ThetaMin = 0
+guntool.ThetaMax = 2 * constants.pi
+guntool.PdgCodes = [11]
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider=guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter("Converter")
+hepmc_converter.hepmc.Path="hepmc"
+hepmc_converter.genparticles.Path="allGenParticles"
+hepmc_converter.genvertices.Path="allGenVertices"
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=['file:Test/TestGeometry/data/TestBoxCaloSD_3readouts.xml'], OutputLevel = INFO)
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", physicslist='SimG4TestPhysicsList')
+
+from Configurables import SimG4Alg, SimG4SaveCalHits
+savecaltool = SimG4SaveCalHits("saveECalHits", readoutNames = ["ECalHits"])
+savecaltool.positionedCaloHits.Path = "CaloHitsPositions"
+savecaltool.caloHits.Path = "CaloHits"
+geantsim = SimG4Alg("SimG4Alg", outputs= ["SimG4SaveCalHits/saveECalHits"])
+
+# merge cells
+from Configurables import MergeCells
+merge = MergeCells("mergeCells",
+                   readout ="ECalHits",
+                   identifier = "x",
+                   merge = 3)
+merge.inhits.Path = "CaloHits"
+merge.outhits.Path = "CaloHitsMerged"
+
+# write the merged hits sorted by cellID, without the cellIDs: encoded cellIDs, values and types of the hits
+from Configurables import CompressCellIDs
+compress = CompressCellIDs("compressCellIDs", OutputLevel = DEBUG)
+compress.inhits = "CaloHitsMerged"
+compress.outcellids = "CaloHitsMergedCellIDs"
+compress.outvalues = "CaloHitsMergedValues"
+compress.outtypes = "CaloHitsMergedTypes"
+
+# restore the merged hits
+from Configurables import ExpandCellIDs
+expand = ExpandCellIDs("expandCellIDs", OutputLevel = DEBUG)
+expand.incellids = "CaloHitsMergedCellIDs"
+expand.invalues = "CaloHitsMergedValues"
+expand.intypes = "CaloHitsMergedTypes"
+expand.outhits = "CaloHitsMergedExpanded"
+
+from Configurables import FCCDataSvc, PodioOutput
+podiosvc = FCCDataSvc("EventDataSvc")
+out = PodioOutput("out", filename="output_test_compressCellIDs.root")
+out.outputCommands = ["keep *"]
+
+ApplicationMgr(EvtSel='NONE',
+               EvtMax=10,
+               TopAlg=[gen, hepmc_converter, geantsim, merge, compress, expand, out],
+               ExtSvc = [podiosvc, geoservice, geantservice],
+               OutputLevel=INFO)
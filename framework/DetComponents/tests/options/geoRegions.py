@@ -0,0 +1,42 @@
+from Gaudi.Configuration import *
+from Configurables import ApplicationMgr
+
+from Configurables import MomentumRangeParticleGun
+from GaudiKernel import SystemOfUnits as units
+guntool = MomentumRangeParticleGun("Gun")
+guntool.MomentumMin = 50 * units.GeV
+guntool.MomentumMax = 50 * units.GeV
+guntool.PdgCodes = [11]
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider=guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter("Converter")
+hepmc_converter.hepmc.Path="hepmc"
+hepmc_converter.genparticles.Path="allGenParticles"
+hepmc_converter.genvertices.Path="allGenVertices"
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=['file:Detector/DetFCChhBaseline1/compact/FCChh_DectEmptyMaster.xml',
+                                         'file:Detector/DetFCChhECalInclined/compact/FCChh_ECalBarrel_withCryostat.xml',
+                                         'file:Detector/DetFCChhHCalTile/compact/FCChh_HCalBarrel_TileCal.xml',
+                                         'file:Detector/DetFCChhHCalTile/compact/FCChh_HCalExtendedBarrel_TileCal.xml',
+                                         # regions HCalRegion and ECalCryostatRegion with their own range cuts
+                                         'file:Detector/DetFCChhBaseline1/compact/FCChh_Regions.xml'],
+                    # steps and tracks of each region printed in finalize
+                    regionStepReport = True,
+                    OutputLevel = INFO)
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", physicslist='SimG4FtfpBert')
+
+from Configurables import SimG4Alg
+geantsim = SimG4Alg("SimG4Alg")
+
+ApplicationMgr(EvtSel='NONE',
+               EvtMax=10,
+               TopAlg=[gen, hepmc_converter, geantsim],
+               ExtSvc = [geoservice, geantservice],
+               OutputLevel=INFO)
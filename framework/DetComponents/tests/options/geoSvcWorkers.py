@@ -0,0 +1,61 @@
+from Gaudi.Configuration import *
+from Configurables import ApplicationMgr
+
+from Configurables import MomentumRangeParticleGun
+from GaudiKernel import PhysicalConstants as constants
+guntool = MomentumRangeParticleGun("Gun")
+guntool.ThetaMin = 0
+guntool.ThetaMax = 2 * constants.pi
+guntool.PdgCodes = [11]
+from Configurables import GenAlg
+gen = GenAlg()
+gen.SignalProvider=guntool
+gen.hepmc.Path = "hepmc"
+
+from Configurables import HepMCToEDMConverter
+hepmc_converter = HepMCToEDMConverter("Converter")
+hepmc_converter.hepmc.Path="hepmc"
+hepmc_converter.genparticles.Path="allGenParticles"
+hepmc_converter.genvertices.Path="allGenVertices"
+
+# each worker generates different events: the seeds are incremented by the worker index
+from Configurables import HepRndm__Engine_CLHEP__RanluxEngine_ as RndmEngine
+rndmengine = RndmEngine("RndmGenSvc.Engine", SetSingleton = True, Seeds = [4242])
+
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=['file:Test/TestGeometry/data/TestBoxCaloSD_3readouts.xml'],
+                    # geometry built once, then 4 processes share it (copy-on-write), 40 events each
+                    numberOfWorkers = 4,
+                    # outputs of the workers are merged into the file set in the options
+                    workerOutputs = ["out.filename"],
+                    workerSeeds = ["RndmGenSvc.Engine.Seeds"],
+                    OutputLevel = INFO)
+
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", physicslist='SimG4TestPhysicsList')
+
+from Configurables import SimG4Alg, SimG4SaveCalHits
+savecaltool = SimG4SaveCalHits("saveECalHits", readoutNames = ["ECalHits"])
+savecaltool.positionedCaloHits.Path = "positionedCaloHits"
+savecaltool.caloHits.Path = "caloHits"
+geantsim = SimG4Alg("SimG4Alg", outputs= ["SimG4SaveCalHits/saveECalHits"])
+
+from Configurables import RedoSegmentation
+resegment = RedoSegmentation("ReSegmentation",
+                             oldReadoutName = "ECalHits",
+                             oldSegmentationIds = ["x","y","z"],
+                             newReadoutName = "ECalHitsPhiEta")
+resegment.inhits = "positionedCaloHits"
+resegment.outhits = "newCaloHits"
+
+from Configurables import FCCDataSvc, PodioOutput
+podiosvc = FCCDataSvc("EventDataSvc")
+out = PodioOutput("out", filename="test_geoSvcWorkers.root")
+out.outputCommands = ["keep *"]
+
+ApplicationMgr(EvtSel='NONE',
+               EvtMax=160,
+               TopAlg=[gen, hepmc_converter, geantsim, resegment, out],
+               # GeoSvc first: the workers are forked before the other services are initialized
+               ExtSvc = [geoservice, podiosvc, geantservice],
+               OutputLevel=INFO)
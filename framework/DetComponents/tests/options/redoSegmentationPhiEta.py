@@ -54,6 +54,16 @@ resegment = RedoSegmentation("ReSegmentation",
 # clusters are needed, with deposit position and cellID in bits
 resegment.inhits.Path = "positionedCaloHits"
 resegment.outhits.Path = "newCaloHits"
+# same segmentation, hits in the same new cell merged into one (sorted by cellID)
+mergesegment = RedoSegmentation("ReSegmentationMerged",
+                                oldReadoutName = "ECalHits",
+                                oldSegmentationIds = ["x","y","z"],
+                                newReadoutName = "ECalHitsPhiEta",
+                                mergeHits = True,
+                                mergedTime = "energyWeighted",
+                                OutputLevel = DEBUG)
+mergesegment.inhits.Path = "positionedCaloHits"
+mergesegment.outhits.Path = "mergedCaloHits"
 
 from Configurables import FCCDataSvc, PodioOutput
 podiosvc = FCCDataSvc("EventDataSvc")
@@ -62,6 +72,6 @@ out.outputCommands = ["keep *"]
 
 ApplicationMgr(EvtSel='NONE',
                EvtMax=30,
-               TopAlg=[gen, hepmc_converter, geantsim, resegment, out],
+               TopAlg=[gen, hepmc_converter, geantsim, resegment, mergesegment, out],
                ExtSvc = [podiosvc, geoservice, geantservice],
                )
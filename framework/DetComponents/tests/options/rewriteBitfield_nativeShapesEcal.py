@@ -0,0 +1,57 @@
+from Gaudi.Configuration import *
+
+# DD4hep geometry service
+# ECal barrel with the active layers built as native shapes: the active cells on the side of the passive plane above
+# the readout have subtype 1 (0 with the boolean solids of FCChh_ECalBarrel_withCryostat.xml)
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=[ 'file:Detector/DetFCChhBaseline1/compact/FCChh_DectEmptyMaster.xml',
+                                          'file:Detector/DetFCChhECalInclined/compact/FCChh_ECalBarrel_withCryostat_nativeShapes.xml'],
+                    OutputLevel = INFO)
+
+# Geant4 service
+# Configures the Geant simulation: geometry, physics list and user actions
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc")
+
+# Geant4 algorithm
+# Translates EDM to G4Event, passes the event to G4, writes out outputs via tools
+# and a tool that saves the calorimeter hits
+from Configurables import SimG4Alg, SimG4SaveCalHits
+savecaltool = SimG4SaveCalHits("saveECalHits", readoutNames = ["ECalBarrelEta"])
+savecaltool.positionedCaloHits.Path = "positionedCaloHits"
+savecaltool.caloHits.Path = "caloHits"
+from Configurables import SimG4SingleParticleGeneratorTool
+pgun=SimG4SingleParticleGeneratorTool("SimG4SingleParticleGeneratorTool",saveEdm=True,
+                particleName="e-",energyMin=50000,energyMax=50000,etaMin=0.36,etaMax=0.36)
+geantsim = SimG4Alg("SimG4Alg", outputs= ["SimG4SaveCalHits/saveECalHits"], eventProvider=pgun)
+
+# the subtype is removed: both sides of the readout are in the same cell, as with the boolean solids
+# (the subtypes of the passive cells are merged too)
+from Configurables import RewriteBitfield
+rewrite = RewriteBitfield("Rewrite",
+                          # old bitfield (readout)
+                          oldReadoutName = "ECalBarrelEta",
+                          # specify which fields are going to be deleted
+                          removeIds = ["subtype"],
+                          # new bitfield (readout), with the same segmentation
+                          newReadoutName = "ECalBarrelEtaNoSubtype",
+                          debugPrint = 10,
+                          OutputLevel = DEBUG)
+rewrite.inhits.Path = "caloHits"
+rewrite.outhits.Path = "caloRecoHits"
+
+# PODIO algorithm
+from Configurables import FCCDataSvc, PodioOutput
+podiosvc = FCCDataSvc("EventDataSvc")
+out = PodioOutput("out")
+out.outputCommands = ["keep *"]
+out.filename = "rewrittenBitfield_ecalBarrelNativeShapesSim.root"
+
+# ApplicationMgr
+from Configurables import ApplicationMgr
+ApplicationMgr( TopAlg = [geantsim, rewrite, out],
+                EvtSel = 'NONE',
+                EvtMax   = 1,
+                # order is important, as GeoSvc is needed by G4SimSvc
+                ExtSvc = [podiosvc, geoservice, geantservice],
+                OutputLevel=INFO)
@@ -0,0 +1,140 @@
+#include "CreateShowerLibrary.h"
+
+#include <array>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+DECLARE_COMPONENT(CreateShowerLibrary)
+
+CreateShowerLibrary::CreateShowerLibrary(const std::string& aName, ISvcLocator* aSvcLoc)
+    : Consumer(aName, aSvcLoc, {KeyValue("deposits", "rec/caloHits"), KeyValue("particle", "allGenParticles")}) {}
+CreateShowerLibrary::~CreateShowerLibrary() {}
+
+StatusCode CreateShowerLibrary::initialize() {
+  if (Consumer::initialize().isFailure()) {
+    return StatusCode::FAILURE;
+  }
+  if (m_entryRadius <= 0 && m_entryZ <= 0) {
+    error() << "The front of the calorimeter (entryRadius or entryZ) needs to be set." << endmsg;
+    return StatusCode::FAILURE;
+  }
+  try {
+    m_builder = std::make_unique<det::utils::ShowerLibraryBuilder>(m_energies, m_etaEdges);
+  } catch (const std::invalid_argument& e) {
+    error() << e.what() << endmsg;
+    return StatusCode::FAILURE;
+  }
+  return StatusCode::SUCCESS;
+}
+
+double CreateShowerLibrary::distanceToEntry(const double* aVertex, const double* aDirection) const {
+  double distance = -1;
+  auto closest = [&distance](double aDistance) {
+    if (aDistance > 0 && (distance < 0 || aDistance < distance)) {
+      distance = aDistance;
+    }
+  };
+  if (m_entryRadius > 0) {
+    // |v + t d|_xy = R
+    double a = aDirection[0] * aDirection[0] + aDirection[1] * aDirection[1];
+    double b = aVertex[0] * aDirection[0] + aVertex[1] * aDirection[1];
+    double c = aVertex[0] * aVertex[0] + aVertex[1] * aVertex[1] - m_entryRadius * m_entryRadius;
+    if (a > 0 && b * b - a * c >= 0) {
+      closest((-b + std::sqrt(b * b - a * c)) / a);
+    }
+  }
+  if (m_entryZ > 0 && aDirection[2] != 0) {
+    closest((std::copysign(m_entryZ.value(), aDirection[2]) - aVertex[2]) / aDirection[2]);
+  }
+  return distance;
+}
+
+void CreateShowerLibrary::operator()(const DataWrapper<edm4hep::CalorimeterHitCollection>& aDeposits,
+                                     const DataWrapper<edm4hep::MCParticleCollection>& aParticle) const {
+  const auto particles = aParticle.getData();
+  if (particles->size() != 1) {
+    warning() << "Single-particle events expected, " << particles->size() << " particles found: event skipped."
+              << endmsg;
+    return;
+  }
+  const auto& particle = (*particles)[0];
+  const auto& momentum = particle.getMomentum();
+  const auto& vertex = particle.getVertex();
+  double energy = particle.getEnergy();
+  const det::utils::ShowerFrame frame(momentum.x, momentum.y, momentum.z);
+  const double origin[3] = {vertex.x, vertex.y, vertex.z};
+  double distance = distanceToEntry(origin, frame.w);
+  if (distance < 0 || energy <= 0) {
+    warning() << "Particle does not reach the calorimeter: event skipped." << endmsg;
+    return;
+  }
+  double entry[3];
+  for (int i = 0; i < 3; i++) {
+    entry[i] = origin[i] + distance * frame.w[i];
+  }
+  double eta = std::asinh(entry[2] / std::sqrt(entry[0] * entry[0] + entry[1] * entry[1]));
+  size_t energyBin = m_builder->energyBin(energy);
+  size_t etaBin = m_builder->etaBin(eta);
+  if (etaBin == m_builder->numberOfEtaBins()) {
+    debug() << "Entry point at eta " << eta << " outside of the library: event skipped." << endmsg;
+    return;
+  }
+
+  // deposits in the frame of the shower, merged in cubes: sum of the energy and energy-weighted position
+  std::map<std::tuple<int, int, int>, std::array<double, 4>> cubes;
+  auto cubeIndex = [this](double aValue) { return static_cast<int>(std::floor(aValue / m_spotSize)); };
+  for (const auto& hit : *aDeposits.getData()) {
+    const auto& position = hit.getPosition();
+    const double relative[3] = {position.x - entry[0], position.y - entry[1], position.z - entry[2]};
+    double local[3] = {0, 0, 0};
+    for (int i = 0; i < 3; i++) {
+      local[0] += relative[i] * frame.w[i];
+      local[1] += relative[i] * frame.u[i];
+      local[2] += relative[i] * frame.v[i];
+    }
+    // without merging each deposit is kept
+    auto key = m_spotSize > 0 ? std::make_tuple(cubeIndex(local[0]), cubeIndex(local[1]), cubeIndex(local[2]))
+                              : std::make_tuple(static_cast<int>(cubes.size()), 0, 0);
+    auto& cube = cubes[key];
+    for (int i = 0; i < 3; i++) {
+      cube[i] += hit.getEnergy() * local[i];
+    }
+    cube[3] += hit.getEnergy();
+  }
+  std::vector<det::utils::ShowerSpot> spots;
+  spots.reserve(cubes.size());
+  for (const auto& cube : cubes) {
+    const auto& sum = cube.second;
+    if (sum[3] <= 0) {
+      continue;
+    }
+    spots.push_back({static_cast<float>(sum[0] / sum[3]), static_cast<float>(sum[1] / sum[3]),
+                     static_cast<float>(sum[2] / sum[3]), static_cast<float>(sum[3] / energy)});
+  }
+  debug() << "Shower of " << energy << " GeV at eta " << eta << ": " << aDeposits.getData()->size()
+          << " deposits merged into " << spots.size() << " spots" << endmsg;
+
+  std::lock_guard<std::mutex> lock(m_builderMutex);
+  if (m_builder->numberOfShowers(energyBin, etaBin) < m_maxShowersPerBin) {
+    m_builder->addShower(energyBin, etaBin, std::move(spots));
+  }
+}
+
+StatusCode CreateShowerLibrary::finalize() {
+  if (m_builder != nullptr) {
+    for (size_t iEnergy = 0; iEnergy < m_energies.size(); iEnergy++) {
+      for (size_t iEta = 0; iEta < m_builder->numberOfEtaBins(); iEta++) {
+        info() << "Showers of " << m_energies.value()[iEnergy] << " GeV in eta [" << m_etaEdges.value()[iEta]
+               << ", " << m_etaEdges.value()[iEta + 1] << "): " << m_builder->numberOfShowers(iEnergy, iEta) << endmsg;
+      }
+    }
+    if (!m_builder->write(m_outputFile)) {
+      error() << "Failed to write the shower library " << m_outputFile << endmsg;
+      return StatusCode::FAILURE;
+    }
+    info() << "Shower library written to " << m_outputFile << endmsg;
+  }
+  return Consumer::finalize();
+}
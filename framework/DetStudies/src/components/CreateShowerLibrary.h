@@ -0,0 +1,82 @@
+#ifndef DETSTUDIES_CREATESHOWERLIBRARY_H
+#define DETSTUDIES_CREATESHOWERLIBRARY_H
+
+// GAUDI
+#include "GaudiAlg/Consumer.h"
+
+// FCCSW
+#include "DetCommon/ShowerLibrary.h"
+#include "k4FWCore/BaseClass.h"
+#include "k4FWCore/DataWrapper.h"
+
+// datamodel
+#include "edm4hep/CalorimeterHitCollection.h"
+#include "edm4hep/MCParticleCollection.h"
+
+#include <memory>
+#include <mutex>
+
+/** @class CreateShowerLibrary CreateShowerLibrary.h
+ *
+ *  Shower library (det::utils::ShowerLibrary) built from the full simulation of single particles (electrons or
+ *  photons from the interaction point), for the fast simulation replaying the showers (det::ShowerLibraryModel).
+ *  The entry point of the particle is the intersection of its line of flight with the front of the calorimeter
+ *  envelope: the cylinder of radius '\b entryRadius' (barrel) or the planes at +/- '\b entryZ' (endcap), the closest
+ *  one if both are given. They need to match the surface of the region in which the library is replayed.
+ *  The deposits of the event (positions of the steps, not of the cells) are expressed in the frame of the shower,
+ *  merged in cubes of '\b spotSize' (energy-weighted position), and added to the bin of the closest energy of
+ *  '\b energies' and of the pseudorapidity of the entry point in '\b etaEdges', up to '\b maxShowersPerBin'.
+ *  The library is written to '\b outputFile' in finalize.
+ *  The deposits are replayed as they are: the hits need to be those recorded by the sensitive detectors (e.g. the
+ *  energy in the active material only, without the sampling fraction correction).
+ */
+
+class CreateShowerLibrary final
+    : public Gaudi::Functional::Consumer<void(const DataWrapper<edm4hep::CalorimeterHitCollection>&,
+                                              const DataWrapper<edm4hep::MCParticleCollection>&),
+                                         BaseClass_t> {
+public:
+  explicit CreateShowerLibrary(const std::string&, ISvcLocator*);
+  virtual ~CreateShowerLibrary();
+  /**  Initialize.
+   *   @return status code
+   */
+  virtual StatusCode initialize() override;
+  /**  Adds the shower of the event to the library.
+   *   @param[in] aDeposits Energy deposits (positions of the steps).
+   *   @param[in] aParticle Generated single-particle event.
+   */
+  virtual void operator()(const DataWrapper<edm4hep::CalorimeterHitCollection>& aDeposits,
+                          const DataWrapper<edm4hep::MCParticleCollection>& aParticle) const override;
+  /**  Writes the library.
+   *   @return status code
+   */
+  virtual StatusCode finalize() override;
+
+private:
+  /** Distance from the vertex to the front of the calorimeter along the direction of the particle.
+   *  @param[in] aVertex Vertex of the particle (mm).
+   *  @param[in] aDirection Direction of the particle (unit vector).
+   *  return Distance (mm), negative if the particle does not reach the calorimeter.
+   */
+  double distanceToEntry(const double* aVertex, const double* aDirection) const;
+  /// Energies of the bins of the library (GeV)
+  Gaudi::Property<std::vector<double>> m_energies{this, "energies", {}, "Energies of the bins of the library [GeV]"};
+  /// Edges of the eta bins of the library
+  Gaudi::Property<std::vector<double>> m_etaEdges{this, "etaEdges", {}, "Edges of the eta bins of the library"};
+  /// Radius of the front of the barrel envelope
+  Gaudi::Property<double> m_entryRadius{this, "entryRadius", 0, "Inner radius of the barrel envelope [mm], 0: none"};
+  /// Position of the front of the endcap envelope
+  Gaudi::Property<double> m_entryZ{this, "entryZ", 0, "|z| of the front of the endcap envelope [mm], 0: none"};
+  /// Size of the cubes in which the deposits are merged
+  Gaudi::Property<double> m_spotSize{this, "spotSize", 1., "Size of the cubes merging the deposits [mm], 0: none"};
+  /// Maximum number of the showers in each bin
+  Gaudi::Property<uint> m_maxShowersPerBin{this, "maxShowersPerBin", 1000, "Maximum number of showers per bin"};
+  /// Output file
+  Gaudi::Property<std::string> m_outputFile{this, "outputFile", "showerLibrary.bin", "Shower library file"};
+  /// Library being built
+  std::unique_ptr<det::utils::ShowerLibraryBuilder> m_builder;
+  /// Lock of the library
+  mutable std::mutex m_builderMutex;
+};
+#endif /* DETSTUDIES_CREATESHOWERLIBRARY_H */
@@ -1,6 +1,7 @@
 #include "SamplingFractionInLayers.h"
 
 // FCCSW
+#include "DetCommon/ReadoutEncodings.h"
 #include "k4Interface/IGeoSvc.h"
 
 // datamodel
@@ -9,8 +10,11 @@
 #include "CLHEP/Vector/ThreeVector.h"
 #include "GaudiKernel/ITHistSvc.h"
 #include "TH1F.h"
+#include "TTree.h"
 #include "TVector2.h"
 
+#include <algorithm>
+
 // DD4hep
 #include "DD4hep/Detector.h"
 #include "DD4hep/Readout.h"
@@ -23,7 +27,8 @@ SamplingFractionInLayers::SamplingFractionInLayers(const std::string& aName, ISv
       m_geoSvc("GeoSvc", "SamplingFractionInLayers"),
       m_totalEnergy(nullptr),
       m_totalActiveEnergy(nullptr),
-      m_sf(nullptr) {
+      m_sf(nullptr),
+      m_summary(nullptr) {
   declareProperty("deposits", m_deposits, "Energy deposits in sampling calorimeter (input)");
 }
 SamplingFractionInLayers::~SamplingFractionInLayers() {}
@@ -37,6 +42,42 @@ StatusCode SamplingFractionInLayers::initialize() {
     error() << "Readout <<" << m_readoutName << ">> does not exist." << endmsg;
     return StatusCode::FAILURE;
   }
+  auto decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
+  m_layerField = &(*decoder)[m_layerFieldName];
+  m_activeField = &(*decoder)[m_activeFieldName];
+  if (m_layerFieldName == "layer" && m_activeFieldName == "type") {
+    if (det::readouts::FCChhECalBarrelEta::matches(*decoder)) {
+      m_staticEncoding = StaticEncoding::FCChhECalBarrelEta;
+    } else if (det::readouts::FCChhECalBarrelEtaCalibration::matches(*decoder)) {
+      m_staticEncoding = StaticEncoding::FCChhECalBarrelEtaCalibration;
+    }
+  }
+  debug() << "Fields of readout " << m_readoutName << " read with "
+          << (m_staticEncoding == StaticEncoding::None ? "BitFieldElement" : "compile-time accessors") << endmsg;
+  m_sumELayers.assign(m_numLayers, 0);
+  m_sumEActiveLayers.assign(m_numLayers, 0);
+  if (m_streaming) {
+    for (auto probability : m_sfQuantiles) {
+      if (probability < 0 || probability > 1) {
+        error() << "Probability of the quantile " << probability << " is not in [0, 1]." << endmsg;
+        return StatusCode::FAILURE;
+      }
+    }
+    m_totalEnStats.assign(m_numLayers + 1, det::RunningStatistics());
+    m_activeEnStats.assign(m_numLayers + 1, det::RunningStatistics());
+    m_sfStats.assign(m_numLayers + 1, det::RunningStatistics());
+    for (uint i = 0; i <= m_numLayers; i++) {
+      for (auto probability : m_sfQuantiles) {
+        m_sfQuantileStats.emplace_back(probability);
+      }
+    }
+    m_summary = new TTree("samplingFractionSummary", "Energy and sampling fraction per layer");
+    if (m_histSvc->regTree("/rec/samplingFractionSummary", m_summary).isFailure()) {
+      error() << "Couldn't register tree" << endmsg;
+      return StatusCode::FAILURE;
+    }
+    return StatusCode::SUCCESS;
+  }
   // create histograms
   for (uint i = 0; i < m_numLayers; i++) {
     m_totalEnLayers.push_back(new TH1F(("ecal_totalEnergy_layer" + std::to_string(i)).c_str(),
@@ -79,29 +120,39 @@ StatusCode SamplingFractionInLayers::initialize() {
 }
 
 StatusCode SamplingFractionInLayers::execute() {
-  auto decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
   double sumE = 0.;
-  std::vector<double> sumElayers;
   double sumEactive = 0.;
-  std::vector<double> sumEactiveLayers;
-  sumElayers.assign(m_numLayers, 0);
-  sumEactiveLayers.assign(m_numLayers, 0);
+  std::fill(m_sumELayers.begin(), m_sumELayers.end(), 0);
+  std::fill(m_sumEActiveLayers.begin(), m_sumEActiveLayers.end(), 0);
 
   const auto deposits = m_deposits.get();
-  for (const auto& hit : *deposits) {
-    dd4hep::DDSegmentation::CellID cID = hit.getCellID();
-    auto id = decoder->get(cID, m_layerFieldName);
-    sumElayers[id] += hit.getEnergy();
-    // check if energy was deposited in the calorimeter (active/passive material)
-    if (id >= m_firstLayerId) {
-      sumE += hit.getEnergy();
-      // active material of calorimeter
-      auto activeField = decoder->get(cID, m_activeFieldName);
-      if (activeField == m_activeFieldValue) {
-        sumEactive += hit.getEnergy();
-        sumEactiveLayers[id] += hit.getEnergy();
-      }
+  switch (m_staticEncoding) {
+  case StaticEncoding::FCChhECalBarrelEta:
+    sumDeposits(*deposits, det::readouts::FCChhECalBarrelEta::layer(), det::readouts::FCChhECalBarrelEta::type(), sumE,
+                sumEactive);
+    break;
+  case StaticEncoding::FCChhECalBarrelEtaCalibration:
+    sumDeposits(*deposits, det::readouts::FCChhECalBarrelEtaCalibration::layer(),
+                det::readouts::FCChhECalBarrelEtaCalibration::type(), sumE, sumEactive);
+    break;
+  default:
+    sumDeposits(*deposits, *m_layerField, *m_activeField, sumE, sumEactive);
+  }
+  for (uint i = 0; i < m_numLayers; i++) {
+    if (i < m_firstLayerId) {
+      debug() << "total energy deposited outside the calorimeter detector = " << m_sumELayers[i] << endmsg;
+    } else {
+      debug() << "total energy in layer " << i << " = " << m_sumELayers[i] << " active = " << m_sumEActiveLayers[i]
+              << endmsg;
+    }
+  }
+  if (m_streaming) {
+    // the last entry for the whole calorimeter
+    addToStatistics(m_numLayers, sumE, sumEactive);
+    for (uint i = 0; i < m_numLayers; i++) {
+      addToStatistics(i, m_sumELayers[i], m_sumEActiveLayers[i]);
     }
+    return StatusCode::SUCCESS;
   }
   // Fill histograms
   m_totalEnergy->Fill(sumE);
@@ -110,19 +161,87 @@ StatusCode SamplingFractionInLayers::execute() {
     m_sf->Fill(sumEactive / sumE);
   }
   for (uint i = 0; i < m_numLayers; i++) {
-    m_totalEnLayers[i]->Fill(sumElayers[i]);
-    m_activeEnLayers[i]->Fill(sumEactiveLayers[i]);
-    if (i < m_firstLayerId) {
-      debug() << "total energy deposited outside the calorimeter detector = " << sumElayers[i] << endmsg;
-    } else {
-      debug() << "total energy in layer " << i << " = " << sumElayers[i] << " active = " << sumEactiveLayers[i]
-              << endmsg;
-    }
-    if (sumElayers[i] > 0) {
-      m_sfLayers[i]->Fill(sumEactiveLayers[i] / sumElayers[i]);
+    m_totalEnLayers[i]->Fill(m_sumELayers[i]);
+    m_activeEnLayers[i]->Fill(m_sumEActiveLayers[i]);
+    if (m_sumELayers[i] > 0) {
+      m_sfLayers[i]->Fill(m_sumEActiveLayers[i] / m_sumELayers[i]);
     }
   }
   return StatusCode::SUCCESS;
 }
 
-StatusCode SamplingFractionInLayers::finalize() { return GaudiAlgorithm::finalize(); }
+template <typename LayerField, typename ActiveField>
+void SamplingFractionInLayers::sumDeposits(const edm4hep::CalorimeterHitCollection& aDeposits,
+                                           const LayerField& aLayerField, const ActiveField& aActiveField,
+                                           double& aSumE, double& aSumEactive) {
+  for (const auto& hit : aDeposits) {
+    dd4hep::DDSegmentation::CellID cID = hit.getCellID();
+    auto id = aLayerField.value(cID);
+    m_sumELayers[id] += hit.getEnergy();
+    // check if energy was deposited in the calorimeter (active/passive material)
+    if (id >= m_firstLayerId) {
+      aSumE += hit.getEnergy();
+      // active material of calorimeter
+      auto activeField = aActiveField.value(cID);
+      if (activeField == m_activeFieldValue) {
+        aSumEactive += hit.getEnergy();
+        m_sumEActiveLayers[id] += hit.getEnergy();
+      }
+    }
+  }
+}
+
+void SamplingFractionInLayers::addToStatistics(uint aIndex, double aEnergy, double aActiveEnergy) {
+  m_totalEnStats[aIndex].add(aEnergy);
+  m_activeEnStats[aIndex].add(aActiveEnergy);
+  if (aEnergy > 0) {
+    double sf = aActiveEnergy / aEnergy;
+    m_sfStats[aIndex].add(sf);
+    for (size_t iQuantile = 0; iQuantile < m_sfQuantiles.size(); iQuantile++) {
+      m_sfQuantileStats[aIndex * m_sfQuantiles.size() + iQuantile].add(sf);
+    }
+  }
+}
+
+StatusCode SamplingFractionInLayers::finalize() {
+  if (m_streaming) {
+    int layer;
+    ULong64_t numEvents, numSfEvents;
+    double totalMean, totalStdDev, activeMean, activeStdDev, sfMean, sfStdDev;
+    std::vector<double> sfQuantiles(m_sfQuantiles.size());
+    std::vector<double> sfQuantileProbabilities(m_sfQuantiles.begin(), m_sfQuantiles.end());
+    m_summary->Branch("layer", &layer);
+    m_summary->Branch("numEvents", &numEvents);
+    m_summary->Branch("totalEnergyMean", &totalMean);
+    m_summary->Branch("totalEnergyStdDev", &totalStdDev);
+    m_summary->Branch("activeEnergyMean", &activeMean);
+    m_summary->Branch("activeEnergyStdDev", &activeStdDev);
+    m_summary->Branch("numSfEvents", &numSfEvents);
+    m_summary->Branch("sfMean", &sfMean);
+    m_summary->Branch("sfStdDev", &sfStdDev);
+    m_summary->Branch("sfQuantileProbabilities", &sfQuantileProbabilities);
+    m_summary->Branch("sfQuantiles", &sfQuantiles);
+    for (uint i = 0; i <= m_numLayers; i++) {
+      layer = (i == m_numLayers) ? -1 : i;
+      numEvents = m_totalEnStats[i].count();
+      totalMean = m_totalEnStats[i].mean();
+      totalStdDev = m_totalEnStats[i].stdDev();
+      activeMean = m_activeEnStats[i].mean();
+      activeStdDev = m_activeEnStats[i].stdDev();
+      numSfEvents = m_sfStats[i].count();
+      sfMean = m_sfStats[i].mean();
+      sfStdDev = m_sfStats[i].stdDev();
+      for (size_t iQuantile = 0; iQuantile < m_sfQuantiles.size(); iQuantile++) {
+        sfQuantiles[iQuantile] = m_sfQuantileStats[i * m_sfQuantiles.size() + iQuantile].value();
+      }
+      m_summary->Fill();
+      if (layer >= 0) {
+        info() << "layer " << layer << ": SF = " << sfMean << " +- " << sfStdDev << " (" << numSfEvents << " events)"
+               << endmsg;
+      } else {
+        info() << "calorimeter: SF = " << sfMean << " +- " << sfStdDev << " (" << numSfEvents << " events)" << endmsg;
+      }
+    }
+  }
+  return GaudiAlgorithm::finalize();
+}
@@ -7,14 +7,19 @@
 
 // FCCSW
 #include "k4FWCore/DataHandle.h"
+#include "StreamingStatistics.h"
 class IGeoSvc;
 
+// DD4hep
+#include "DDSegmentation/BitFieldCoder.h"
+
 // datamodel
 namespace edm4hep {
 class CalorimeterHitCollection;
 }
 
 class TH1F;
+class TTree;
 class ITHistSvc;
 /** @class SamplingFractionInLayers SamplingFractionInLayers.h
  *
@@ -23,6 +28,15 @@ class ITHistSvc;
  *  Sampling fraction is calculated for each layer as the ratio of energy deposited in active material to energy
  *  deposited in the layer (also in passive material).
  *
+ *  If '\b streaming' is set, no histograms are created: the mean and standard deviation of the total and active
+ *  energy and of the sampling fraction are accumulated per layer (Welford's algorithm), together with P-square
+ *  estimates of the quantiles '\b samplingFractionQuantiles' of the sampling fraction. They are written at the end
+ *  of the job to one tree (/rec/samplingFractionSummary), with one entry per layer and the last entry (layer = -1)
+ *  for the whole calorimeter.
+ *
+ *  If the readout has one of the generated encodings of the FCC-hh ECal barrel (DetCommon/ReadoutEncodings.h) and the
+ *  fields are 'layer' and 'type', they are read with compile-time shifts and masks instead of BitFieldElement.
+ *
  *  @author Anna Zaborowska
  */
 
@@ -44,6 +58,22 @@ public:
   virtual StatusCode finalize() final;
 
 private:
+  /**  Add the energies of the event to the streaming statistics.
+   *   @param[in] aIndex Index of the layer (numLayers for the whole calorimeter).
+   *   @param[in] aEnergy Total deposited energy.
+   *   @param[in] aActiveEnergy Energy deposited in the active material.
+   */
+  void addToStatistics(uint aIndex, double aEnergy, double aActiveEnergy);
+  /**  Sum the energy deposits of the event in the layers and in the calorimeter.
+   *   @param[in] aDeposits Energy deposits.
+   *   @param[in] aLayerField Layer field (BitFieldElement or det::utils::StaticBitField).
+   *   @param[in] aActiveField Active field (BitFieldElement or det::utils::StaticBitField).
+   *   @param[out] aSumE Total energy deposited in the calorimeter.
+   *   @param[out] aSumEactive Energy deposited in the active material of the calorimeter.
+   */
+  template <typename LayerField, typename ActiveField>
+  void sumDeposits(const edm4hep::CalorimeterHitCollection& aDeposits, const LayerField& aLayerField,
+                   const ActiveField& aActiveField, double& aSumE, double& aSumEactive);
   /// Pointer to the interface of histogram service
   ServiceHandle<ITHistSvc> m_histSvc;
   /// Pointer to the geometry service
@@ -62,6 +92,31 @@ private:
   Gaudi::Property<uint> m_firstLayerId{this, "firstLayerId", 0, "ID of first layer"};
   /// Name of the detector readout
   Gaudi::Property<std::string> m_readoutName{this, "readoutName", "", "Name of the detector readout"};
+  /// Flag to accumulate streaming statistics instead of filling histograms
+  Gaudi::Property<bool> m_streaming{this, "streaming", false,
+                                    "Accumulate mean/RMS per layer instead of histograms, written to a summary tree"};
+  /// Probabilities of the quantiles of the sampling fraction (streaming mode)
+  Gaudi::Property<std::vector<double>> m_sfQuantiles{
+      this, "samplingFractionQuantiles", {}, "Probabilities of the quantiles of SF estimated in the streaming mode"};
+  /// Layer and active fields of the readout (masks prepared in initialize)
+  const dd4hep::DDSegmentation::BitFieldElement* m_layerField = nullptr;
+  const dd4hep::DDSegmentation::BitFieldElement* m_activeField = nullptr;
+  /// Generated encoding of the readout, if any (fields read with compile-time accessors)
+  enum class StaticEncoding { None, FCChhECalBarrelEta, FCChhECalBarrelEtaCalibration };
+  StaticEncoding m_staticEncoding = StaticEncoding::None;
+  /// Energy deposited within layer in the event, total and in the active material
+  std::vector<double> m_sumELayers;
+  std::vector<double> m_sumEActiveLayers;
+  /// Statistics of total and active energy and of sampling fraction per layer, the last one for the calorimeter
+  /// (streaming mode)
+  std::vector<det::RunningStatistics> m_totalEnStats;
+  std::vector<det::RunningStatistics> m_activeEnStats;
+  std::vector<det::RunningStatistics> m_sfStats;
+  /// Quantiles of sampling fraction, samplingFractionQuantiles.size() per layer, the last ones for the calorimeter
+  /// (streaming mode)
+  std::vector<det::P2Quantile> m_sfQuantileStats;
+  /// Summary tree (streaming mode), owned by the histogram service
+  TTree* m_summary;
   // Maximum energy for the axis range
   Gaudi::Property<double> m_energy{this, "energyAxis", 500, "Maximum energy for axis range"};
   // Histograms of total deposited energy within layer
@@ -0,0 +1,80 @@
+#include "StreamingStatistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace det {
+double RunningStatistics::stdDev() const { return std::sqrt(variance()); }
+
+P2Quantile::P2Quantile(double aProbability)
+    : m_probability(aProbability),
+      m_heights{},
+      m_positions{1, 2, 3, 4, 5},
+      m_desiredPositions{1, 1 + 2 * aProbability, 1 + 4 * aProbability, 3 + 2 * aProbability, 5},
+      m_increments{0, aProbability / 2, aProbability, (1 + aProbability) / 2, 1} {}
+
+void P2Quantile::add(double aValue) {
+  if (m_count < 5) {
+    m_heights[m_count++] = aValue;
+    if (m_count == 5) {
+      std::sort(m_heights.begin(), m_heights.end());
+    }
+    return;
+  }
+  ++m_count;
+  // cell of the new value, extremes updated
+  size_t cell;
+  if (aValue < m_heights[0]) {
+    m_heights[0] = aValue;
+    cell = 0;
+  } else if (aValue >= m_heights[4]) {
+    m_heights[4] = aValue;
+    cell = 3;
+  } else {
+    cell = 0;
+    while (aValue >= m_heights[cell + 1]) {
+      ++cell;
+    }
+  }
+  for (size_t iMarker = cell + 1; iMarker < 5; ++iMarker) {
+    m_positions[iMarker] += 1;
+  }
+  for (size_t iMarker = 0; iMarker < 5; ++iMarker) {
+    m_desiredPositions[iMarker] += m_increments[iMarker];
+  }
+  // adjust the middle markers that are off their desired positions
+  for (size_t iMarker = 1; iMarker < 4; ++iMarker) {
+    double offset = m_desiredPositions[iMarker] - m_positions[iMarker];
+    if ((offset >= 1 && m_positions[iMarker + 1] - m_positions[iMarker] > 1) ||
+        (offset <= -1 && m_positions[iMarker - 1] - m_positions[iMarker] < -1)) {
+      int step = offset > 0 ? 1 : -1;
+      const double q = m_heights[iMarker];
+      const double qNext = m_heights[iMarker + 1], qPrevious = m_heights[iMarker - 1];
+      const double n = m_positions[iMarker];
+      const double nNext = m_positions[iMarker + 1], nPrevious = m_positions[iMarker - 1];
+      // piecewise-parabolic prediction, linear if it is not between the neighbours
+      double height = q + step / (nNext - nPrevious) *
+                              ((n - nPrevious + step) * (qNext - q) / (nNext - n) +
+                               (nNext - n - step) * (q - qPrevious) / (n - nPrevious));
+      if (height <= qPrevious || height >= qNext) {
+        height = q + step * (m_heights[iMarker + step] - q) / (m_positions[iMarker + step] - n);
+      }
+      m_heights[iMarker] = height;
+      m_positions[iMarker] += step;
+    }
+  }
+}
+
+double P2Quantile::value() const {
+  if (m_count == 0) {
+    return 0;
+  }
+  if (m_count < 5) {
+    std::array<double, 5> values = m_heights;
+    std::sort(values.begin(), values.begin() + m_count);
+    size_t index = std::min(m_count - 1, static_cast<size_t>(std::lround(m_probability * (m_count - 1))));
+    return values[index];
+  }
+  return m_heights[2];
+}
+}
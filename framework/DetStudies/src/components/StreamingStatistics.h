@@ -0,0 +1,74 @@
+#ifndef DETSTUDIES_STREAMINGSTATISTICS_H
+#define DETSTUDIES_STREAMINGSTATISTICS_H
+
+#include <array>
+#include <cstddef>
+
+/** StreamingStatistics.h
+ *
+ *  Statistics of a stream of values accumulated without storing the values or binning them:
+ *  RunningStatistics - mean and standard deviation (Welford's algorithm),
+ *  P2Quantile - estimate of one quantile (P-square algorithm of Jain and Chlamtac, five markers).
+ */
+
+namespace det {
+/// Mean and standard deviation of a stream of values, numerically stable (Welford's algorithm)
+class RunningStatistics {
+public:
+  /// Add a value
+  inline void add(double aValue) {
+    ++m_count;
+    double delta = aValue - m_mean;
+    m_mean += delta / m_count;
+    m_sumSquares += delta * (aValue - m_mean);
+  }
+  /// Number of the values
+  inline size_t count() const { return m_count; }
+  /// Mean of the values, 0 if there are none
+  inline double mean() const { return m_mean; }
+  /// Variance of the values (as TH1::GetStdDev, without the Bessel correction), 0 if there are none
+  inline double variance() const { return m_count > 0 ? m_sumSquares / m_count : 0; }
+  /// Standard deviation of the values
+  double stdDev() const;
+
+private:
+  /// number of the values
+  size_t m_count = 0;
+  /// mean of the values
+  double m_mean = 0;
+  /// sum of the squared differences from the mean
+  double m_sumSquares = 0;
+};
+
+/// Estimate of a quantile of a stream of values in constant memory (P-square algorithm)
+class P2Quantile {
+public:
+  /** Constructor.
+   *  @param[in] aProbability Probability of the quantile, in [0, 1] (0.5 for the median).
+   */
+  explicit P2Quantile(double aProbability);
+  /// Add a value
+  void add(double aValue);
+  /// Estimate of the quantile (exact for up to five values), 0 if there are no values
+  double value() const;
+  /// Probability of the quantile
+  inline double probability() const { return m_probability; }
+  /// Number of the values
+  inline size_t count() const { return m_count; }
+
+private:
+  /// probability of the quantile
+  double m_probability;
+  /// number of the values
+  size_t m_count = 0;
+  /// heights of the markers (the first values until there are five)
+  std::array<double, 5> m_heights;
+  /// positions of the markers
+  std::array<double, 5> m_positions;
+  /// desired positions of the markers
+  std::array<double, 5> m_desiredPositions;
+  /// increments of the desired positions for each value
+  std::array<double, 5> m_increments;
+};
+}
+#endif /* DETSTUDIES_STREAMINGSTATISTICS_H */
@@ -1,5 +1,6 @@
 #include "UpstreamMaterial.h"
 
+#include "DetCommon/ReadoutEncodings.h"
 #include "k4Interface/IGeoSvc.h"
 
 // datamodel
@@ -12,6 +13,8 @@
 #include "TH2F.h"
 #include "TVector2.h"
 
+#include <type_traits>
+
 // DD4hep
 #include "DD4hep/Detector.h"
 #include "DD4hep/Readout.h"
@@ -37,6 +40,14 @@ StatusCode UpstreamMaterial::initialize() {
     error() << "Readout <<" << m_readoutName << ">> does not exist." << endmsg;
     return StatusCode::FAILURE;
   }
+  auto decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
+  m_cryoField = &(*decoder)["cryo"];
+  // the cryostat field is the same in the generated encodings of the ECal barrel
+  static_assert(std::is_same<det::readouts::FCChhECalBarrelEta::cryo,
+                             det::readouts::FCChhECalBarrelEtaCalibration::cryo>::value,
+                "Different cryostat fields of the generated encodings");
+  m_staticEncoding = det::readouts::FCChhECalBarrelEta::matches(*decoder) ||
+                     det::readouts::FCChhECalBarrelEtaCalibration::matches(*decoder);
   m_histSvc = service("THistSvc");
   if (!m_histSvc) {
     error() << "Unable to locate Histogram Service" << endmsg;
@@ -65,7 +76,6 @@ StatusCode UpstreamMaterial::initialize() {
 }
 
 StatusCode UpstreamMaterial::execute() {
-  auto decoder = m_geoSvc->lcdd()->readout(m_readoutName).idSpec().decoder();
   double sumEupstream = 0.;
   std::vector<double> sumEcells;
   sumEcells.assign(m_numLayers, 0);
@@ -82,8 +92,7 @@ StatusCode UpstreamMaterial::execute() {
   const auto deposits = m_deposits.get();
   for (const auto& hit : *deposits) {
     dd4hep::DDSegmentation::CellID cID = hit.getCellID();
-    const auto& field = "cryo";
-    int id = decoder->get(cID, field);
+    int id = m_staticEncoding ? det::readouts::FCChhECalBarrelEta::cryo::value(cID) : m_cryoField->value(cID);
     if (id == 0) {
       sumEcells[id - m_firstLayerId] += hit.getEnergy();
     } else {
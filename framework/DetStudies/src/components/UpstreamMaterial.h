@@ -8,6 +8,9 @@
 #include "k4FWCore/DataHandle.h"
 class IGeoSvc;
 
+// DD4hep
+#include "DDSegmentation/BitFieldCoder.h"
+
 // datamodel
 namespace edm4hep {
 class CalorimeterHitCollection;
@@ -26,6 +29,8 @@ class ITHistSvc;
  * plotted.
  *  Dependence of the energy deposited in the dead material on the azimuthal angle of the incoming particle (MC truth)
  * is plotted.
+ *  If the readout has one of the generated encodings of the FCC-hh ECal barrel (DetCommon/ReadoutEncodings.h), the
+ *  cryostat field is read with compile-time shifts and masks.
  *
  *  @author Anna Zaborowska
  */
@@ -75,5 +80,9 @@ private:
       this, "samplingFraction", {}, "Values of sampling fraction per layer"};
   /// Name of the detector readout
   Gaudi::Property<std::string> m_readoutName{this, "readoutName", "", "Name of the readout"};
+  /// Cryostat field of the readout (resolved in initialize)
+  const dd4hep::DDSegmentation::BitFieldElement* m_cryoField = nullptr;
+  /// Flag set if the readout has a generated encoding (cryostat field read with the compile-time accessor)
+  bool m_staticEncoding = false;
 };
 #endif /* DETSTUDIES_UPSTREAMMATERIAL_H */
@@ -0,0 +1,65 @@
+from Gaudi.Configuration import *
+
+# Data service
+from Configurables import FCCDataSvc
+podioevent = FCCDataSvc("EventDataSvc")
+
+# library of the ECal barrel, or of the ECal endcap (EMEC, positive eta) if set to True
+endcap = False
+
+# DD4hep geometry service
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=[ 'file:Detector/DetFCChhBaseline1/compact/FCChh_DectEmptyMaster.xml',
+                                          'file:Detector/DetFCChhECalInclined/compact/FCChh_ECalBarrel_withCryostat.xml',
+                                          'file:Detector/DetFCChhCalDiscs/compact/Endcaps_coneCryo.xml'
+],
+                    OutputLevel = WARNING)
+
+# Geant4 service
+# Full simulation of the showers stored in the library
+from Configurables import SimG4Svc
+geantservice = SimG4Svc("SimG4Svc", detector='SimG4DD4hepDetector', physicslist="SimG4FtfpBert", actions="SimG4FullSimActions")
+
+# Geant4 algorithm
+# Translates EDM to G4Event, passes the event to G4, writes out outputs via tools
+# and a tool that saves the calorimeter hits (positions of the steps)
+from Configurables import SimG4Alg, SimG4SaveCalHits, SimG4SingleParticleGeneratorTool
+saveecaltool = SimG4SaveCalHits("saveECalHits",readoutNames = ["EMECPhiEta" if endcap else "ECalBarrelEta"])
+saveecaltool.positionedCaloHits.Path = "ECalPositionedHits"
+saveecaltool.caloHits.Path = "ECalHits"
+# one energy per job, the libraries of different energies are created by separate jobs (or with 'energies' binning)
+etaMin, etaMax = (1.6, 2.4) if endcap else (-0.5, 0.5)
+pgun=SimG4SingleParticleGeneratorTool("SimG4SingleParticleGeneratorTool",saveEdm=True,
+                                      particleName = "e-", energyMin = 50000, energyMax = 50000, etaMin = etaMin, etaMax = etaMax,
+                                      OutputLevel = INFO)
+geantsim = SimG4Alg("SimG4Alg",
+                    outputs= ["SimG4SaveCalHits/saveECalHits"],
+                    eventProvider = pgun,
+                    OutputLevel = INFO)
+
+from Configurables import CreateShowerLibrary
+library = CreateShowerLibrary("CreateShowerLibrary",
+                              energies = [50],
+                              etaEdges = [etaMin + 0.1 * i for i in range(int(round((etaMax - etaMin) / 0.1)) + 1)],
+                              spotSize = 2,
+                              maxShowersPerBin = 100,
+                              OutputLevel = INFO)
+if endcap:
+    # front of the envelope of the EMEC, EMEC_z1 (Endcaps_coneCryo.xml)
+    library.entryZ = 5440
+    library.outputFile = "ECalEndcapShowerLibrary.bin"
+else:
+    # front of the envelope of the barrel, BarCryoECal_rmin
+    library.entryRadius = 1780
+    library.outputFile = "ECalBarrelShowerLibrary.bin"
+library.deposits = "ECalPositionedHits"
+library.particle = "GenParticles"
+
+# ApplicationMgr
+from Configurables import ApplicationMgr
+ApplicationMgr( TopAlg = [geantsim, library],
+                EvtSel = 'NONE',
+                EvtMax = 1000,
+                # order is important, as GeoSvc is needed by G4SimSvc
+                ExtSvc = [podioevent, geoservice, geantservice],
+                OutputLevel = INFO)
@@ -0,0 +1,57 @@
+from Gaudi.Configuration import *
+
+# Data service
+from Configurables import FCCDataSvc
+podioevent = FCCDataSvc("EventDataSvc")
+
+# DD4hep geometry service
+# the showers in the ECal barrel and in the ECal endcap are replayed from the libraries created by
+# createShowerLibrary.py (with endcap = False and endcap = True)
+from Configurables import GeoSvc
+geoservice = GeoSvc("GeoSvc", detectors=[ 'file:Detector/DetFCChhBaseline1/compact/FCChh_DectEmptyMaster.xml',
+                                          'file:Detector/DetFCChhECalInclined/compact/FCChh_ECalBarrel_withCryostat.xml',
+                                          'file:Detector/DetFCChhCalDiscs/compact/Endcaps_coneCryo.xml',
+                                          'file:Detector/DetFCChhBaseline1/compact/FCChh_ShowerLibraryRegions.xml'
+],
+                    OutputLevel = WARNING)
+
+# Geant4 service
+# the fast simulation process is added to the full physics list
+from Configurables import SimG4Svc, SimG4FastSimPhysicsList
+physicslist = SimG4FastSimPhysicsList("Physics", fullphysics="SimG4FtfpBert")
+geantservice = SimG4Svc("SimG4Svc", detector='SimG4DD4hepDetector', physicslist=physicslist, actions="SimG4FullSimActions")
+
+from Configurables import SimG4Alg, SimG4SaveCalHits, SimG4SingleParticleGeneratorTool
+saveecaltool = SimG4SaveCalHits("saveECalBarrelHits",readoutNames = ["ECalBarrelEta"])
+saveecaltool.positionedCaloHits.Path = "ECalBarrelPositionedHits"
+saveecaltool.caloHits.Path = "ECalBarrelHits"
+saveendcaptool = SimG4SaveCalHits("saveECalEndcapHits",readoutNames = ["EMECPhiEta"])
+saveendcaptool.positionedCaloHits.Path = "ECalEndcapPositionedHits"
+saveendcaptool.caloHits.Path = "ECalEndcapHits"
+pgun=SimG4SingleParticleGeneratorTool("SimG4SingleParticleGeneratorTool",saveEdm=True,
+                                      particleName = "e-", energyMin = 50000, energyMax = 50000, etaMin = -0.5, etaMax = 0.5,
+                                      OutputLevel = INFO)
+geantsim = SimG4Alg("SimG4Alg",
+                    outputs= ["SimG4SaveCalHits/saveECalBarrelHits", "SimG4SaveCalHits/saveECalEndcapHits"],
+                    eventProvider = pgun,
+                    OutputLevel = INFO)
+
+# CPU time of the fast simulation, to be compared with createShowerLibrary.py
+from Configurables import AuditorSvc, ChronoAuditor
+chra = ChronoAuditor()
+audsvc = AuditorSvc()
+audsvc.Auditors = [chra]
+geantsim.AuditExecute = True
+
+from Configurables import PodioOutput
+out = PodioOutput("out", filename="output_fastSim_showerLibrary.root")
+out.outputCommands = ["keep *"]
+
+# ApplicationMgr
+from Configurables import ApplicationMgr
+ApplicationMgr( TopAlg = [geantsim, out],
+                EvtSel = 'NONE',
+                EvtMax = 100,
+                # order is important, as GeoSvc is needed by G4SimSvc
+                ExtSvc = [podioevent, geoservice, geantservice, audsvc],
+                OutputLevel = INFO)
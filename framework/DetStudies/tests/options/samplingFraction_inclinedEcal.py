@@ -44,6 +44,17 @@ hist = SamplingFractionInLayers("hists",
                                  numLayers = 8,
                                  OutputLevel = INFO)
 hist.deposits.Path="ECalBarrelPositionedHits"
+# the same without histograms: mean, RMS and quantiles per layer in one summary tree
+stats = SamplingFractionInLayers("stats",
+                                 readoutName = "ECalBarrelEta",
+                                 layerFieldName = "layer",
+                                 activeFieldName = "type",
+                                 activeFieldValue = 0,
+                                 numLayers = 8,
+                                 streaming = True,
+                                 samplingFractionQuantiles = [0.16, 0.5, 0.84],
+                                 OutputLevel = INFO)
+stats.deposits.Path="ECalBarrelPositionedHits"
 
 THistSvc().Output = ["rec DATAFILE='histSF_inclined_e50GeV_eta0_1events.root' TYP='ROOT' OPT='RECREATE'"]
 THistSvc().PrintAll=True
@@ -58,10 +69,11 @@ audsvc = AuditorSvc()
 audsvc.Auditors = [chra]
 geantsim.AuditExecute = True
 hist.AuditExecute = True
+stats.AuditExecute = True
 
 # ApplicationMgr
 from Configurables import ApplicationMgr
-ApplicationMgr( TopAlg = [geantsim, hist],
+ApplicationMgr( TopAlg = [geantsim, hist, stats],
                 EvtSel = 'NONE',
                 EvtMax = 10,
                 # order is important, as GeoSvc is needed by G4SimSvc